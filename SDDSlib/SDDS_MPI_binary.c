@@ -24,6 +24,8 @@
 
 #include "mdb.h"
 #include "SDDS.h"
+#include "SDDS_internal.h"
+#include <lzma.h>
 
 static int32_t defaultStringLength = SDDS_MPI_STRING_COLUMN_LEN;
 static int32_t number_of_string_truncated = 0;
@@ -438,6 +440,24 @@ void SDDS_MPI_SetFileSync(short value) {
   SDDS_MPI_force_file_sync = value;
 }
 
+static int32_t SDDS_MPI_collective_cb_nodes = 0;
+static int32_t SDDS_MPI_collective_cb_buffer_size = 0;
+/**
+ * @brief Set the aggregator hints used by collective page writes.
+ *
+ * When collective I/O is enabled for a dataset, pages are written with
+ * MPI_File_write_all and these values are passed to the MPI-IO layer as the
+ * "cb_nodes" and "cb_buffer_size" hints.  Collective writes do not need the
+ * write kludge usleep or forced file sync.
+ *
+ * @param cb_nodes Number of aggregator processes; zero keeps the MPI-IO default.
+ * @param cb_buffer_size Size in bytes of each aggregator's buffer; zero keeps the MPI-IO default.
+ */
+void SDDS_MPI_SetCollectiveWriteHints(int32_t cb_nodes, int32_t cb_buffer_size) {
+  SDDS_MPI_collective_cb_nodes = cb_nodes;
+  SDDS_MPI_collective_cb_buffer_size = cb_buffer_size;
+}
+
 /**
  * @brief Write a binary row to an SDDS dataset using MPI.
  *
@@ -619,6 +639,8 @@ int32_t SDDS_MPI_BufferedWrite(void *target, int64_t targetSize, SDDS_DATASET *S
   MPI_dataset = SDDS_dataset->MPI_dataset;
   fBuffer = &(SDDS_dataset->fBuffer);
 
+  if (SDDS_dataset->layout.gzipFile || SDDS_dataset->layout.lzmaFile)
+    return SDDS_MPI_StageCompressedOutput(SDDS_dataset, target, targetSize);
   if (!fBuffer->bufferSize) {
     if ((mpi_code = MPI_File_write(MPI_dataset->MPI_file, target, targetSize, MPI_BYTE, MPI_STATUS_IGNORE)) != MPI_SUCCESS) {
       SDDS_MPI_GOTO_ERROR(stderr, "SDDS_MPI_WriteBufferedWrite(MPI_File_write_at failed)", mpi_code, 0);
@@ -765,7 +787,7 @@ int32_t SDDS_MPI_FlushBuffer(SDDS_DATASET *SDDS_dataset) {
   MPI_dataset = SDDS_dataset->MPI_dataset;
   fBuffer = &(SDDS_dataset->fBuffer);
 
-  if (!fBuffer->bufferSize)
+  if (!fBuffer->bufferSize || SDDS_dataset->layout.gzipFile || SDDS_dataset->layout.lzmaFile)
     return 1;
 
   if ((writeBytes = fBuffer->bufferSize - fBuffer->bytesLeft)) {
@@ -859,6 +881,9 @@ int32_t SDDS_MPI_WriteNonNativeBinaryPage(SDDS_DATASET *SDDS_dataset) {
 
   if (!SDDS_CheckDataset(SDDS_dataset, "SDDS_MPI_WriteNonNativeBinaryPage"))
     return (0);
+  /* the file view can't change while the previous page is still being written */
+  if (!SDDS_MPI_CompletePendingWrite(SDDS_dataset))
+    return (0);
 
   fBuffer = &SDDS_dataset->fBuffer;
   if (SDDS_dataset->layout.data_mode.column_major)
@@ -924,7 +949,16 @@ int32_t SDDS_MPI_WriteNonNativeBinaryPage(SDDS_DATASET *SDDS_dataset) {
       return 0;
   }
   SDDS_SwapEndsColumnData(SDDS_dataset);
-  if (SDDS_dataset->layout.data_mode.column_major) {
+  if (SDDS_dataset->layout.gzipFile || SDDS_dataset->layout.lzmaFile) {
+    /* each processor compresses its rows into independent members */
+    if (!SDDS_MPI_WriteCompressedPage(SDDS_dataset, rows, 1))
+      return 0;
+  } else if (MPI_dataset->collective_io) {
+    /* all processors write the page together through per-processor file views */
+    if (!SDDS_MPI_CollectiveWritePage(SDDS_dataset, rowcount_offset, prev_rows, total_rows, 1))
+      return 0;
+    MPI_dataset->file_offset = rowcount_offset + (MPI_Offset)total_rows * column_offset;
+  } else if (SDDS_dataset->layout.data_mode.column_major) {
     /*write data by column */
     offset = rowcount_offset;
     for (i = 0; i < SDDS_dataset->layout.n_columns; i++) {
@@ -952,22 +986,16 @@ int32_t SDDS_MPI_WriteNonNativeBinaryPage(SDDS_DATASET *SDDS_dataset) {
     MPI_dataset->file_offset = rowcount_offset + (MPI_Offset)prev_rows * column_offset;
     /* set view to the position where the processor starts writing data */
     MPI_File_set_view(MPI_dataset->MPI_file, MPI_dataset->file_offset, MPI_BYTE, MPI_BYTE, "native", MPI_INFO_NULL);
-    if (!MPI_dataset->collective_io) {
-      row = 0;
-      for (i = 0; i < SDDS_dataset->n_rows; i++) {
-        if (SDDS_dataset->row_flag[i] && !SDDS_MPI_WriteNonNativeBinaryRow(SDDS_dataset, i))
-          return 0;
-        row++;
-      }
-      /*get current file position until now */
-      SDDS_dataset->n_rows = row;
-      if (!SDDS_MPI_FlushBuffer(SDDS_dataset))
+    row = 0;
+    for (i = 0; i < SDDS_dataset->n_rows; i++) {
+      if (SDDS_dataset->row_flag[i] && !SDDS_MPI_WriteNonNativeBinaryRow(SDDS_dataset, i))
         return 0;
-    } else {
-      if (!SDDS_MPI_CollectiveWriteByRow(SDDS_dataset))
-        return 0;
-      row = SDDS_dataset->n_rows;
+      row++;
     }
+    /*get current file position until now */
+    SDDS_dataset->n_rows = row;
+    if (!SDDS_MPI_FlushBuffer(SDDS_dataset))
+      return 0;
     MPI_Allreduce(&row, &total_rows, 1, MPI_INT64_T, MPI_SUM, MPI_dataset->comm);
     MPI_dataset->file_offset = rowcount_offset + total_rows * column_offset;
     rows = row;
@@ -1021,6 +1049,9 @@ int32_t SDDS_MPI_WriteContinuousBinaryPage(SDDS_DATASET *SDDS_dataset) {
 
   if (!SDDS_CheckDataset(SDDS_dataset, "SDDS_MPI_WriteContinuousBinaryPage"))
     return (0);
+  /* the file view can't change while the previous page is still being written */
+  if (!SDDS_MPI_CompletePendingWrite(SDDS_dataset))
+    return (0);
 
   fBuffer = &SDDS_dataset->fBuffer;
   if (SDDS_dataset->layout.data_mode.column_major)
@@ -1083,7 +1114,16 @@ int32_t SDDS_MPI_WriteContinuousBinaryPage(SDDS_DATASET *SDDS_dataset) {
       return 0;
   }
 
-  if (SDDS_dataset->layout.data_mode.column_major) {
+  if (SDDS_dataset->layout.gzipFile || SDDS_dataset->layout.lzmaFile) {
+    /* each processor compresses its rows into independent members */
+    if (!SDDS_MPI_WriteCompressedPage(SDDS_dataset, rows, 0))
+      return 0;
+  } else if (MPI_dataset->collective_io) {
+    /* all processors write the page together through per-processor file views */
+    if (!SDDS_MPI_CollectiveWritePage(SDDS_dataset, rowcount_offset, prev_rows, total_rows, 0))
+      return 0;
+    MPI_dataset->file_offset = rowcount_offset + (MPI_Offset)total_rows * column_offset;
+  } else if (SDDS_dataset->layout.data_mode.column_major) {
     /*write data by column */
     offset = rowcount_offset;
     for (i = 0; i < SDDS_dataset->layout.n_columns; i++) {
@@ -1111,22 +1151,16 @@ int32_t SDDS_MPI_WriteContinuousBinaryPage(SDDS_DATASET *SDDS_dataset) {
     MPI_dataset->file_offset = rowcount_offset + (MPI_Offset)prev_rows * column_offset;
     /* set view to the position where the processor starts writing data */
     MPI_File_set_view(MPI_dataset->MPI_file, MPI_dataset->file_offset, MPI_BYTE, MPI_BYTE, "native", MPI_INFO_NULL);
-    if (!MPI_dataset->collective_io) {
-      row = 0;
-      for (i = 0; i < SDDS_dataset->n_rows; i++) {
-        if (SDDS_dataset->row_flag[i] && !SDDS_MPI_WriteBinaryRow(SDDS_dataset, i))
-          return 0;
-        row++;
-      }
-      /*get current file position until now */
-      SDDS_dataset->n_rows = row;
-      if (!SDDS_MPI_FlushBuffer(SDDS_dataset))
-        return 0;
-    } else {
-      if (!SDDS_MPI_CollectiveWriteByRow(SDDS_dataset))
+    row = 0;
+    for (i = 0; i < SDDS_dataset->n_rows; i++) {
+      if (SDDS_dataset->row_flag[i] && !SDDS_MPI_WriteBinaryRow(SDDS_dataset, i))
         return 0;
-      row = SDDS_dataset->n_rows;
+      row++;
     }
+    /*get current file position until now */
+    SDDS_dataset->n_rows = row;
+    if (!SDDS_MPI_FlushBuffer(SDDS_dataset))
+      return 0;
     MPI_Allreduce(&row, &total_rows, 1, MPI_INT64_T, MPI_SUM, MPI_dataset->comm);
     MPI_dataset->file_offset = rowcount_offset + total_rows * column_offset;
     rows = row;
@@ -1941,6 +1975,18 @@ int32_t SDDS_MPI_ReadBinaryPage(SDDS_DATASET *SDDS_dataset) {
     /* the number of rows is "unreasonably" large---treat like end-of-file */
     return (SDDS_dataset->page_number = -1);
   }
+  if (MPI_dataset->sparse_interval > 1 || MPI_dataset->sparse_offset > 0 || MPI_dataset->last_rows > 0) {
+    if (!SDDS_MPI_ReadSelectedRows(SDDS_dataset))
+      return 0;
+    MPI_dataset->n_page++;
+    return (SDDS_dataset->page_number = MPI_dataset->n_page);
+  }
+  if (MPI_dataset->read_decomposition != SDDS_MPI_READ_BY_ROWS && SDDS_dataset->layout.data_mode.column_major) {
+    if (!SDDS_MPI_ReadPageByColumns(SDDS_dataset))
+      return 0;
+    MPI_dataset->n_page++;
+    return (SDDS_dataset->page_number = MPI_dataset->n_page);
+  }
   prev_rows = 0;
   if (master_read) {
     n_rows = MPI_dataset->total_rows / MPI_dataset->n_processors;
@@ -2160,6 +2206,20 @@ int32_t SDDS_MPI_ReadNonNativeBinaryPage(SDDS_DATASET *SDDS_dataset) {
     /* the number of rows is "unreasonably" large---treat like end-of-file */
     return (SDDS_dataset->page_number = -1);
   }
+  if (MPI_dataset->sparse_interval > 1 || MPI_dataset->sparse_offset > 0 || MPI_dataset->last_rows > 0) {
+    if (!SDDS_MPI_ReadSelectedRows(SDDS_dataset))
+      return 0;
+    SDDS_SwapEndsColumnData(SDDS_dataset);
+    MPI_dataset->n_page++;
+    return (SDDS_dataset->page_number = MPI_dataset->n_page);
+  }
+  if (MPI_dataset->read_decomposition != SDDS_MPI_READ_BY_ROWS && SDDS_dataset->layout.data_mode.column_major) {
+    if (!SDDS_MPI_ReadPageByColumns(SDDS_dataset))
+      return 0;
+    SDDS_SwapEndsColumnData(SDDS_dataset);
+    MPI_dataset->n_page++;
+    return (SDDS_dataset->page_number = MPI_dataset->n_page);
+  }
   total_rows = MPI_dataset->total_rows;
   prev_rows = 0;
   if (master_read) {
@@ -2446,17 +2506,17 @@ int32_t SDDS_MPI_BufferedReadBinaryTitle(SDDS_DATASET *SDDS_dataset) {
 }
 
 /**
- * @brief Writes SDDS dataset rows collectively by row using MPI parallel I/O.
+ * @brief Writes non-native binary SDDS dataset rows collectively by row using MPI parallel I/O.
  *
- * This function performs a collective write operation where each MPI process writes its assigned rows of the SDDS dataset.
- * It handles buffering of row data, ensures synchronization among MPI processes, and manages error handling.
+ * This function performs a collective write operation for non-native binary SDDS datasets, where each MPI process writes
+ * its assigned rows. It handles buffering of row data, ensures synchronization among MPI processes, and manages error handling.
  * The function supports only binary string types for non-string data and flushes the buffer upon completion.
  *
  * @param[in,out] SDDS_dataset Pointer to the `SDDS_DATASET` structure containing the data to be written.
  *
  * @return int32_t Returns `1` on successful write, `0` on failure.
  */
-int32_t SDDS_MPI_CollectiveWriteByRow(SDDS_DATASET *SDDS_dataset) {
+int32_t SDDS_MPI_CollectiveWriteNonNativeByRow(SDDS_DATASET *SDDS_dataset) {
   MPI_DATASET *MPI_dataset;
   SDDS_LAYOUT *layout;
   int32_t mpi_code, type, size;
@@ -2464,7 +2524,7 @@ int32_t SDDS_MPI_CollectiveWriteByRow(SDDS_DATASET *SDDS_dataset) {
   SDDS_FILEBUFFER *fBuffer;
 
 #if MPI_DEBUG
-  logDebug("SDDS_MPI_CollectiveWriteByRow", SDDS_dataset);
+  logDebug("SDDS_MPI_CollectiveWriteNonNativeByRow", SDDS_dataset);
 #endif
 
   MPI_dataset = SDDS_dataset->MPI_dataset;
@@ -2499,71 +2559,950 @@ int32_t SDDS_MPI_CollectiveWriteByRow(SDDS_DATASET *SDDS_dataset) {
   }
 
   for (i = min_rows; i < n_rows; i++)
-    if (!SDDS_MPI_WriteBinaryRow(SDDS_dataset, i))
+    if (!SDDS_MPI_WriteNonNativeBinaryRow(SDDS_dataset, i))
       return 0;
   if (!SDDS_MPI_FlushBuffer(SDDS_dataset))
     return 0;
   return 1;
 }
 
+#define SDDS_MPI_COLLECTIVE_CHUNK 1073741824
+
 /**
- * @brief Writes non-native binary SDDS dataset rows collectively by row using MPI parallel I/O.
+ * @brief Packs the page data of the current processor into a contiguous buffer.
  *
- * This function performs a collective write operation for non-native binary SDDS datasets, where each MPI process writes
- * its assigned rows. It handles buffering of row data, ensures synchronization among MPI processes, and manages error handling.
- * The function supports only binary string types for non-string data and flushes the buffer upon completion.
+ * Row-major pages are packed row by row (rows of interest only) in exactly the layout
+ * written by SDDS_MPI_WriteBinaryRow, including the fixed-length string fields.
+ * Column-major pages are packed column by column, all rows included.
  *
- * @param[in,out] SDDS_dataset Pointer to the `SDDS_DATASET` structure containing the data to be written.
+ * @param SDDS_dataset Pointer to the SDDS_DATASET structure.
+ * @param buffer Destination buffer, large enough for the packed page.
+ * @param swap_lengths If non-zero, string lengths are byte-swapped for non-native output.
+ * @return The number of bytes packed.
+ */
+static int64_t SDDS_MPI_PackPageData(SDDS_DATASET *SDDS_dataset, char *buffer, int32_t swap_lengths) {
+  SDDS_LAYOUT *layout;
+  int64_t i, row, size, length;
+  int32_t type, length32;
+  char *string, *data;
+
+  layout = &SDDS_dataset->layout;
+  data = buffer;
+  if (layout->data_mode.column_major) {
+    for (i = 0; i < layout->n_columns; i++) {
+      size = SDDS_type_size[layout->column_definition[i].type - 1] * SDDS_dataset->n_rows;
+      memcpy(data, SDDS_dataset->data[i], size);
+      data += size;
+    }
+    return (data - buffer);
+  }
+  length32 = defaultStringLength;
+  if (swap_lengths)
+    SDDS_SwapLong(&length32);
+  for (row = 0; row < SDDS_dataset->n_rows; row++) {
+    if (!SDDS_dataset->row_flag[row])
+      continue;
+    for (i = 0; i < layout->n_columns; i++) {
+      type = layout->column_definition[i].type;
+      if (type == SDDS_STRING) {
+        if (!(string = *((char **)SDDS_dataset->data[i] + row)))
+          string = "";
+        if ((length = strlen(string)) > defaultStringLength) {
+          length = defaultStringLength;
+          number_of_string_truncated++;
+        }
+        memcpy(data, &length32, sizeof(length32));
+        data += sizeof(length32);
+        memcpy(data, string, length);
+        memset(data + length, ' ', defaultStringLength - length);
+        data += defaultStringLength;
+      } else {
+        size = SDDS_type_size[type - 1];
+        memcpy(data, (char *)SDDS_dataset->data[i] + row * size, size);
+        data += size;
+      }
+    }
+  }
+  return (data - buffer);
+}
+
+/**
+ * @brief Writes the column data of a page with a single two-phase collective write.
  *
- * @return int32_t Returns `1` on successful write, `0` on failure.
+ * Every processor describes where its part of the page lives in the file with an
+ * MPI_Type_create_hindexed file view built from the gathered row counts: one block for
+ * row-major pages, one block per column for column-major pages.  The packed data is then
+ * written with MPI_File_write_all, letting the MPI-IO layer aggregate the requests
+ * (see SDDS_MPI_SetCollectiveWriteHints).  All processors must call this function.
+ *
+ * @param SDDS_dataset Pointer to the SDDS_DATASET structure.
+ * @param data_offset File offset at which the page's column data begins.
+ * @param prev_rows Number of rows written by lower-ranked processors.
+ * @param total_rows Total number of rows written by all processors.
+ * @param swap_lengths If non-zero, string lengths are byte-swapped for non-native output.
+ * @return 1 on success, 0 on failure.  A failure on any processor fails the page on all of them;
+ *         failures before the writes start leave the file untouched.
  */
-int32_t SDDS_MPI_CollectiveWriteNonNativeByRow(SDDS_DATASET *SDDS_dataset) {
+int32_t SDDS_MPI_CollectiveWritePage(SDDS_DATASET *SDDS_dataset, MPI_Offset data_offset, int64_t prev_rows, int64_t total_rows, int32_t swap_lengths) {
   MPI_DATASET *MPI_dataset;
   SDDS_LAYOUT *layout;
-  int32_t mpi_code, type, size;
-  int64_t i, j, n_rows, min_rows, writeBytes;
-  SDDS_FILEBUFFER *fBuffer;
+  MPI_Datatype filetype;
+  MPI_Info info;
+  MPI_Aint *displacement;
+  int *block_length;
+  MPI_Request *request = NULL;
+  char *buffer = NULL, value[32];
+  int64_t i, rows, bytes, written, count, writes, max_writes, n_blocks, size;
+  MPI_Offset offset, start, length;
+  int32_t status;
+  int mpi_code;
 
 #if MPI_DEBUG
-  logDebug("SDDS_MPI_CollectiveWriteNonNativeByRow", SDDS_dataset);
+  logDebug("SDDS_MPI_CollectiveWritePage", SDDS_dataset);
 #endif
 
   MPI_dataset = SDDS_dataset->MPI_dataset;
-  layout = &(SDDS_dataset->layout);
-  fBuffer = &(SDDS_dataset->fBuffer);
-  n_rows = SDDS_dataset->n_rows;
-  MPI_Allreduce(&n_rows, &min_rows, 1, MPI_INT64_T, MPI_MIN, MPI_dataset->comm);
-  for (i = 0; i < min_rows; i++) {
-    for (j = 0; j < layout->n_columns; j++) {
-      type = layout->column_definition[j].type;
-      size = SDDS_type_size[type - 1];
-      if (type == SDDS_STRING) {
-        SDDS_SetError("Can not write binary string in collective io.");
-        return 0;
+  layout = &SDDS_dataset->layout;
+  /* a processor that fails still takes part in every collective call, writing nothing */
+  status = 1;
+  if (layout->data_mode.column_major) {
+    rows = SDDS_dataset->n_rows;
+    for (i = 0; i < layout->n_columns; i++)
+      if (layout->column_definition[i].type == SDDS_STRING) {
+        SDDS_SetError("Can not write string column to SDDS3 (SDDS_MPI_CollectiveWritePage)");
+        status = 0;
+        break;
       }
-      if (!SDDS_MPI_BufferedWriteAll((char *)SDDS_dataset->data[j] + i * size, size, SDDS_dataset))
-        return 0;
+  } else
+    rows = SDDS_CountRowsOfInterest(SDDS_dataset);
+  bytes = rows * MPI_dataset->column_offset;
+  if (status && !(buffer = malloc(sizeof(*buffer) * (bytes + 1)))) {
+    SDDS_SetError("Memory allocation failed (SDDS_MPI_CollectiveWritePage)");
+    status = 0;
+  } else if (status && SDDS_MPI_PackPageData(SDDS_dataset, buffer, swap_lengths) != bytes) {
+    SDDS_SetError("Packed page size mismatch (SDDS_MPI_CollectiveWritePage)");
+    status = 0;
+  }
+
+  /* describe this processor's part of the page; blocks are split so that lengths fit in an int */
+  filetype = MPI_BYTE;
+  if (status && bytes) {
+    n_blocks = layout->data_mode.column_major ? layout->n_columns : 1;
+    n_blocks += bytes / SDDS_MPI_COLLECTIVE_CHUNK;
+    displacement = malloc(sizeof(*displacement) * n_blocks);
+    block_length = malloc(sizeof(*block_length) * n_blocks);
+    if (!displacement || !block_length) {
+      SDDS_SetError("Memory allocation failed (SDDS_MPI_CollectiveWritePage)");
+      status = 0;
+    } else {
+      n_blocks = 0;
+      offset = 0;
+      for (i = 0; i < (layout->data_mode.column_major ? layout->n_columns : 1); i++) {
+        if (layout->data_mode.column_major) {
+          size = SDDS_type_size[layout->column_definition[i].type - 1];
+          start = offset + (MPI_Offset)prev_rows * size;
+          length = (MPI_Offset)rows * size;
+          offset += (MPI_Offset)total_rows * size;
+        } else {
+          start = (MPI_Offset)prev_rows * MPI_dataset->column_offset;
+          length = bytes;
+        }
+        while (length > 0) {
+          displacement[n_blocks] = (MPI_Aint)start;
+          block_length[n_blocks] = length > SDDS_MPI_COLLECTIVE_CHUNK ? SDDS_MPI_COLLECTIVE_CHUNK : (int)length;
+          start += block_length[n_blocks];
+          length -= block_length[n_blocks];
+          n_blocks++;
+        }
+      }
+      if ((mpi_code = MPI_Type_create_hindexed((int)n_blocks, block_length, displacement, MPI_BYTE, &filetype)) != MPI_SUCCESS) {
+        filetype = MPI_BYTE;
+        SDDS_MPI_GOTO_ERROR(stderr, "SDDS_MPI_CollectiveWritePage(MPI_Type_create_hindexed failed)", mpi_code, 0);
+        status = 0;
+      } else if ((mpi_code = MPI_Type_commit(&filetype)) != MPI_SUCCESS) {
+        MPI_Type_free(&filetype);
+        filetype = MPI_BYTE;
+        SDDS_MPI_GOTO_ERROR(stderr, "SDDS_MPI_CollectiveWritePage(MPI_Type_commit failed)", mpi_code, 0);
+        status = 0;
+      }
+    }
+    if (displacement)
+      free(displacement);
+    if (block_length)
+      free(block_length);
+  }
+  if (!status)
+    bytes = 0;
+
+  MPI_Info_create(&info);
+  MPI_Info_set(info, "romio_cb_write", "enable");
+  if (SDDS_MPI_collective_cb_nodes > 0) {
+    sprintf(value, "%" PRId32, SDDS_MPI_collective_cb_nodes);
+    MPI_Info_set(info, "cb_nodes", value);
+  }
+  if (SDDS_MPI_collective_cb_buffer_size > 0) {
+    sprintf(value, "%" PRId32, SDDS_MPI_collective_cb_buffer_size);
+    MPI_Info_set(info, "cb_buffer_size", value);
+  }
+  mpi_code = MPI_File_set_view(MPI_dataset->MPI_file, data_offset, MPI_BYTE, filetype, "native", info);
+  MPI_Info_free(&info);
+  if (filetype != MPI_BYTE)
+    MPI_Type_free(&filetype);
+  if (mpi_code != MPI_SUCCESS) {
+    SDDS_MPI_GOTO_ERROR(stderr, "SDDS_MPI_CollectiveWritePage(MPI_File_set_view failed)", mpi_code, 0);
+    status = 0;
+  }
+
+  /* every processor must take part in the same number of collective calls */
+  writes = (bytes + SDDS_MPI_COLLECTIVE_CHUNK - 1) / SDDS_MPI_COLLECTIVE_CHUNK;
+  MPI_Allreduce(&writes, &max_writes, 1, MPI_INT64_T, MPI_MAX, MPI_dataset->comm);
+  if (status && MPI_dataset->async_io && !(request = malloc(sizeof(*request) * (max_writes + 1)))) {
+    SDDS_SetError("Memory allocation failed (SDDS_MPI_CollectiveWritePage)");
+    status = 0;
+  }
+  /* a failure on one processor fails the page everywhere, before any data are written */
+  MPI_Allreduce(MPI_IN_PLACE, &status, 1, MPI_INT32_T, MPI_MIN, MPI_dataset->comm);
+  if (!status) {
+    if (buffer)
+      free(buffer);
+    if (request)
+      free(request);
+    return 0;
+  }
+
+  if (MPI_dataset->async_io) {
+    /* start the writes and return; the packed buffer is released by SDDS_MPI_CompletePendingWrite.
+       A processor whose write fails to start keeps posting empty writes so that all stay in step. */
+    MPI_dataset->pending_write = request;
+    MPI_dataset->pending_buffer = buffer;
+    written = 0;
+    for (i = 0; i < max_writes; i++) {
+      count = bytes - written > SDDS_MPI_COLLECTIVE_CHUNK ? SDDS_MPI_COLLECTIVE_CHUNK : bytes - written;
+      if (!status)
+        count = 0;
+      if ((mpi_code = MPI_File_iwrite_all(MPI_dataset->MPI_file, buffer + written, (int)count, MPI_BYTE, request + i)) != MPI_SUCCESS) {
+        request[i] = MPI_REQUEST_NULL;
+        SDDS_MPI_GOTO_ERROR(stderr, "SDDS_MPI_CollectiveWritePage(MPI_File_iwrite_all failed)", mpi_code, 0);
+        status = 0;
+      }
+      written += count;
+    }
+    MPI_dataset->n_pending_writes = max_writes;
+    /* all processors agree on whether the writes started; if not, those that did are completed */
+    MPI_Allreduce(MPI_IN_PLACE, &status, 1, MPI_INT32_T, MPI_MIN, MPI_dataset->comm);
+    if (!status) {
+      SDDS_MPI_CompletePendingWrite(SDDS_dataset);
+      return 0;
     }
+    return 1;
   }
+  written = 0;
+  for (i = 0; i < max_writes; i++) {
+    count = bytes - written > SDDS_MPI_COLLECTIVE_CHUNK ? SDDS_MPI_COLLECTIVE_CHUNK : bytes - written;
+    if (!status)
+      count = 0;
+    if ((mpi_code = MPI_File_write_all(MPI_dataset->MPI_file, buffer + written, (int)count, MPI_BYTE, MPI_STATUS_IGNORE)) != MPI_SUCCESS) {
+      SDDS_MPI_GOTO_ERROR(stderr, "SDDS_MPI_CollectiveWritePage(MPI_File_write_all failed)", mpi_code, 0);
+      status = 0;
+    }
+    written += count;
+  }
+  free(buffer);
 
-  if ((writeBytes = fBuffer->bufferSize - fBuffer->bytesLeft)) {
-    if (writeBytes < 0) {
-      SDDS_SetError("Unable to flush buffer: negative byte count (SDDS_FlushBuffer).");
+  /* leave a plain byte view positioned after the page */
+  if ((mpi_code = MPI_File_set_view(MPI_dataset->MPI_file, data_offset + (MPI_Offset)total_rows * MPI_dataset->column_offset, MPI_BYTE, MPI_BYTE, "native", MPI_INFO_NULL)) != MPI_SUCCESS) {
+    SDDS_MPI_GOTO_ERROR(stderr, "SDDS_MPI_CollectiveWritePage(MPI_File_set_view failed)", mpi_code, 0);
+    status = 0;
+  }
+  MPI_Allreduce(MPI_IN_PLACE, &status, 1, MPI_INT32_T, MPI_MIN, MPI_dataset->comm);
+  return status;
+}
+
+/**
+ * @brief Enable or disable non-blocking page writes.
+ *
+ * In asynchronous mode SDDS_MPI_WritePage packs the page, starts non-blocking collective
+ * writes (MPI_File_iwrite_all) and returns, so the caller may immediately modify or refill
+ * the page while the data goes to the file.  The writes are completed at the start of the
+ * next page write, by SDDS_MPI_CompletePendingWrite, or by SDDS_MPI_Terminate.  Enabling
+ * asynchronous mode also enables collective I/O.  All processors must use the same setting.
+ *
+ * @param SDDS_dataset Pointer to the SDDS_DATASET structure.
+ * @param async_io Non-zero to enable non-blocking page writes.
+ * @return 1 on success, 0 on failure.
+ */
+int32_t SDDS_MPI_SetAsynchronousWrite(SDDS_DATASET *SDDS_dataset, short async_io) {
+  if (!SDDS_CheckDataset(SDDS_dataset, "SDDS_MPI_SetAsynchronousWrite"))
+    return 0;
+  if (!SDDS_dataset->MPI_dataset) {
+    SDDS_SetError("Dataset is not set up for parallel I/O (SDDS_MPI_SetAsynchronousWrite)");
+    return 0;
+  }
+  if (!async_io && !SDDS_MPI_CompletePendingWrite(SDDS_dataset))
+    return 0;
+  SDDS_dataset->MPI_dataset->async_io = async_io;
+  if (async_io)
+    SDDS_dataset->MPI_dataset->collective_io = 1;
+  return 1;
+}
+
+/**
+ * @brief Wait for the non-blocking page writes started by the last page write.
+ *
+ * This is a collective call; it does nothing if no writes are outstanding.
+ *
+ * @param SDDS_dataset Pointer to the SDDS_DATASET structure.
+ * @return 1 on success, 0 if a write failed on any processor.
+ */
+int32_t SDDS_MPI_CompletePendingWrite(SDDS_DATASET *SDDS_dataset) {
+  MPI_DATASET *MPI_dataset;
+  int32_t status;
+  int mpi_code;
+
+  if (!(MPI_dataset = SDDS_dataset->MPI_dataset) || !MPI_dataset->pending_write)
+    return 1;
+  mpi_code = MPI_Waitall(MPI_dataset->n_pending_writes, MPI_dataset->pending_write, MPI_STATUSES_IGNORE);
+  free(MPI_dataset->pending_write);
+  free(MPI_dataset->pending_buffer);
+  MPI_dataset->pending_write = NULL;
+  MPI_dataset->pending_buffer = NULL;
+  MPI_dataset->n_pending_writes = 0;
+  status = 1;
+  if (mpi_code != MPI_SUCCESS) {
+    SDDS_MPI_GOTO_ERROR(stderr, "SDDS_MPI_CompletePendingWrite(MPI_Waitall failed)", mpi_code, 0);
+    status = 0;
+  }
+  MPI_Allreduce(MPI_IN_PLACE, &status, 1, MPI_INT32_T, MPI_MIN, MPI_dataset->comm);
+  return status;
+}
+
+/**
+ * @brief Appends bytes to the staging area used for compressed parallel output.
+ *
+ * With gzip or xz output the header and page titles written by the master processor are not
+ * written to the file directly; they are collected here and compressed together with the
+ * processor's first piece of page data by SDDS_MPI_WriteCompressedData.
+ *
+ * @param SDDS_dataset Pointer to the SDDS_DATASET structure.
+ * @param data Bytes to stage.
+ * @param size Number of bytes to stage.
+ * @return 1 on success, 0 on failure.
+ */
+int32_t SDDS_MPI_StageCompressedOutput(SDDS_DATASET *SDDS_dataset, void *data, int64_t size) {
+  MPI_DATASET *MPI_dataset;
+
+  MPI_dataset = SDDS_dataset->MPI_dataset;
+  if (MPI_dataset->compress_size + size > MPI_dataset->compress_allocated) {
+    MPI_dataset->compress_allocated = 2 * (MPI_dataset->compress_size + size) + 1024;
+    if (!(MPI_dataset->compress_buffer = SDDS_Realloc(MPI_dataset->compress_buffer, sizeof(char) * MPI_dataset->compress_allocated))) {
+      SDDS_SetError("Memory allocation failed (SDDS_MPI_StageCompressedOutput)");
       return 0;
     }
-    if ((mpi_code = MPI_File_write_all(MPI_dataset->MPI_file, fBuffer->buffer, writeBytes, MPI_BYTE, MPI_STATUS_IGNORE)) != MPI_SUCCESS) {
-      SDDS_MPI_GOTO_ERROR(stderr, "SDDS_MPI_FlushBuffer(MPI_File_write_at failed)", mpi_code, 0);
+  }
+  memcpy(MPI_dataset->compress_buffer + MPI_dataset->compress_size, data, size);
+  MPI_dataset->compress_size += size;
+  return 1;
+}
+
+/**
+ * @brief Compresses a block of output into one independently decodable gzip member or xz stream.
+ *
+ * @param SDDS_dataset Pointer to the SDDS_DATASET structure; layout.gzipFile or layout.lzmaFile selects the format.
+ * @param data Bytes to compress.
+ * @param size Number of bytes to compress.
+ * @param member Returns the allocated compressed block.
+ * @param member_size Returns the size of the compressed block.
+ * @return 1 on success, 0 on failure.
+ */
+static int32_t SDDS_MPI_CompressMember(SDDS_DATASET *SDDS_dataset, char *data, int64_t size, char **member, int64_t *member_size) {
+  size_t bound, position;
+
+  if (SDDS_dataset->layout.lzmaFile) {
+    /* level 2 and the .xz container match what lzma_open() writes for both .xz and .lzma names;
+       .lzma (lzma_alone) streams cannot be decoded when concatenated, so they could not be used for
+       one member per processor */
+    bound = lzma_stream_buffer_bound(size);
+    position = 0;
+    if (!(*member = malloc(bound)) ||
+        lzma_easy_buffer_encode(2, LZMA_CHECK_CRC32, NULL, (uint8_t *)data, size, (uint8_t *)*member, &position, bound) != LZMA_OK) {
+      SDDS_SetError("Unable to compress page data (SDDS_MPI_CompressMember)");
       return 0;
     }
-    fBuffer->bytesLeft = fBuffer->bufferSize;
-    fBuffer->data = fBuffer->buffer;
+    *member_size = position;
+    return 1;
   }
+#if defined(zLib)
+  {
+    z_stream stream;
+    int64_t left;
+    int ret;
 
-  for (i = min_rows; i < n_rows; i++)
-    if (!SDDS_MPI_WriteNonNativeBinaryRow(SDDS_dataset, i))
+    memset(&stream, 0, sizeof(stream));
+    /* window bits 15 + 16 selects a gzip wrapper */
+    if (deflateInit2(&stream, Z_DEFAULT_COMPRESSION, Z_DEFLATED, 15 + 16, 8, Z_DEFAULT_STRATEGY) != Z_OK) {
+      SDDS_SetError("Unable to initialize gzip compression (SDDS_MPI_CompressMember)");
       return 0;
-  if (!SDDS_MPI_FlushBuffer(SDDS_dataset))
+    }
+    bound = deflateBound(&stream, size);
+    if (!(*member = malloc(bound))) {
+      deflateEnd(&stream);
+      SDDS_SetError("Memory allocation failed (SDDS_MPI_CompressMember)");
+      return 0;
+    }
+    /* zlib counts are 32 bits, so large blocks are fed in pieces */
+    stream.next_in = (Bytef *)data;
+    stream.next_out = (Bytef *)*member;
+    left = size;
+    do {
+      if (!stream.avail_in && left) {
+        stream.avail_in = left > SDDS_MPI_COLLECTIVE_CHUNK ? SDDS_MPI_COLLECTIVE_CHUNK : left;
+        left -= stream.avail_in;
+      }
+      if (!stream.avail_out)
+        stream.avail_out = bound - stream.total_out > SDDS_MPI_COLLECTIVE_CHUNK ? SDDS_MPI_COLLECTIVE_CHUNK : bound - stream.total_out;
+      ret = deflate(&stream, left ? Z_NO_FLUSH : Z_FINISH);
+    } while (ret == Z_OK);
+    *member_size = stream.total_out;
+    deflateEnd(&stream);
+    if (ret != Z_STREAM_END) {
+      SDDS_SetError("Unable to compress page data (SDDS_MPI_CompressMember)");
+      return 0;
+    }
+    return 1;
+  }
+#else
+  SDDS_SetError("gzip output requires zlib support (SDDS_MPI_CompressMember)");
+  return 0;
+#endif
+}
+
+/**
+ * @brief Compresses and writes pieces of output from every processor.
+ *
+ * Each processor compresses each of its pieces into an independent gzip member or xz stream;
+ * the staged header and title bytes (see SDDS_MPI_StageCompressedOutput) are prepended to the
+ * first piece.  Piece i of every processor is placed after piece i of the lower-ranked processors
+ * and after all earlier pieces, with offsets from MPI_Exscan, so the file decompresses to exactly
+ * the uncompressed SDDS file.  Concatenated members are read by SDDS_GZipBufferedRead and
+ * SDDS_LZMABufferedRead.  All processors must call this function with the same number of pieces.
+ *
+ * @param SDDS_dataset Pointer to the SDDS_DATASET structure.
+ * @param data The pieces, stored contiguously.
+ * @param piece_size Size of each piece in bytes, or NULL if this processor has already failed; it then
+ *                   only takes part in the check for failures, so that the others do not wait for it.
+ * @param n_pieces Number of pieces.
+ * @return 1 on success, 0 on failure.
+ */
+int32_t SDDS_MPI_WriteCompressedData(SDDS_DATASET *SDDS_dataset, char *data, int64_t *piece_size, int32_t n_pieces) {
+  MPI_DATASET *MPI_dataset;
+  char **member;
+  int64_t *member_size, *prefix, *total, start, chunk;
+  MPI_Offset offset;
+  int32_t i, mpi_code, status;
+
+  MPI_dataset = SDDS_dataset->MPI_dataset;
+  status = piece_size != NULL;
+  member = calloc(n_pieces, sizeof(*member));
+  member_size = calloc(n_pieces, sizeof(*member_size));
+  prefix = calloc(n_pieces, sizeof(*prefix));
+  total = calloc(n_pieces, sizeof(*total));
+  if (status && (!member || !member_size || !prefix || !total)) {
+    SDDS_SetError("Memory allocation failed (SDDS_MPI_WriteCompressedData)");
+    status = 0;
+  }
+  for (i = 0; i < n_pieces && status; i++) {
+    if (i == 0 && MPI_dataset->compress_size) {
+      if (!SDDS_MPI_StageCompressedOutput(SDDS_dataset, data, piece_size[0]) ||
+          !SDDS_MPI_CompressMember(SDDS_dataset, MPI_dataset->compress_buffer, MPI_dataset->compress_size, &member[0], &member_size[0]))
+        status = 0;
+      MPI_dataset->compress_size = 0;
+    } else if (piece_size[i] && !SDDS_MPI_CompressMember(SDDS_dataset, data, piece_size[i], &member[i], &member_size[i]))
+      status = 0;
+    if (!status)
+      break;
+    data += piece_size[i];
+  }
+  /* a failure on one processor must not leave the others waiting */
+  MPI_Allreduce(MPI_IN_PLACE, &status, 1, MPI_INT32_T, MPI_MIN, MPI_dataset->comm);
+  if (status) {
+    MPI_Exscan(member_size, prefix, n_pieces, MPI_INT64_T, MPI_SUM, MPI_dataset->comm);
+    if (MPI_dataset->myid == 0)
+      memset(prefix, 0, sizeof(*prefix) * n_pieces);
+    MPI_Allreduce(member_size, total, n_pieces, MPI_INT64_T, MPI_SUM, MPI_dataset->comm);
+    MPI_File_set_view(MPI_dataset->MPI_file, 0, MPI_BYTE, MPI_BYTE, "native", MPI_INFO_NULL);
+    offset = MPI_dataset->compressed_offset;
+    for (i = 0; i < n_pieces && status; i++) {
+      for (start = 0; start < member_size[i]; start += chunk) {
+        chunk = member_size[i] - start > SDDS_MPI_COLLECTIVE_CHUNK ? SDDS_MPI_COLLECTIVE_CHUNK : member_size[i] - start;
+        if ((mpi_code = MPI_File_write_at(MPI_dataset->MPI_file, offset + prefix[i] + start, member[i] + start, (int)chunk, MPI_BYTE, MPI_STATUS_IGNORE)) != MPI_SUCCESS) {
+          SDDS_MPI_GOTO_ERROR(stderr, "SDDS_MPI_WriteCompressedData(MPI_File_write_at failed)", mpi_code, 0);
+          SDDS_SetError("Unable to write compressed data (SDDS_MPI_WriteCompressedData)");
+          status = 0;
+          break;
+        }
+      }
+      offset += total[i];
+    }
+    MPI_dataset->compressed_offset = offset;
+    /* the writes are independent, so a failure on one processor is known only to it */
+    MPI_Allreduce(MPI_IN_PLACE, &status, 1, MPI_INT32_T, MPI_MIN, MPI_dataset->comm);
+  }
+  if (member) {
+    for (i = 0; i < n_pieces; i++)
+      if (member[i])
+        free(member[i]);
+    free(member);
+  }
+  if (member_size)
+    free(member_size);
+  if (prefix)
+    free(prefix);
+  if (total)
+    free(total);
+  return status;
+}
+
+/**
+ * @brief Writes the column data of a page as compressed members, one per processor.
+ *
+ * Row-major pages give one piece per processor; column-major pages give one piece per column,
+ * since each processor's rows of a column are contiguous in the uncompressed file.
+ *
+ * @param SDDS_dataset Pointer to the SDDS_DATASET structure.
+ * @param rows Number of rows written by this processor.
+ * @param swap_lengths If non-zero, string lengths are byte-swapped for non-native output.
+ * @return 1 on success, 0 on failure.
+ */
+int32_t SDDS_MPI_WriteCompressedPage(SDDS_DATASET *SDDS_dataset, int64_t rows, int32_t swap_lengths) {
+  SDDS_LAYOUT *layout;
+  char *buffer;
+  int64_t *piece_size;
+  int32_t i, n_pieces, status;
+
+  layout = &SDDS_dataset->layout;
+  n_pieces = layout->data_mode.column_major && layout->n_columns ? layout->n_columns : 1;
+  if (layout->data_mode.column_major)
+    for (i = 0; i < layout->n_columns; i++)
+      if (layout->column_definition[i].type == SDDS_STRING) {
+        SDDS_SetError("Can not write string column to SDDS3 (SDDS_MPI_WriteCompressedPage)");
+        return 0;
+      }
+  if (!(piece_size = calloc(n_pieces, sizeof(*piece_size))) ||
+      !(buffer = malloc(sizeof(*buffer) * (rows * SDDS_dataset->MPI_dataset->column_offset + 1)))) {
+    SDDS_SetError("Memory allocation failed (SDDS_MPI_WriteCompressedPage)");
+    if (piece_size)
+      free(piece_size);
+    /* the other processors are waiting for this one */
+    SDDS_MPI_WriteCompressedData(SDDS_dataset, NULL, NULL, n_pieces);
     return 0;
+  }
+  piece_size[0] = SDDS_MPI_PackPageData(SDDS_dataset, buffer, swap_lengths);
+  if (layout->data_mode.column_major)
+    for (i = 0; i < layout->n_columns; i++)
+      piece_size[i] = SDDS_type_size[layout->column_definition[i].type - 1] * rows;
+  status = SDDS_MPI_WriteCompressedData(SDDS_dataset, buffer, piece_size, n_pieces);
+  free(buffer);
+  free(piece_size);
+  return status;
+}
+
+/**
+ * @brief Writes any staged header or title bytes of a compressed parallel output file.
+ *
+ * Called before the file is closed so that a layout written without pages still reaches the file.
+ * All processors must call this function.
+ *
+ * @param SDDS_dataset Pointer to the SDDS_DATASET structure.
+ * @return 1 on success, 0 on failure.
+ */
+int32_t SDDS_MPI_FlushCompressedOutput(SDDS_DATASET *SDDS_dataset) {
+  int64_t size = 0;
+
+  if (!SDDS_dataset->layout.gzipFile && !SDDS_dataset->layout.lzmaFile)
+    return 1;
+  return SDDS_MPI_WriteCompressedData(SDDS_dataset, NULL, &size, 1);
+}
+
+/**
+ * @brief Select how SDDS_MPI_ReadPage divides a page among the processors.
+ *
+ * With SDDS_MPI_READ_BY_ROWS (the default) each processor reads a contiguous share of the rows
+ * for every column.  With SDDS_MPI_READ_BY_COLUMNS each processor reads every row of the
+ * columns assigned to it round-robin, and SDDS_MPI_READ_BY_COLUMN_BYTES assigns the columns
+ * so that each processor reads about the same number of bytes when column types have different
+ * widths.  Column decompositions use all processors, apply only to column-major files (row-major
+ * files are still read by rows), and mark the assigned columns as the columns of interest.
+ *
+ * @param SDDS_dataset Pointer to the SDDS_DATASET structure.
+ * @param mode One of SDDS_MPI_READ_BY_ROWS, SDDS_MPI_READ_BY_COLUMNS or SDDS_MPI_READ_BY_COLUMN_BYTES.
+ * @return 1 on success, 0 on failure.
+ */
+int32_t SDDS_MPI_SetReadDecomposition(SDDS_DATASET *SDDS_dataset, short mode) {
+  if (!SDDS_CheckDataset(SDDS_dataset, "SDDS_MPI_SetReadDecomposition"))
+    return 0;
+  if (!SDDS_dataset->MPI_dataset) {
+    SDDS_SetError("Dataset is not set up for parallel I/O (SDDS_MPI_SetReadDecomposition)");
+    return 0;
+  }
+  if (mode != SDDS_MPI_READ_BY_ROWS && mode != SDDS_MPI_READ_BY_COLUMNS && mode != SDDS_MPI_READ_BY_COLUMN_BYTES) {
+    SDDS_SetError("Invalid read decomposition (SDDS_MPI_SetReadDecomposition)");
+    return 0;
+  }
+  SDDS_dataset->MPI_dataset->read_decomposition = mode;
+  return 1;
+}
+
+/**
+ * @brief Assign each column to a processor for a column-decomposed read.
+ *
+ * Every processor computes the same assignment.  In byte-balanced mode the columns are taken
+ * from widest to narrowest and each goes to the processor with the fewest bytes so far.
+ *
+ * @param SDDS_dataset Pointer to the SDDS_DATASET structure.
+ * @param owner Array of n_columns entries that receives the rank reading each column.
+ * @return 1 on success, 0 on failure.
+ */
+static int32_t SDDS_MPI_AssignColumns(SDDS_DATASET *SDDS_dataset, int32_t *owner) {
+  MPI_DATASET *MPI_dataset;
+  SDDS_LAYOUT *layout;
+  int64_t i, *load;
+  int32_t size, width, rank;
+
+  MPI_dataset = SDDS_dataset->MPI_dataset;
+  layout = &SDDS_dataset->layout;
+  if (MPI_dataset->read_decomposition != SDDS_MPI_READ_BY_COLUMN_BYTES) {
+    for (i = 0; i < layout->n_columns; i++)
+      owner[i] = i % MPI_dataset->n_processors;
+    return 1;
+  }
+  if (!(load = calloc(MPI_dataset->n_processors, sizeof(*load)))) {
+    SDDS_SetError("Memory allocation failed (SDDS_MPI_AssignColumns)");
+    return 0;
+  }
+  /* type sizes are 1 to 16 bytes, so a pass per width keeps the assignment deterministic */
+  for (width = 16; width > 0; width--) {
+    for (i = 0; i < layout->n_columns; i++) {
+      if ((size = SDDS_type_size[layout->column_definition[i].type - 1]) != width)
+        continue;
+      owner[i] = 0;
+      for (rank = 1; rank < MPI_dataset->n_processors; rank++)
+        if (load[rank] < load[owner[i]])
+          owner[i] = rank;
+      load[owner[i]] += size;
+    }
+  }
+  free(load);
+  return 1;
+}
+
+/**
+ * @brief Read the column data of a column-major page with a column decomposition.
+ *
+ * Each processor reads all rows of its assigned columns (see SDDS_MPI_SetReadDecomposition)
+ * with a single MPI_File_read_at_all, using hindexed file and memory datatypes so that the
+ * columns land directly in the page's column arrays.  The file offset must point at the start
+ * of the page's column data.  All processors must call this function.
+ *
+ * @param SDDS_dataset Pointer to the SDDS_DATASET structure.
+ * @return 1 on success, 0 on failure; a failure on any processor fails the page on all of them.
+ */
+int32_t SDDS_MPI_ReadPageByColumns(SDDS_DATASET *SDDS_dataset) {
+  MPI_DATASET *MPI_dataset;
+  SDDS_LAYOUT *layout;
+  MPI_Datatype filetype, memtype;
+  MPI_Aint *file_displacement = NULL, *memory_displacement = NULL, address;
+  MPI_Offset offset, length, start;
+  int *block_length = NULL;
+  int32_t *owner, mpi_code, size, status;
+  int64_t i, n_blocks, total_rows, chunk;
+
+#if MPI_DEBUG
+  logDebug("SDDS_MPI_ReadPageByColumns", SDDS_dataset);
+#endif
+
+  MPI_dataset = SDDS_dataset->MPI_dataset;
+  layout = &SDDS_dataset->layout;
+  total_rows = MPI_dataset->total_rows;
+  for (i = 0; i < layout->n_columns; i++)
+    if (layout->column_definition[i].type == SDDS_STRING) {
+      SDDS_SetError("Can not read string column from SDDS3 (SDDS_MPI_ReadPageByColumns)");
+      return 0;
+    }
+  /* a processor that fails before the collective read still takes part in it, reading nothing */
+  status = 1;
+  if (!(owner = malloc(sizeof(*owner) * (layout->n_columns + 1)))) {
+    SDDS_SetError("Memory allocation failed (SDDS_MPI_ReadPageByColumns)");
+    status = 0;
+  } else if (!SDDS_MPI_AssignColumns(SDDS_dataset, owner))
+    status = 0;
+  MPI_dataset->start_row = 0;
+  if (status && (!SDDS_StartPage(SDDS_dataset, 0) || !SDDS_LengthenTable(SDDS_dataset, total_rows))) {
+    SDDS_SetError("Unable to read page--couldn't start page (SDDS_MPI_ReadPageByColumns)");
+    status = 0;
+  }
+
+  n_blocks = layout->n_columns + (total_rows * MPI_dataset->column_offset) / SDDS_MPI_COLLECTIVE_CHUNK + 1;
+  if (status &&
+      (!(file_displacement = malloc(sizeof(*file_displacement) * n_blocks)) ||
+       !(memory_displacement = malloc(sizeof(*memory_displacement) * n_blocks)) ||
+       !(block_length = malloc(sizeof(*block_length) * n_blocks)))) {
+    SDDS_SetError("Memory allocation failed (SDDS_MPI_ReadPageByColumns)");
+    status = 0;
+  }
+  n_blocks = 0;
+  offset = 0;
+  for (i = 0; i < layout->n_columns; i++) {
+    size = SDDS_type_size[layout->column_definition[i].type - 1];
+    if (status && owner[i] == MPI_dataset->myid) {
+      MPI_Get_address(SDDS_dataset->data[i], &address);
+      start = 0;
+      length = (MPI_Offset)total_rows * size;
+      while (start < length) {
+        chunk = length - start > SDDS_MPI_COLLECTIVE_CHUNK ? SDDS_MPI_COLLECTIVE_CHUNK : length - start;
+        file_displacement[n_blocks] = (MPI_Aint)(offset + start);
+        memory_displacement[n_blocks] = MPI_Aint_add(address, (MPI_Aint)start);
+        block_length[n_blocks] = (int)chunk;
+        start += chunk;
+        n_blocks++;
+      }
+    }
+    offset += (MPI_Offset)total_rows * size;
+  }
+
+  filetype = memtype = MPI_DATATYPE_NULL;
+  if (n_blocks &&
+      ((mpi_code = MPI_Type_create_hindexed((int)n_blocks, block_length, file_displacement, MPI_BYTE, &filetype)) != MPI_SUCCESS ||
+       (mpi_code = MPI_Type_create_hindexed((int)n_blocks, block_length, memory_displacement, MPI_BYTE, &memtype)) != MPI_SUCCESS ||
+       (mpi_code = MPI_Type_commit(&filetype)) != MPI_SUCCESS || (mpi_code = MPI_Type_commit(&memtype)) != MPI_SUCCESS)) {
+    SDDS_MPI_GOTO_ERROR(stderr, "SDDS_MPI_ReadPageByColumns(MPI datatype creation failed)", mpi_code, 0);
+    SDDS_SetError("Unable to create datatypes for binary columns (SDDS_MPI_ReadPageByColumns)");
+    status = 0;
+  }
+  if (file_displacement)
+    free(file_displacement);
+  if (memory_displacement)
+    free(memory_displacement);
+  if (block_length)
+    free(block_length);
+  if (!status)
+    n_blocks = 0;
+  if ((mpi_code = MPI_File_set_view(MPI_dataset->MPI_file, MPI_dataset->file_offset, MPI_BYTE, n_blocks ? filetype : MPI_BYTE, "native", MPI_INFO_NULL)) == MPI_SUCCESS) {
+    if (n_blocks)
+      mpi_code = MPI_File_read_at_all(MPI_dataset->MPI_file, 0, MPI_BOTTOM, 1, memtype, MPI_STATUS_IGNORE);
+    else
+      mpi_code = MPI_File_read_at_all(MPI_dataset->MPI_file, 0, NULL, 0, MPI_BYTE, MPI_STATUS_IGNORE);
+  }
+  if (filetype != MPI_DATATYPE_NULL)
+    MPI_Type_free(&filetype);
+  if (memtype != MPI_DATATYPE_NULL)
+    MPI_Type_free(&memtype);
+  if (mpi_code != MPI_SUCCESS) {
+    SDDS_MPI_GOTO_ERROR(stderr, "SDDS_MPI_ReadPageByColumns(MPI_File_read_at_all failed)", mpi_code, 0);
+    SDDS_SetError("Unable to read binary columns (SDDS_MPI_ReadPageByColumns)");
+    status = 0;
+  }
+  /* a failure on one processor fails the page everywhere, so that all stay on the same page */
+  MPI_Allreduce(MPI_IN_PLACE, &status, 1, MPI_INT32_T, MPI_MIN, MPI_dataset->comm);
+  if (!status) {
+    if (owner)
+      free(owner);
+    return 0;
+  }
+
+  /* the columns this processor read are its columns of interest */
+  if (!SDDS_SetColumnFlags(SDDS_dataset, 0)) {
+    free(owner);
+    return 0;
+  }
+  for (i = 0; i < layout->n_columns; i++)
+    if (owner[i] == MPI_dataset->myid) {
+      SDDS_dataset->column_flag[i] = 1;
+      SDDS_dataset->column_order[SDDS_dataset->n_of_interest++] = i;
+    }
+  free(owner);
+  MPI_dataset->n_rows = SDDS_dataset->n_rows = total_rows;
+  MPI_dataset->file_offset += offset;
+  if ((mpi_code = MPI_File_set_view(MPI_dataset->MPI_file, MPI_dataset->file_offset, MPI_BYTE, MPI_BYTE, "native", MPI_INFO_NULL)) != MPI_SUCCESS) {
+    SDDS_SetError("Unable to set view for read binary columns (SDDS_MPI_ReadPageByColumns)");
+    return 0;
+  }
+  return 1;
+}
+
+/**
+ * @brief Read a sparse or last-rows selection of the current page using MPI parallel I/O.
+ *
+ * The rows selected by MPI_dataset->sparse_interval and sparse_offset, or the last
+ * MPI_dataset->last_rows rows, are divided among the processors the same way SDDS_MPI_ReadBinaryPage
+ * divides a whole page.  Each processor describes its share with a strided file type (one vector per
+ * column for column-major files, one vector of rows for row-major files) and all processors read with
+ * a single collective call, so only the selected rows are transferred.  Rows must have a fixed width,
+ * so string columns are not supported.  The file offset is left at the start of the next page.
+ *
+ * @param[in,out] SDDS_dataset Pointer to the SDDS_DATASET structure; the title must already be read.
+ * @return 1 on success, 0 on failure; a failure on any processor fails the page on all of them.
+ */
+int32_t SDDS_MPI_ReadSelectedRows(SDDS_DATASET *SDDS_dataset) {
+  MPI_DATASET *MPI_dataset;
+  SDDS_LAYOUT *layout;
+  SDDS_FILEBUFFER *fBuffer, savedBuffer;
+  MPI_Datatype filetype, memtype, rowtype, *elementtype, *vectortype;
+  MPI_Aint *file_displacement, *memory_displacement;
+  MPI_Offset column_start;
+  int *file_length, *memory_length;
+  int32_t mpi_code, size, n_processors, processor, status;
+  int64_t i, first, stride, n_selected, n_rows, n_read, prev_rows, total_rows, length;
+  char *rows = NULL;
+  void *target;
+
+#if MPI_DEBUG
+  logDebug("SDDS_MPI_ReadSelectedRows", SDDS_dataset);
+#endif
+
+  MPI_dataset = SDDS_dataset->MPI_dataset;
+  layout = &SDDS_dataset->layout;
+  fBuffer = &SDDS_dataset->fBuffer;
+  total_rows = MPI_dataset->total_rows;
+  for (i = 0; i < layout->n_columns; i++)
+    if (layout->column_definition[i].type == SDDS_STRING) {
+      SDDS_SetError("Can not read string column sparsely with parallel io (SDDS_MPI_ReadSelectedRows)");
+      return 0;
+    }
+  if (MPI_dataset->last_rows > 0) {
+    stride = 1;
+    first = total_rows > MPI_dataset->last_rows ? total_rows - MPI_dataset->last_rows : 0;
+  } else {
+    stride = MPI_dataset->sparse_interval > 1 ? MPI_dataset->sparse_interval : 1;
+    first = MPI_dataset->sparse_offset > 0 ? MPI_dataset->sparse_offset : 0;
+  }
+  n_selected = first < total_rows ? (total_rows - first - 1) / stride + 1 : 0;
+
+  /* divide the selected rows as SDDS_MPI_ReadBinaryPage divides a page */
+  n_processors = MPI_dataset->master_read ? MPI_dataset->n_processors : MPI_dataset->n_processors - 1;
+  processor = MPI_dataset->master_read ? MPI_dataset->myid : MPI_dataset->myid - 1;
+  n_rows = prev_rows = 0;
+  if (processor >= 0) {
+    n_rows = n_selected / n_processors;
+    prev_rows = processor * n_rows + (processor < n_selected % n_processors ? processor : n_selected % n_processors);
+    if (processor < n_selected % n_processors)
+      n_rows++;
+  }
+  /* a processor that fails before the collective read still takes part in it, reading nothing */
+  status = 1;
+  if (n_rows > INT_MAX) {
+    SDDS_SetError("Too many selected rows for one processor (SDDS_MPI_ReadSelectedRows)");
+    status = 0;
+  }
+  first += prev_rows * stride;
+  MPI_dataset->start_row = first; /* row of the page that this processor's first row came from */
+  if (status && (!SDDS_StartPage(SDDS_dataset, 0) || !SDDS_LengthenTable(SDDS_dataset, n_rows))) {
+    SDDS_SetError("Unable to read page--couldn't start page (SDDS_MPI_ReadSelectedRows)");
+    status = 0;
+  }
+
+  /* n_read is n_rows once the datatypes for this processor's rows are set up */
+  filetype = memtype = MPI_BYTE;
+  target = NULL;
+  n_read = 0;
+  if (status && n_rows && layout->data_mode.column_major) {
+    elementtype = malloc(sizeof(*elementtype) * layout->n_columns);
+    vectortype = malloc(sizeof(*vectortype) * layout->n_columns);
+    file_displacement = malloc(sizeof(*file_displacement) * layout->n_columns);
+    memory_displacement = malloc(sizeof(*memory_displacement) * layout->n_columns);
+    file_length = malloc(sizeof(*file_length) * layout->n_columns);
+    memory_length = malloc(sizeof(*memory_length) * layout->n_columns);
+    if (!elementtype || !vectortype || !file_displacement || !memory_displacement || !file_length || !memory_length) {
+      SDDS_SetError("Memory allocation failed (SDDS_MPI_ReadSelectedRows)");
+      status = 0;
+    } else {
+      column_start = 0;
+      for (i = 0; i < layout->n_columns; i++) {
+        size = SDDS_type_size[layout->column_definition[i].type - 1];
+        MPI_Type_contiguous(size, MPI_BYTE, &elementtype[i]);
+        MPI_Type_create_hvector((int)n_rows, 1, (MPI_Aint)stride * size, elementtype[i], &vectortype[i]);
+        file_displacement[i] = (MPI_Aint)(column_start + (MPI_Offset)first * size);
+        file_length[i] = 1;
+        MPI_Get_address(SDDS_dataset->data[i], &memory_displacement[i]);
+        memory_length[i] = (int)n_rows;
+        column_start += (MPI_Offset)total_rows * size;
+      }
+      MPI_Type_create_struct(layout->n_columns, file_length, file_displacement, vectortype, &filetype);
+      MPI_Type_create_struct(layout->n_columns, memory_length, memory_displacement, elementtype, &memtype);
+      MPI_Type_commit(&filetype);
+      MPI_Type_commit(&memtype);
+      for (i = 0; i < layout->n_columns; i++) {
+        MPI_Type_free(&elementtype[i]);
+        MPI_Type_free(&vectortype[i]);
+      }
+      target = MPI_BOTTOM;
+      n_read = n_rows;
+    }
+    if (elementtype)
+      free(elementtype);
+    if (vectortype)
+      free(vectortype);
+    if (file_displacement)
+      free(file_displacement);
+    if (memory_displacement)
+      free(memory_displacement);
+    if (file_length)
+      free(file_length);
+    if (memory_length)
+      free(memory_length);
+  } else if (status && n_rows) {
+    /* row-major rows are gathered into a scratch buffer and decoded in one pass */
+    length = n_rows * MPI_dataset->column_offset;
+    if (!(rows = SDDS_Malloc(sizeof(*rows) * (length + 1)))) {
+      SDDS_SetError("Memory allocation failed (SDDS_MPI_ReadSelectedRows)");
+      status = 0;
+    } else {
+      MPI_Type_contiguous((int)MPI_dataset->column_offset, MPI_BYTE, &rowtype);
+      MPI_Type_create_hvector((int)n_rows, 1, (MPI_Aint)(stride * MPI_dataset->column_offset), rowtype, &filetype);
+      MPI_Type_contiguous((int)n_rows, rowtype, &memtype);
+      MPI_Type_free(&rowtype);
+      MPI_Type_commit(&filetype);
+      MPI_Type_commit(&memtype);
+      target = rows;
+      n_read = n_rows;
+    }
+  }
+  if (n_read && !layout->data_mode.column_major)
+    mpi_code = MPI_File_set_view(MPI_dataset->MPI_file, MPI_dataset->file_offset + (MPI_Offset)first * MPI_dataset->column_offset, MPI_BYTE, filetype, "native", MPI_INFO_NULL);
+  else
+    mpi_code = MPI_File_set_view(MPI_dataset->MPI_file, MPI_dataset->file_offset, MPI_BYTE, filetype, "native", MPI_INFO_NULL);
+  if (mpi_code == MPI_SUCCESS)
+    mpi_code = MPI_File_read_at_all(MPI_dataset->MPI_file, 0, target, n_read ? 1 : 0, memtype, MPI_STATUS_IGNORE);
+  if (n_read) {
+    MPI_Type_free(&filetype);
+    MPI_Type_free(&memtype);
+  }
+  if (mpi_code != MPI_SUCCESS) {
+    SDDS_MPI_GOTO_ERROR(stderr, "SDDS_MPI_ReadSelectedRows(MPI_File_read_at_all failed)", mpi_code, 0);
+    SDDS_SetError("Unable to read selected rows (SDDS_MPI_ReadSelectedRows)");
+    status = 0;
+  }
+  /* a failure on one processor fails the page everywhere, so that all stay on the same page */
+  MPI_Allreduce(MPI_IN_PLACE, &status, 1, MPI_INT32_T, MPI_MIN, MPI_dataset->comm);
+  if (!status) {
+    if (rows)
+      free(rows);
+    return 0;
+  }
+  if (rows) {
+    savedBuffer = *fBuffer;
+    fBuffer->buffer = fBuffer->data = rows;
+    fBuffer->bytesLeft = n_rows * MPI_dataset->column_offset;
+    SDDS_DecodeBufferedBinaryRows(SDDS_dataset, 0, n_rows, MPI_dataset->column_offset);
+    *fBuffer = savedBuffer;
+    fBuffer->bytesLeft = 0;
+    free(rows);
+  }
+  MPI_dataset->n_rows = SDDS_dataset->n_rows = n_rows;
+  MPI_dataset->file_offset += (MPI_Offset)total_rows * MPI_dataset->column_offset;
+  if ((mpi_code = MPI_File_set_view(MPI_dataset->MPI_file, MPI_dataset->file_offset, MPI_BYTE, MPI_BYTE, "native", MPI_INFO_NULL)) != MPI_SUCCESS) {
+    SDDS_SetError("Unable to set view for read binary rows (SDDS_MPI_ReadSelectedRows)");
+    return 0;
+  }
   return 1;
 }
 
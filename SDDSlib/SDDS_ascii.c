@@ -38,6 +38,13 @@
 */
 #define INITIAL_BIG_BUFFER_SIZE SDDS_MAXLINE
 
+/* Pages with at least this many rows are parsed by several threads, a block of text at a time,
+   when SDDS_SetAsciiReadThreads has been used to request more than one thread.
+*/
+#define ASCII_PARALLEL_MIN_ROWS 1024
+#define ASCII_PARALLEL_BLOCK_SIZE 16777216
+static int32_t asciiReadThreads = 1;
+
 /**
  * @brief Writes a typed value to an ASCII file stream.
  *
@@ -1201,6 +1208,187 @@ int32_t SDDS_ReadAsciiArrays(SDDS_DATASET *SDDS_dataset) {
   return (1);
 }
 
+/**
+ * @brief Sets the number of threads used to parse the rows of ASCII pages.
+ *
+ * When more than one thread is requested, pages of uncompressed ASCII files that have a row count
+ * and at least ASCII_PARALLEL_MIN_ROWS rows are read a block of text at a time, and the rows of each
+ * block are parsed by several threads directly into the column arrays.  Sparse, last-rows and
+ * statistics reads, files without row counts and files with lines_per_row=0 are always read row by row.
+ *
+ * @param threads Number of threads.  Values less than 1 are treated as 1, which disables parallel parsing.
+ *
+ * @return Returns the previous number of threads.
+ */
+int32_t SDDS_SetAsciiReadThreads(int32_t threads) {
+  int32_t previous;
+
+  previous = asciiReadThreads;
+  asciiReadThreads = threads < 1 ? 1 : threads;
+  return previous;
+}
+
+/**
+ * @brief Scans one row of an ASCII page from text that has already been split into lines.
+ *
+ * Follows the rules of SDDS_ReadAsciiPageDetailed for files with a nonzero lines_per_row: a new line is
+ * taken whenever the current one is exhausted, a blank line is an error, and the row must use exactly
+ * @p lines lines.
+ *
+ * @param SDDS_dataset Pointer to the SDDS dataset where the data will be stored.
+ * @param text Text of the page.
+ * @param line Start and end offsets in @p text of the lines of the row, in pairs.
+ * @param lines Number of lines in the row.
+ * @param row Index of the row in the page.
+ * @param buffer Work buffer, reallocated as needed.
+ * @param bufferSize Size of @p buffer.
+ *
+ * @return Returns 1 on success, or 0 if the row does not match the layout.
+ */
+static int32_t SDDS_ScanAsciiRow(SDDS_DATASET *SDDS_dataset, char *text, int64_t *line, int32_t lines, int64_t row, char **buffer, int64_t *bufferSize) {
+  SDDS_LAYOUT *layout;
+  char *remaining;
+  int32_t i, used, length;
+  int64_t size;
+
+  layout = &SDDS_dataset->layout;
+  remaining = NULL;
+  length = used = 0;
+  for (i = 0; i < layout->n_columns; i++) {
+    if (layout->column_definition[i].definition_mode & SDDS_WRITEONLY_DEFINITION)
+      continue;
+    if (SDDS_StringIsBlank(remaining)) {
+      if (used == lines)
+        return 0;
+      size = line[2 * used + 1] - line[2 * used];
+      if (size >= *bufferSize) {
+        if (size >= INT32_MAX || !(*buffer = SDDS_Realloc(*buffer, sizeof(**buffer) * (*bufferSize = 2 * size))))
+          return 0;
+      }
+      memcpy(*buffer, text + line[2 * used], size);
+      (*buffer)[size] = 0;
+      used++;
+      /* lines starting with a comment character were dropped when the text was split */
+      SDDS_CutOutComments(SDDS_dataset, *buffer, '!');
+      if (SDDS_StringIsBlank(*buffer))
+        return 0;
+      remaining = *buffer;
+      length = strlen(remaining);
+    }
+    if (!SDDS_ScanData2(remaining, &remaining, &length, layout->column_definition[i].type, layout->column_definition[i].field_length, SDDS_dataset->data[i], row, 0))
+      return 0;
+  }
+  return used == lines;
+}
+
+/**
+ * @brief Reads the rows of an ASCII page with several threads.
+ *
+ * The text following the row count is read in blocks of about ASCII_PARALLEL_BLOCK_SIZE bytes.  Each
+ * block is split into lines, comment lines are dropped, and every lines_per_row lines form a row; the
+ * complete rows of the block are then parsed in parallel.  The column arrays must already have room for
+ * @p n_rows rows.
+ *
+ * @param SDDS_dataset Pointer to the SDDS dataset where the data will be stored.
+ * @param fp File, positioned after the row count of the page.
+ * @param n_rows Number of rows in the page.
+ *
+ * @return Returns 1 on success, with @p fp positioned after the page.  Returns 0 if the page could not be
+ *         parsed this way, with @p fp back where it was on entry so that the page can be read row by row,
+ *         which reports the problem.
+ */
+static int32_t SDDS_ReadAsciiRowsParallel(SDDS_DATASET *SDDS_dataset, FILE *fp, int64_t n_rows) {
+  char *text, *newline;
+  int64_t *line;
+  int64_t start, consumed, textSize, textLength, got, position, next, blockEnd, lines, linesAllocated, rowsDone;
+  int32_t linesPerRow, rowsInBlock, failed, eof;
+
+  if ((start = ftell(fp)) < 0)
+    return 0;
+  linesPerRow = SDDS_dataset->layout.data_mode.lines_per_row;
+  textSize = ASCII_PARALLEL_BLOCK_SIZE;
+  linesAllocated = 0;
+  line = NULL;
+  if (!(text = SDDS_Malloc(sizeof(*text) * textSize)))
+    return 0;
+  consumed = textLength = rowsDone = 0;
+  failed = eof = 0;
+  while (!failed && rowsDone < n_rows) {
+    if (!eof && textLength < textSize) {
+      got = fread(text + textLength, sizeof(*text), textSize - textLength, fp);
+      if (got < textSize - textLength)
+        eof = 1;
+      textLength += got;
+    }
+    /* split the text into lines, keeping only complete rows */
+    position = lines = blockEnd = 0;
+    rowsInBlock = 0;
+    while (rowsDone + rowsInBlock < n_rows && position < textLength) {
+      if ((newline = memchr(text + position, '\n', textLength - position)))
+        next = newline - text + 1;
+      else if (eof)
+        next = textLength;
+      else
+        break;
+      if (text[position] != '!') {
+        if (lines == linesAllocated &&
+            !(line = SDDS_Realloc(line, sizeof(*line) * 2 * (linesAllocated = 2 * linesAllocated + 1024)))) {
+          failed = 1;
+          break;
+        }
+        line[2 * lines] = position;
+        line[2 * lines + 1] = next;
+        if (++lines % linesPerRow == 0) {
+          rowsInBlock++;
+          blockEnd = next;
+        }
+      }
+      position = next;
+    }
+    if (failed)
+      break;
+    if (!rowsInBlock) {
+      if (eof || textSize >= INT32_MAX) {
+        failed = 1;
+        break;
+      }
+      /* a row longer than the buffer */
+      if (!(text = SDDS_Realloc(text, sizeof(*text) * (textSize *= 2)))) {
+        failed = 1;
+        break;
+      }
+      continue;
+    }
+#pragma omp parallel num_threads(asciiReadThreads)
+    {
+      char *buffer;
+      int64_t bufferSize;
+      int32_t row;
+
+      bufferSize = INITIAL_BIG_BUFFER_SIZE;
+      buffer = SDDS_Malloc(sizeof(*buffer) * bufferSize);
+#pragma omp for schedule(static) reduction(| : failed)
+      for (row = 0; row < rowsInBlock; row++)
+        failed |= !buffer || !SDDS_ScanAsciiRow(SDDS_dataset, text, line + 2 * (int64_t)row * linesPerRow, linesPerRow, rowsDone + row, &buffer, &bufferSize);
+      if (buffer)
+        free(buffer);
+    }
+    rowsDone += rowsInBlock;
+    consumed += blockEnd;
+    memmove(text, text + blockEnd, textLength - blockEnd);
+    textLength -= blockEnd;
+  }
+  free(text);
+  if (line)
+    free(line);
+  if (failed) {
+    fseek(fp, start, SEEK_SET);
+    return 0;
+  }
+  fseek(fp, start + consumed, SEEK_SET);
+  return 1;
+}
+
 /**
  * @brief Reads the next SDDS ASCII page into memory with optional data sparsity and statistics.
  *
@@ -1468,6 +1656,12 @@ int32_t SDDS_ReadAsciiPageDetailed(SDDS_DATASET *SDDS_dataset, int64_t sparse_in
         free(bigBuffer);
       return (SDDS_dataset->page_number);
     }
+    if (fp && !no_row_counts && asciiReadThreads > 1 && n_rows >= ASCII_PARALLEL_MIN_ROWS && sparse_interval == 1 && sparse_offset == 0 &&
+        sparse_statistics == 0 && layout->data_mode.lines_per_row > 0 && SDDS_ReadAsciiRowsParallel(SDDS_dataset, fp, n_rows)) {
+      SDDS_dataset->n_rows = n_rows;
+      free(bigBuffer);
+      return (SDDS_dataset->page_number);
+    }
     bigBuffer[0] = 0;
     bigBufferCopy = bigBuffer;
     do {
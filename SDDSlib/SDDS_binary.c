@@ -298,9 +298,17 @@ int32_t SDDS_LZMABufferedRead(void *target, int64_t targetSize, struct lzmafile
 
     if (fBuffer->bufferSize < bytesNeeded) {
       /* just read what is needed directly into user's memory or seek */
-      if (!target)
-        return !lzma_seek(lzmafp, (long)bytesNeeded, SEEK_CUR);
-      else {
+      if (!target) {
+        /* lzma_seek moves within the compressed file, so the data are read and discarded instead */
+        int64_t bytesRead;
+        while (bytesNeeded > 0) {
+          bytesRead = bytesNeeded < fBuffer->bufferSize ? bytesNeeded : fBuffer->bufferSize;
+          if (lzma_read(lzmafp, fBuffer->buffer, (size_t)bytesRead) != bytesRead)
+            return 0;
+          bytesNeeded -= bytesRead;
+        }
+        return 1;
+      } else {
         if (float80tofloat64) {
           unsigned char x[16];
           double d;
@@ -423,7 +431,7 @@ int32_t SDDS_GZipBufferedRead(void *target, int64_t targetSize, gzFile gzfp, SDD
     if (fBuffer->bufferSize < bytesNeeded) {
       /* just read what is needed directly into user's memory or seek */
       if (!target)
-        return !gzseek(gzfp, bytesNeeded, SEEK_CUR);
+        return gzseek(gzfp, bytesNeeded, SEEK_CUR) >= 0;
       else {
         if (float80tofloat64) {
           unsigned char x[16];
@@ -2201,7 +2209,7 @@ int32_t SDDS_ReadBinaryPageLastRows(SDDS_DATASET *SDDS_dataset, int64_t last_row
  */
 int32_t SDDS_ReadBinaryPageDetailed(SDDS_DATASET *SDDS_dataset, int64_t sparse_interval, int64_t sparse_offset, int64_t last_rows, int32_t sparse_statistics) {
   int32_t n_rows32;
-  int64_t n_rows, i, j, k, alloc_rows, rows_to_store, mod;
+  int64_t n_rows, i, j, k, alloc_rows, rows_to_store, mod, rowSize;
 
   /*  int32_t page_number, i; */
 #if defined(zLib)
@@ -2350,7 +2358,7 @@ int32_t SDDS_ReadBinaryPageDetailed(SDDS_DATASET *SDDS_dataset, int64_t sparse_i
   rows_to_store = (n_rows - sparse_offset) / sparse_interval + 2;
   alloc_rows = rows_to_store - SDDS_dataset->n_rows_allocated;
 
-  if (!SDDS_StartPage(SDDS_dataset, 0) || !SDDS_LengthenTable(SDDS_dataset, alloc_rows)) {
+  if (!SDDS_StartPage(SDDS_dataset, 0)) {
     SDDS_SetError("Unable to read page--couldn't start page (SDDS_ReadBinaryPageDetailed)");
     return (0);
   }
@@ -2361,6 +2369,19 @@ int32_t SDDS_ReadBinaryPageDetailed(SDDS_DATASET *SDDS_dataset, int64_t sparse_i
     return (0);
   }
 
+  if (SDDS_dataset->readFilters && !SDDS_PageMatchesReadFilters(SDDS_dataset)) {
+    /* page rejected by the read filters--skip over the data without storing it */
+    if (!SDDS_ReadBinaryArrays(SDDS_dataset) || !SDDS_SkipBinaryColumnData(SDDS_dataset, n_rows)) {
+      SDDS_SetError("Unable to read page--error skipping data (SDDS_ReadBinaryPageDetailed)");
+      return (0);
+    }
+    return (SDDS_dataset->page_number);
+  }
+  if (!SDDS_LengthenTable(SDDS_dataset, alloc_rows)) {
+    SDDS_SetError("Unable to read page--couldn't start page (SDDS_ReadBinaryPageDetailed)");
+    return (0);
+  }
+
   /* read the array values */
   if (!SDDS_ReadBinaryArrays(SDDS_dataset)) {
     SDDS_SetError("Unable to read page--array reading error (SDDS_ReadBinaryPageDetailed)");
@@ -2375,7 +2396,10 @@ int32_t SDDS_ReadBinaryPageDetailed(SDDS_DATASET *SDDS_dataset, int64_t sparse_i
     return (SDDS_dataset->page_number);
   }
   if ((sparse_interval <= 1) && (sparse_offset == 0)) {
+    rowSize = SDDS_FixedBinaryRowSize(SDDS_dataset);
     for (j = 0; j < n_rows; j++) {
+      if (rowSize && (j += SDDS_DecodeBufferedBinaryRows(SDDS_dataset, j, n_rows - j, rowSize)) == n_rows)
+        break;
       if (!SDDS_ReadBinaryRow(SDDS_dataset, j, 0)) {
         SDDS_dataset->n_rows = j;
         if (SDDS_dataset->autoRecover) {
@@ -2814,6 +2838,102 @@ int32_t SDDS_ReadBinaryRow(SDDS_DATASET *SDDS_dataset, int64_t row, int32_t skip
   return (1);
 }
 
+/**
+ * @brief Returns the number of bytes occupied by one row of a fixed-width binary row layout.
+ *
+ * A row-major page can be decoded in blocks straight out of the file buffer when every
+ * readable column has a fixed on-disk width.  String columns (variable length) and long double
+ * columns (which may require float80 conversion) disqualify the layout, as does reading
+ * without an I/O buffer.
+ *
+ * @param[in] SDDS_dataset Pointer to the SDDS_DATASET structure.
+ *
+ * @return The row size in bytes, or 0 if rows must be read one at a time with SDDS_ReadBinaryRow.
+ */
+int64_t SDDS_FixedBinaryRowSize(SDDS_DATASET *SDDS_dataset) {
+  SDDS_LAYOUT *layout;
+  int64_t i, rowSize;
+  int32_t type;
+
+  layout = &SDDS_dataset->layout;
+  if (!SDDS_dataset->fBuffer.bufferSize)
+    return (0);
+  rowSize = 0;
+  for (i = 0; i < layout->n_columns; i++) {
+    if (layout->column_definition[i].definition_mode & SDDS_WRITEONLY_DEFINITION)
+      continue;
+    type = layout->column_definition[i].type;
+    if (type == SDDS_STRING || type == SDDS_LONGDOUBLE)
+      return (0);
+    rowSize += SDDS_type_size[type - 1];
+  }
+  return (rowSize);
+}
+
+/**
+ * @brief Decodes the complete rows currently held in the file buffer into the column arrays.
+ *
+ * Rather than issuing one buffered read per value, this function scatters every whole row
+ * already present in the dataset's I/O buffer into the column arrays in a single pass per column
+ * and advances the buffer past them.  It never touches the underlying file; a row that straddles
+ * the end of the buffer is left for SDDS_ReadBinaryRow, which refills the buffer, after which the
+ * caller may resume block decoding.
+ *
+ * @param[in,out] SDDS_dataset Pointer to the SDDS_DATASET structure.
+ * @param[in] row Index of the first row to store.
+ * @param[in] n_rows Maximum number of rows to decode.
+ * @param[in] rowSize Row size in bytes, as returned by SDDS_FixedBinaryRowSize.
+ *
+ * @return The number of rows decoded, which may be zero.
+ */
+int64_t SDDS_DecodeBufferedBinaryRows(SDDS_DATASET *SDDS_dataset, int64_t row, int64_t n_rows, int64_t rowSize) {
+  SDDS_LAYOUT *layout;
+  SDDS_FILEBUFFER *fBuffer;
+  int64_t i, j, rows, size, offset;
+  char *source, *target;
+
+  layout = &SDDS_dataset->layout;
+  fBuffer = &SDDS_dataset->fBuffer;
+  if (rowSize <= 0 || fBuffer->bytesLeft < rowSize)
+    return (0);
+  if ((rows = fBuffer->bytesLeft / rowSize) > n_rows)
+    rows = n_rows;
+  offset = 0;
+  for (i = 0; i < layout->n_columns; i++) {
+    if (layout->column_definition[i].definition_mode & SDDS_WRITEONLY_DEFINITION)
+      continue;
+    size = SDDS_type_size[layout->column_definition[i].type - 1];
+    source = fBuffer->data + offset;
+    target = (char *)SDDS_dataset->data[i] + row * size;
+    switch (size) {
+    case 8:
+      for (j = 0; j < rows; j++, source += rowSize, target += 8)
+        memcpy(target, source, 8);
+      break;
+    case 4:
+      for (j = 0; j < rows; j++, source += rowSize, target += 4)
+        memcpy(target, source, 4);
+      break;
+    case 2:
+      for (j = 0; j < rows; j++, source += rowSize, target += 2)
+        memcpy(target, source, 2);
+      break;
+    case 1:
+      for (j = 0; j < rows; j++, source += rowSize)
+        *target++ = *source;
+      break;
+    default:
+      for (j = 0; j < rows; j++, source += rowSize, target += size)
+        memcpy(target, source, size);
+      break;
+    }
+    offset += size;
+  }
+  fBuffer->data += rows * rowSize;
+  fBuffer->bytesLeft -= rows * rowSize;
+  return (rows);
+}
+
 /**
  * @brief Reads new binary rows from the SDDS dataset.
  *
@@ -4229,7 +4349,7 @@ int32_t SDDS_ReadNonNativeBinaryPageLastRows(SDDS_DATASET *SDDS_dataset, int64_t
  */
 int32_t SDDS_ReadNonNativeBinaryPageDetailed(SDDS_DATASET *SDDS_dataset, int64_t sparse_interval, int64_t sparse_offset, int64_t last_rows) {
   int32_t n_rows32 = 0;
-  int64_t n_rows, j, k, alloc_rows, rows_to_store, mod;
+  int64_t n_rows, j, k, alloc_rows, rows_to_store, mod, rowSize;
   /*  int32_t page_number, i; */
 #if defined(zLib)
   gzFile gzfp = NULL;
@@ -4358,7 +4478,7 @@ int32_t SDDS_ReadNonNativeBinaryPageDetailed(SDDS_DATASET *SDDS_dataset, int64_t
 
   rows_to_store = (n_rows - sparse_offset) / sparse_interval + 2;
   alloc_rows = rows_to_store - SDDS_dataset->n_rows_allocated;
-  if (!SDDS_StartPage(SDDS_dataset, 0) || !SDDS_LengthenTable(SDDS_dataset, alloc_rows)) {
+  if (!SDDS_StartPage(SDDS_dataset, 0)) {
     SDDS_SetError("Unable to read page--couldn't start page (SDDS_ReadNonNativeBinaryPage)");
     return (0);
   }
@@ -4369,6 +4489,19 @@ int32_t SDDS_ReadNonNativeBinaryPageDetailed(SDDS_DATASET *SDDS_dataset, int64_t
     return (0);
   }
 
+  if (SDDS_dataset->readFilters && !SDDS_PageMatchesReadFilters(SDDS_dataset)) {
+    /* page rejected by the read filters--skip over the data without storing it */
+    if (!SDDS_ReadNonNativeBinaryArrays(SDDS_dataset) || !SDDS_SkipBinaryColumnData(SDDS_dataset, n_rows)) {
+      SDDS_SetError("Unable to read page--error skipping data (SDDS_ReadNonNativeBinaryPage)");
+      return (0);
+    }
+    return (SDDS_dataset->page_number);
+  }
+  if (!SDDS_LengthenTable(SDDS_dataset, alloc_rows)) {
+    SDDS_SetError("Unable to read page--couldn't start page (SDDS_ReadNonNativeBinaryPage)");
+    return (0);
+  }
+
   /* read the array values */
   if (!SDDS_ReadNonNativeBinaryArrays(SDDS_dataset)) {
     SDDS_SetError("Unable to read page--array reading error (SDDS_ReadNonNativeBinaryPage)");
@@ -4384,7 +4517,10 @@ int32_t SDDS_ReadNonNativeBinaryPageDetailed(SDDS_DATASET *SDDS_dataset, int64_t
     return (SDDS_dataset->page_number);
   }
   if ((sparse_interval <= 1) && (sparse_offset == 0)) {
+    rowSize = SDDS_FixedBinaryRowSize(SDDS_dataset);
     for (j = 0; j < n_rows; j++) {
+      if (rowSize && (j += SDDS_DecodeBufferedBinaryRows(SDDS_dataset, j, n_rows - j, rowSize)) == n_rows)
+        break;
       if (!SDDS_ReadNonNativeBinaryRow(SDDS_dataset, j, 0)) {
         SDDS_dataset->n_rows = j - 1;
         if (SDDS_dataset->autoRecover) {
@@ -4953,6 +5089,89 @@ char *SDDS_ReadNonNativeGZipBinaryString(gzFile gzfp, SDDS_FILEBUFFER *fBuffer,
 }
 #endif
 
+/**
+ * @brief Skips over the tabular data of a binary page without storing it.
+ *
+ * Used when a page is rejected by the read filters after its parameters have been read.
+ * Fixed-width data is skipped in a single buffered seek; string columns (and long doubles, which
+ * may need conversion on input) are stepped over value by value.
+ *
+ * @param[in,out] SDDS_dataset Pointer to the SDDS_DATASET structure representing the dataset to read from.
+ * @param[in] n_rows Number of rows in the page.
+ *
+ * @return int32_t Returns 1 on success, or 0 if an error occurred.
+ */
+int32_t SDDS_SkipBinaryColumnData(SDDS_DATASET *SDDS_dataset, int64_t n_rows) {
+  SDDS_LAYOUT *layout;
+  SDDS_FILEBUFFER *fBuffer;
+  int64_t i, row, bytes;
+  int32_t type, fixedWidth, ok;
+  char *string;
+
+  layout = &SDDS_dataset->layout;
+  fBuffer = &SDDS_dataset->fBuffer;
+  if (!n_rows || !layout->n_columns)
+    return (1);
+  for (i = bytes = 0, fixedWidth = 1; i < layout->n_columns; i++) {
+    if (layout->column_definition[i].definition_mode & SDDS_WRITEONLY_DEFINITION)
+      continue;
+    type = layout->column_definition[i].type;
+    if (type == SDDS_STRING || type == SDDS_LONGDOUBLE)
+      fixedWidth = 0;
+    else
+      bytes += SDDS_type_size[type - 1];
+  }
+  if (!layout->data_mode.column_major && !fixedWidth) {
+    for (row = 0; row < n_rows; row++) {
+      if (!(SDDS_dataset->swapByteOrder ? SDDS_ReadNonNativeBinaryRow(SDDS_dataset, 0, 1) : SDDS_ReadBinaryRow(SDDS_dataset, 0, 1)))
+        return (0);
+    }
+    return (1);
+  }
+  for (i = 0; i < layout->n_columns; i++) {
+    if (layout->column_definition[i].definition_mode & SDDS_WRITEONLY_DEFINITION)
+      continue;
+    type = layout->column_definition[i].type;
+    if (layout->data_mode.column_major && type == SDDS_STRING) {
+      for (row = 0; row < n_rows; row++) {
+#if defined(zLib)
+        if (layout->gzipFile)
+          string = SDDS_dataset->swapByteOrder ? SDDS_ReadNonNativeGZipBinaryString(layout->gzfp, fBuffer, 1) : SDDS_ReadGZipBinaryString(layout->gzfp, fBuffer, 1);
+        else
+#endif
+          if (layout->lzmaFile)
+            string = SDDS_dataset->swapByteOrder ? SDDS_ReadNonNativeLZMABinaryString(layout->lzmafp, fBuffer, 1) : SDDS_ReadLZMABinaryString(layout->lzmafp, fBuffer, 1);
+          else
+            string = SDDS_dataset->swapByteOrder ? SDDS_ReadNonNativeBinaryString(layout->fp, fBuffer, 1) : SDDS_ReadBinaryString(layout->fp, fBuffer, 1);
+        if (!string)
+          return (0);
+        free(string);
+      }
+      continue;
+    }
+    if (layout->data_mode.column_major)
+      bytes = n_rows * SDDS_type_size[type - 1];
+    else {
+      /* row-major data of fixed width is skipped as one block */
+      bytes *= n_rows;
+      type = SDDS_DOUBLE;
+      i = layout->n_columns;
+    }
+#if defined(zLib)
+    if (layout->gzipFile)
+      ok = SDDS_GZipBufferedRead(NULL, bytes, layout->gzfp, fBuffer, type, layout->byteOrderDeclared);
+    else
+#endif
+      if (layout->lzmaFile)
+        ok = SDDS_LZMABufferedRead(NULL, bytes, layout->lzmafp, fBuffer, type, layout->byteOrderDeclared);
+      else
+        ok = SDDS_BufferedRead(NULL, bytes, layout->fp, fBuffer, type, layout->byteOrderDeclared);
+    if (!ok)
+      return (0);
+  }
+  return (1);
+}
+
 /**
  * @brief Writes a non-native endian binary page to an SDDS dataset.
  *
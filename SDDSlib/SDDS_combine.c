@@ -0,0 +1,425 @@
+/**
+ * @file SDDS_combine.c
+ * @brief Threaded concatenation of many SDDS files into one output dataset.
+ *
+ * SDDS_CombineFiles appends every page of a list of input files to an output dataset.  Input files
+ * are opened, checked against the output layout and decoded by a pool of OpenMP threads, while the
+ * pages are written to the output strictly in input order.  Binary inputs whose layout and byte order
+ * match the output exactly are not decoded at all: their data section is copied to the output as raw
+ * bytes after the page boundaries have been verified.
+ *
+ * @copyright
+ *   - (c) 2002 The University of Chicago, as Operator of Argonne National Laboratory.
+ *   - (c) 2002 The Regents of the University of California, as Operator of Los Alamos National Laboratory.
+ *
+ * @license
+ * This file is distributed under the terms of the Software License Agreement
+ * found in the file LICENSE included with this distribution.
+ *
+ * @author M. Borland, C. Saunders, R. Soliday, H. Shang
+ */
+
+#include "mdb.h"
+#include "SDDS.h"
+#include "SDDS_internal.h"
+
+/* Per-input state handed from the reader thread to the ordered writer. */
+typedef struct {
+  char *data;           /* raw data section, for pass-through */
+  int64_t length;
+  int64_t rawPages;
+  SDDS_DATASET **page;  /* decoded pages, otherwise */
+  int32_t pages, maxPages;
+} SDDS_COMBINE_INPUT;
+
+/**
+ * Determines whether binary data written to an output dataset will be big-endian.
+ * Mirrors the choice made by SDDS_WriteBinaryPage.
+ */
+static int32_t SDDS_CombineOutputIsBigEndian(void) {
+  char *outputEndianess;
+  if ((outputEndianess = getenv("SDDS_OUTPUT_ENDIANESS"))) {
+    if (strncmp(outputEndianess, "big", 3) == 0)
+      return 1;
+    if (strncmp(outputEndianess, "little", 6) == 0)
+      return 0;
+  }
+  return SDDS_IsBigEndianMachine();
+}
+
+/**
+ * Returns the type an input item must have to be copied to an output item of the given type.
+ * SDDS_CopyPage casts only between numeric types, so strings and characters must match exactly.
+ */
+static int32_t SDDS_CombineCheckType(int32_t type) {
+  return type == SDDS_STRING || type == SDDS_CHARACTER ? type : SDDS_ANY_NUMERIC_TYPE;
+}
+
+/**
+ * Checks that every column, parameter and array of the output layout is present in an input file
+ * with a type that SDDS_CopyPage can transfer.
+ *
+ * @param SDDS_output Pointer to the output SDDS_DATASET.
+ * @param SDDS_input Pointer to the input SDDS_DATASET.
+ * @param filename Name of the input file, for error messages.
+ *
+ * @return Returns 1 if the layouts are compatible; 0 otherwise, with an error message recorded.
+ */
+static int32_t SDDS_CombineCheckLayout(SDDS_DATASET *SDDS_output, SDDS_DATASET *SDDS_input, char *filename) {
+  SDDS_LAYOUT *layout;
+  char *name, *kind;
+  char s[SDDS_MAXLINE];
+  int32_t i, type, status;
+
+  layout = &SDDS_output->layout;
+  for (i = 0; i < layout->n_columns + layout->n_parameters + layout->n_arrays; i++) {
+    if (i < layout->n_columns) {
+      name = layout->column_definition[i].name;
+      type = layout->column_definition[i].type;
+      kind = "column";
+      status = SDDS_CheckColumn(SDDS_input, name, NULL, SDDS_CombineCheckType(type), NULL);
+    } else if (i < layout->n_columns + layout->n_parameters) {
+      name = layout->parameter_definition[i - layout->n_columns].name;
+      type = layout->parameter_definition[i - layout->n_columns].type;
+      kind = "parameter";
+      status = SDDS_CheckParameter(SDDS_input, name, NULL, SDDS_CombineCheckType(type), NULL);
+    } else {
+      name = layout->array_definition[i - layout->n_columns - layout->n_parameters].name;
+      type = layout->array_definition[i - layout->n_columns - layout->n_parameters].type;
+      kind = "array";
+      status = SDDS_CheckArray(SDDS_input, name, NULL, SDDS_CombineCheckType(type), NULL);
+    }
+    if (status != SDDS_CHECK_OKAY) {
+      snprintf(s, sizeof(s), "%s %s of the output is %s in file %s (SDDS_CombineFiles)", kind, name,
+               status == SDDS_CHECK_NONEXISTENT ? "missing" : "of an incompatible type", filename);
+      SDDS_SetError(s);
+      return 0;
+    }
+  }
+  return 1;
+}
+
+/**
+ * Determines whether the data section of an input file can be copied to the output byte-for-byte.
+ *
+ * This requires uncompressed binary data on both sides with the same byte order and row/column
+ * ordering, and identical column and parameter definitions (names, types and fixed values, in the same
+ * order).  Only layouts whose page boundaries can be found without decoding rows are accepted, i.e.,
+ * those without string columns or arrays.
+ */
+static int32_t SDDS_CombineIsRawCompatible(SDDS_DATASET *SDDS_output, SDDS_DATASET *SDDS_input) {
+  SDDS_LAYOUT *out, *in;
+  int32_t i, inputBigEndian;
+
+  out = &SDDS_output->layout;
+  in = &SDDS_input->layout;
+  if (out->data_mode.mode != SDDS_BINARY || in->data_mode.mode != SDDS_BINARY ||
+      out->gzipFile || out->lzmaFile || out->data_mode.fixed_row_count ||
+      in->gzipFile || in->lzmaFile || in->popenUsed || !in->filename || !SDDS_input->pagecount_offset ||
+      out->data_mode.column_major != in->data_mode.column_major)
+    return 0;
+  inputBigEndian = SDDS_input->swapByteOrder ? !SDDS_IsBigEndianMachine() : SDDS_IsBigEndianMachine();
+  if (inputBigEndian != SDDS_CombineOutputIsBigEndian())
+    return 0;
+  if (out->n_arrays || in->n_arrays || out->n_columns != in->n_columns || out->n_parameters != in->n_parameters)
+    return 0;
+  for (i = 0; i < out->n_columns; i++)
+    if (out->column_definition[i].type == SDDS_STRING || out->column_definition[i].type != in->column_definition[i].type ||
+        strcmp(out->column_definition[i].name, in->column_definition[i].name) != 0)
+      return 0;
+  for (i = 0; i < out->n_parameters; i++) {
+    if (out->parameter_definition[i].type != in->parameter_definition[i].type ||
+        (out->parameter_definition[i].definition_mode & SDDS_WRITEONLY_DEFINITION) ||
+        strcmp(out->parameter_definition[i].name, in->parameter_definition[i].name) != 0)
+      return 0;
+    if (out->parameter_definition[i].fixed_value || in->parameter_definition[i].fixed_value) {
+      if (!out->parameter_definition[i].fixed_value || !in->parameter_definition[i].fixed_value ||
+          strcmp(out->parameter_definition[i].fixed_value, in->parameter_definition[i].fixed_value) != 0)
+        return 0;
+    }
+  }
+  return 1;
+}
+
+/**
+ * Walks the page headers of a raw binary data section accepted by SDDS_CombineIsRawCompatible.
+ *
+ * @param SDDS_input Pointer to the input SDDS_DATASET describing the data.
+ * @param data Raw data section (everything after the header).
+ * @param length Number of bytes in data.
+ *
+ * @return Returns the number of pages if the data consists of complete pages only, or -1 if it does
+ *         not (e.g., a truncated last page), in which case the file must be decoded.
+ */
+static int64_t SDDS_CombineCountRawPages(SDDS_DATASET *SDDS_input, char *data, int64_t length) {
+  SDDS_LAYOUT *layout;
+  int64_t position, rows, rowBytes, pages;
+  int32_t i, rows32, stringLength;
+
+  layout = &SDDS_input->layout;
+  for (i = 0, rowBytes = 0; i < layout->n_columns; i++)
+    rowBytes += SDDS_type_size[layout->column_definition[i].type - 1];
+  position = pages = 0;
+  while (position < length) {
+    if (length - position < (int64_t)sizeof(rows32))
+      return -1;
+    memcpy(&rows32, data + position, sizeof(rows32));
+    position += sizeof(rows32);
+    if (SDDS_input->swapByteOrder)
+      SDDS_SwapLong(&rows32);
+    if (rows32 == INT32_MIN) {
+      if (length - position < (int64_t)sizeof(rows))
+        return -1;
+      memcpy(&rows, data + position, sizeof(rows));
+      position += sizeof(rows);
+      if (SDDS_input->swapByteOrder)
+        SDDS_SwapLong64(&rows);
+    } else
+      rows = rows32;
+    if (rows < 0)
+      return -1;
+    for (i = 0; i < layout->n_parameters; i++) {
+      if (layout->parameter_definition[i].fixed_value)
+        continue;
+      if (layout->parameter_definition[i].type == SDDS_STRING) {
+        if (length - position < (int64_t)sizeof(stringLength))
+          return -1;
+        memcpy(&stringLength, data + position, sizeof(stringLength));
+        position += sizeof(stringLength);
+        if (SDDS_input->swapByteOrder)
+          SDDS_SwapLong(&stringLength);
+        if (stringLength < 0 || length - position < stringLength)
+          return -1;
+        position += stringLength;
+      } else {
+        if (length - position < SDDS_type_size[layout->parameter_definition[i].type - 1])
+          return -1;
+        position += SDDS_type_size[layout->parameter_definition[i].type - 1];
+      }
+    }
+    if (rowBytes && rows > (length - position) / rowBytes)
+      return -1;
+    position += rows * rowBytes;
+    pages++;
+  }
+  return pages;
+}
+
+/**
+ * Terminates a dataset on a worker thread.  Layouts are set up and torn down under the
+ * SDDS_CombineLayout lock (see SDDS_CombineReadInput).
+ */
+static int32_t SDDS_CombineTerminate(SDDS_DATASET *SDDS_dataset) {
+  int32_t status;
+
+#pragma omp critical(SDDS_CombineLayout)
+  status = SDDS_Terminate(SDDS_dataset);
+  return status;
+}
+
+/**
+ * Reads one input file on a worker thread.  The data section is loaded raw when pass-through is
+ * possible; otherwise every page is decoded into an in-memory copy.
+ *
+ * Parsing the header and defining the layout of each in-memory copy touch process-wide state (rpn
+ * memories and the layout cache), so these steps are serialized under the SDDS_CombineLayout lock.
+ * Reading and copying pages touch only this thread's datasets and the error stack, which has its
+ * own lock, and so run concurrently.
+ *
+ * @return Returns 1 on success; 0 on failure, with an error message recorded.
+ */
+static int32_t SDDS_CombineReadInput(SDDS_DATASET *SDDS_output, char *filename, uint32_t mode, SDDS_COMBINE_INPUT *input) {
+  SDDS_DATASET SDDS_input, *page;
+  int32_t status, rawCompatible;
+  char s[SDDS_MAXLINE];
+
+  rawCompatible = 0;
+#pragma omp critical(SDDS_CombineLayout)
+  {
+    if (!(status = SDDS_InitializeInput(&SDDS_input, filename))) {
+      snprintf(s, sizeof(s), "Unable to open file %s (SDDS_CombineFiles)", filename);
+      SDDS_SetError(s);
+    } else if (!SDDS_CombineCheckLayout(SDDS_output, &SDDS_input, filename)) {
+      SDDS_Terminate(&SDDS_input);
+      status = 0;
+    } else
+      rawCompatible = !(mode & SDDS_COMBINE_NO_PASSTHROUGH) && SDDS_CombineIsRawCompatible(SDDS_output, &SDDS_input);
+  }
+  if (!status)
+    return 0;
+
+  if (rawCompatible) {
+    input->length = SDDS_input.endOfFile_offset - SDDS_input.pagecount_offset[0];
+    if (input->length < 0 || !(input->data = malloc(input->length ? input->length : 1)) ||
+        fseek(SDDS_input.layout.fp, SDDS_input.pagecount_offset[0], SEEK_SET) != 0 ||
+        fread(input->data, 1, input->length, SDDS_input.layout.fp) != (size_t)input->length ||
+        (input->rawPages = SDDS_CombineCountRawPages(&SDDS_input, input->data, input->length)) < 0) {
+      /* fall back to decoding the file */
+      if (input->data)
+        free(input->data);
+      input->data = NULL;
+      input->length = 0;
+      rawCompatible = 0;
+      if (fseek(SDDS_input.layout.fp, SDDS_input.pagecount_offset[0], SEEK_SET) != 0) {
+        snprintf(s, sizeof(s), "Unable to rewind file %s (SDDS_CombineFiles)", filename);
+        SDDS_SetError(s);
+        SDDS_CombineTerminate(&SDDS_input);
+        return 0;
+      }
+    }
+  }
+
+  if (!rawCompatible) {
+    while ((status = SDDS_ReadPage(&SDDS_input)) > 0) {
+      if (input->pages == input->maxPages &&
+          !(input->page = SDDS_Realloc(input->page, sizeof(*input->page) * (input->maxPages += 16)))) {
+        SDDS_SetError("Memory allocation failure (SDDS_CombineFiles)");
+        SDDS_CombineTerminate(&SDDS_input);
+        return 0;
+      }
+      if ((page = calloc(1, sizeof(*page)))) {
+#pragma omp critical(SDDS_CombineLayout)
+        status = SDDS_InitializeCopy(page, &SDDS_input, NULL, "m");
+        if (!status) {
+          free(page);
+          page = NULL;
+        }
+      }
+      if (!page) {
+        SDDS_SetError("Unable to copy page (SDDS_CombineFiles)");
+        SDDS_CombineTerminate(&SDDS_input);
+        return 0;
+      }
+      input->page[input->pages++] = page;
+      if (!SDDS_CopyPage(page, &SDDS_input)) {
+        SDDS_SetError("Unable to copy page (SDDS_CombineFiles)");
+        SDDS_CombineTerminate(&SDDS_input);
+        return 0;
+      }
+    }
+    if (status == 0) {
+      snprintf(s, sizeof(s), "Unable to read page %" PRId32 " of file %s (SDDS_CombineFiles)", input->pages + 1, filename);
+      SDDS_SetError(s);
+      SDDS_CombineTerminate(&SDDS_input);
+      return 0;
+    }
+  }
+  if (!SDDS_CombineTerminate(&SDDS_input)) {
+    snprintf(s, sizeof(s), "Unable to close file %s (SDDS_CombineFiles)", filename);
+    SDDS_SetError(s);
+    return 0;
+  }
+  return 1;
+}
+
+/**
+ * Appends the pages of one input file to the output.  Called in input order.
+ *
+ * @return Returns the number of pages written, or -1 on failure with an error message recorded.
+ */
+static int64_t SDDS_CombineWriteInput(SDDS_DATASET *SDDS_output, SDDS_COMBINE_INPUT *input) {
+  int32_t i;
+
+  if (input->data) {
+    if (!SDDS_FlushBuffer(SDDS_output->layout.fp, &SDDS_output->fBuffer) ||
+        (input->length && fwrite(input->data, 1, input->length, SDDS_output->layout.fp) != (size_t)input->length)) {
+      SDDS_SetError("Unable to write pages (SDDS_CombineFiles)");
+      return -1;
+    }
+    SDDS_output->page_number += input->rawPages;
+    return input->rawPages;
+  }
+  for (i = 0; i < input->pages; i++) {
+    if (!SDDS_CopyPage(SDDS_output, input->page[i]) || !SDDS_WritePage(SDDS_output)) {
+      SDDS_SetError("Unable to write page (SDDS_CombineFiles)");
+      return -1;
+    }
+  }
+  return input->pages;
+}
+
+static void SDDS_CombineFreeInput(SDDS_COMBINE_INPUT *input) {
+  int32_t i;
+
+  if (input->data)
+    free(input->data);
+  for (i = 0; i < input->pages; i++) {
+    SDDS_CombineTerminate(input->page[i]);
+    free(input->page[i]);
+  }
+  if (input->page)
+    free(input->page);
+  memset(input, 0, sizeof(*input));
+}
+
+/**
+ * Appends all pages of a list of SDDS files to an output dataset.
+ *
+ * The output must have been set up for writing (e.g., with SDDS_InitializeCopy from the first input,
+ * or SDDS_InitializeOutput plus definitions); its layout is written here if that has not been done yet.
+ * Every column, parameter and array of the output must exist in each input with a compatible type;
+ * inputs may define additional elements, which are ignored.
+ *
+ * Input files are opened and decoded concurrently by up to @p threads OpenMP threads, and their pages
+ * are appended to the output in the order of @p input.  When an uncompressed binary input has exactly
+ * the output's layout, byte order and data ordering, its data section is copied to the output without
+ * being decoded, unless SDDS_COMBINE_NO_PASSTHROUGH is given.  Each thread holds the data of the file
+ * it is working on in memory until that file has been written.
+ *
+ * @param SDDS_output Pointer to the output SDDS_DATASET, open for writing.
+ * @param input Array of input filenames.
+ * @param inputs Number of input filenames.
+ * @param threads Number of reader threads.  Values less than 1 are treated as 1.
+ * @param mode Zero or SDDS_COMBINE_NO_PASSTHROUGH.
+ *
+ * @return Returns the number of pages written; -1 on failure, with an error message recorded.
+ */
+int64_t SDDS_CombineFiles(SDDS_DATASET *SDDS_output, char **input, int32_t inputs, int32_t threads, uint32_t mode) {
+  int64_t pages;
+  int32_t i, failed;
+
+  if (!SDDS_CheckDataset(SDDS_output, "SDDS_CombineFiles"))
+    return -1;
+  if (!input || inputs < 0) {
+    SDDS_SetError("Invalid input file list (SDDS_CombineFiles)");
+    return -1;
+  }
+  if (SDDS_output->mode != SDDS_WRITEMODE) {
+    SDDS_SetError("Output dataset is not open for writing (SDDS_CombineFiles)");
+    return -1;
+  }
+  if (!SDDS_output->layout.layout_written && !SDDS_WriteLayout(SDDS_output))
+    return -1;
+  if (threads < 1)
+    threads = 1;
+  pages = 0;
+  failed = 0;
+
+#pragma omp parallel for ordered schedule(dynamic, 1) num_threads(threads)
+  for (i = 0; i < inputs; i++) {
+    SDDS_COMBINE_INPUT item;
+    int32_t ok;
+    int64_t written;
+
+    memset(&item, 0, sizeof(item));
+    /* once something has failed, the remaining files are skipped */
+#pragma omp critical(SDDS_CombineStatus)
+    ok = !failed;
+    if (ok)
+      ok = SDDS_CombineReadInput(SDDS_output, input[i], mode, &item);
+#pragma omp ordered
+    {
+      if (ok && (written = SDDS_CombineWriteInput(SDDS_output, &item)) >= 0)
+        pages += written;
+      else {
+#pragma omp critical(SDDS_CombineStatus)
+        failed = 1;
+      }
+    }
+    SDDS_CombineFreeInput(&item);
+  }
+
+  if (failed)
+    return -1;
+  return pages;
+}
@@ -763,6 +763,383 @@ int32_t SDDS_RestoreLayout(SDDS_DATASET *SDDS_dataset) {
   return (1);
 }
 
+/* In-process cache of parsed layouts, keyed by the raw header bytes.  Archive directories
+ * often hold many files with byte-identical headers; for those, SDDS_InitializeInput clones
+ * a cached layout instead of re-parsing the namelists.  The cache is shared by all threads, so
+ * every access is made in the SDDS_LayoutCache critical section. */
+typedef struct {
+  char *header;
+  int64_t length;
+  uint32_t hash;
+  uint32_t lastUse;
+  SDDS_DATASET *layout;
+} SDDS_CACHED_LAYOUT;
+
+#define SDDS_LAYOUT_CACHE_DEFAULT_SIZE 8
+#define SDDS_LAYOUT_CACHE_MAX_HEADER 16777216
+
+static SDDS_CACHED_LAYOUT *layoutCache = NULL;
+static int32_t layoutCacheSize = SDDS_LAYOUT_CACHE_DEFAULT_SIZE, layoutCacheEntries = 0;
+static uint32_t layoutCacheClock = 0;
+
+static uint32_t SDDS_HashHeader(const char *header, int64_t length) {
+  /* FNV-1a */
+  uint32_t hash = 2166136261U;
+  int64_t i;
+  for (i = 0; i < length; i++) {
+    hash ^= (unsigned char)header[i];
+    hash *= 16777619U;
+  }
+  return hash;
+}
+
+static void SDDS_FreeCachedLayout(SDDS_CACHED_LAYOUT *entry) {
+  if (entry->layout) {
+    SDDS_Terminate(entry->layout);
+    free(entry->layout);
+  }
+  if (entry->header)
+    free(entry->header);
+  memset(entry, 0, sizeof(*entry));
+}
+
+static int32_t SDDS_DuplicateStrings(char **string[], int32_t n) {
+  int32_t i;
+  for (i = 0; i < n; i++)
+    if (*string[i] && !SDDS_CopyString(string[i], *string[i]))
+      return 0;
+  return 1;
+}
+
+static SORTED_INDEX **SDDS_DuplicateSortedIndex(SORTED_INDEX **source, int32_t n, char *firstName, size_t stride) {
+  SORTED_INDEX **target;
+  int32_t i;
+  if (!(target = (SORTED_INDEX **)SDDS_Malloc(sizeof(*target) * n)))
+    return NULL;
+  for (i = 0; i < n; i++) {
+    if (!(target[i] = (SORTED_INDEX *)SDDS_Malloc(sizeof(**target))))
+      return NULL;
+    target[i]->index = source[i]->index;
+    /* the index shares the name string with the definition, as in SDDS_DefineColumn et al. */
+    target[i]->name = *(char **)(firstName + stride * source[i]->index);
+  }
+  return target;
+}
+
+/**
+ * Copies the column, parameter, array and associate definitions of SDDS_source into the empty layout
+ * of SDDS_target, together with the header-level settings (description, data mode, byte order) that
+ * SDDS_ReadLayout would set.  Definitions and sorted indexes are duplicated directly rather than
+ * re-defined one at a time; rpn memory numbers are process-wide and are shared.
+ *
+ * @param SDDS_target Pointer to an SDDS_DATASET with an empty layout.
+ * @param SDDS_source Pointer to the SDDS_DATASET whose layout is copied.
+ *
+ * @return Returns 1 on success; 0 on failure, with an error message recorded.
+ */
+static int32_t SDDS_CopyLayoutDefinitions(SDDS_DATASET *SDDS_target, SDDS_DATASET *SDDS_source) {
+  SDDS_LAYOUT *source, *target;
+  COLUMN_DEFINITION *coldef;
+  PARAMETER_DEFINITION *pardef;
+  ARRAY_DEFINITION *arraydef;
+  ASSOCIATE_DEFINITION *assocdef;
+  char **string[6];
+  int32_t i;
+
+  source = &SDDS_source->layout;
+  target = &SDDS_target->layout;
+  if (source->n_columns) {
+    if (!(target->column_definition = (COLUMN_DEFINITION *)SDDS_Malloc(sizeof(*coldef) * source->n_columns))) {
+      SDDS_SetError("Memory allocation failure (SDDS_CopyLayoutDefinitions)");
+      return (0);
+    }
+    memcpy((char *)target->column_definition, (char *)source->column_definition, sizeof(*coldef) * source->n_columns);
+    target->n_columns = source->n_columns;
+    for (i = 0; i < source->n_columns; i++) {
+      coldef = target->column_definition + i;
+      string[0] = &coldef->name;
+      string[1] = &coldef->symbol;
+      string[2] = &coldef->units;
+      string[3] = &coldef->description;
+      string[4] = &coldef->format_string;
+      if (!SDDS_DuplicateStrings(string, 5)) {
+        SDDS_SetError("Memory allocation failure (SDDS_CopyLayoutDefinitions)");
+        return (0);
+      }
+    }
+    if (!(target->column_index = SDDS_DuplicateSortedIndex(source->column_index, source->n_columns, (char *)&target->column_definition->name, sizeof(*coldef)))) {
+      SDDS_SetError("Memory allocation failure (SDDS_CopyLayoutDefinitions)");
+      return (0);
+    }
+  }
+  if (source->n_parameters) {
+    if (!(target->parameter_definition = (PARAMETER_DEFINITION *)SDDS_Malloc(sizeof(*pardef) * source->n_parameters))) {
+      SDDS_SetError("Memory allocation failure (SDDS_CopyLayoutDefinitions)");
+      return (0);
+    }
+    memcpy((char *)target->parameter_definition, (char *)source->parameter_definition, sizeof(*pardef) * source->n_parameters);
+    target->n_parameters = source->n_parameters;
+    for (i = 0; i < source->n_parameters; i++) {
+      pardef = target->parameter_definition + i;
+      string[0] = &pardef->name;
+      string[1] = &pardef->symbol;
+      string[2] = &pardef->units;
+      string[3] = &pardef->description;
+      string[4] = &pardef->format_string;
+      string[5] = &pardef->fixed_value;
+      if (!SDDS_DuplicateStrings(string, 6)) {
+        SDDS_SetError("Memory allocation failure (SDDS_CopyLayoutDefinitions)");
+        return (0);
+      }
+    }
+    if (!(target->parameter_index = SDDS_DuplicateSortedIndex(source->parameter_index, source->n_parameters, (char *)&target->parameter_definition->name, sizeof(*pardef)))) {
+      SDDS_SetError("Memory allocation failure (SDDS_CopyLayoutDefinitions)");
+      return (0);
+    }
+  }
+  if (source->n_arrays) {
+    if (!(target->array_definition = (ARRAY_DEFINITION *)SDDS_Malloc(sizeof(*arraydef) * source->n_arrays))) {
+      SDDS_SetError("Memory allocation failure (SDDS_CopyLayoutDefinitions)");
+      return (0);
+    }
+    memcpy((char *)target->array_definition, (char *)source->array_definition, sizeof(*arraydef) * source->n_arrays);
+    target->n_arrays = source->n_arrays;
+    for (i = 0; i < source->n_arrays; i++) {
+      arraydef = target->array_definition + i;
+      string[0] = &arraydef->name;
+      string[1] = &arraydef->symbol;
+      string[2] = &arraydef->units;
+      string[3] = &arraydef->description;
+      string[4] = &arraydef->format_string;
+      string[5] = &arraydef->group_name;
+      if (!SDDS_DuplicateStrings(string, 6)) {
+        SDDS_SetError("Memory allocation failure (SDDS_CopyLayoutDefinitions)");
+        return (0);
+      }
+    }
+    if (!(target->array_index = SDDS_DuplicateSortedIndex(source->array_index, source->n_arrays, (char *)&target->array_definition->name, sizeof(*arraydef)))) {
+      SDDS_SetError("Memory allocation failure (SDDS_CopyLayoutDefinitions)");
+      return (0);
+    }
+  }
+  if (source->n_associates) {
+    if (!(target->associate_definition = (ASSOCIATE_DEFINITION *)SDDS_Malloc(sizeof(*assocdef) * source->n_associates))) {
+      SDDS_SetError("Memory allocation failure (SDDS_CopyLayoutDefinitions)");
+      return (0);
+    }
+    memcpy((char *)target->associate_definition, (char *)source->associate_definition, sizeof(*assocdef) * source->n_associates);
+    target->n_associates = source->n_associates;
+    for (i = 0; i < source->n_associates; i++) {
+      assocdef = target->associate_definition + i;
+      string[0] = &assocdef->name;
+      string[1] = &assocdef->filename;
+      string[2] = &assocdef->path;
+      string[3] = &assocdef->description;
+      string[4] = &assocdef->contents;
+      if (!SDDS_DuplicateStrings(string, 5)) {
+        SDDS_SetError("Memory allocation failure (SDDS_CopyLayoutDefinitions)");
+        return (0);
+      }
+    }
+  }
+  if ((source->description && !SDDS_CopyString(&target->description, source->description)) ||
+      (source->contents && !SDDS_CopyString(&target->contents, source->contents))) {
+    SDDS_SetError("Memory allocation failure (SDDS_CopyLayoutDefinitions)");
+    return (0);
+  }
+  target->version = source->version;
+  target->data_mode = source->data_mode;
+  target->commentFlags = source->commentFlags;
+  target->byteOrderDeclared = source->byteOrderDeclared;
+  target->data_command_seen = source->data_command_seen;
+  SDDS_target->swapByteOrder = SDDS_source->swapByteOrder;
+  SDDS_target->autoRecover = SDDS_source->autoRecover;
+  return 1;
+}
+
+/* Body of SDDS_SetLayoutCacheSize; the caller holds the SDDS_LayoutCache lock. */
+static int32_t SDDS_ResizeLayoutCache(int32_t entries) {
+  int32_t i, previous;
+
+  previous = layoutCacheSize;
+  if (entries < 0)
+    entries = 0;
+  for (i = entries; i < layoutCacheEntries; i++)
+    SDDS_FreeCachedLayout(layoutCache + i);
+  if (layoutCacheEntries > entries)
+    layoutCacheEntries = entries;
+  if (layoutCache && entries != previous) {
+    if (entries == 0) {
+      free(layoutCache);
+      layoutCache = NULL;
+    } else {
+      if (!(layoutCache = SDDS_Realloc(layoutCache, sizeof(*layoutCache) * entries))) {
+        layoutCacheEntries = layoutCacheSize = 0;
+        return previous;
+      }
+      if (entries > previous)
+        memset(layoutCache + previous, 0, sizeof(*layoutCache) * (entries - previous));
+    }
+  }
+  layoutCacheSize = entries;
+  return previous;
+}
+
+/**
+ * Sets the number of parsed layouts kept by the in-process layout cache used by SDDS_InitializeInput.
+ * Cached layouts are matched against the raw header bytes of each plain (uncompressed, seekable)
+ * input file, so a hit is only possible for byte-identical headers.
+ *
+ * @param entries Maximum number of layouts to keep.  Zero disables the cache and frees all entries.
+ *
+ * @return Returns the previous cache size.
+ */
+int32_t SDDS_SetLayoutCacheSize(int32_t entries) {
+  int32_t previous;
+
+#pragma omp critical(SDDS_LayoutCache)
+  previous = SDDS_ResizeLayoutCache(entries);
+  return previous;
+}
+
+/* Body of SDDS_LookupCachedLayout; the caller holds the SDDS_LayoutCache lock. */
+static int32_t SDDS_LookupCachedLayoutLocked(SDDS_DATASET *SDDS_dataset) {
+  FILE *fp;
+  char *buffer;
+  int64_t maxLength, length;
+  int32_t i;
+  SDDS_CACHED_LAYOUT *entry;
+
+  if (!layoutCacheEntries || !(fp = SDDS_dataset->layout.fp))
+    return 0;
+  for (i = maxLength = 0; i < layoutCacheEntries; i++)
+    if (layoutCache[i].length > maxLength)
+      maxLength = layoutCache[i].length;
+  if (!(buffer = malloc(maxLength)))
+    return 0;
+  length = fread(buffer, 1, maxLength, fp);
+  for (i = 0; i < layoutCacheEntries; i++) {
+    entry = layoutCache + i;
+    if (entry->length > length || SDDS_HashHeader(buffer, entry->length) != entry->hash || memcmp(buffer, entry->header, entry->length) != 0)
+      continue;
+    free(buffer);
+    if (fseek(fp, entry->length, SEEK_SET) != 0 || !SDDS_CopyLayoutDefinitions(SDDS_dataset, entry->layout)) {
+      SDDS_SetError("Unable to clone cached layout (SDDS_LookupCachedLayout)");
+      return -1;
+    }
+    entry->lastUse = ++layoutCacheClock;
+    return 1;
+  }
+  free(buffer);
+  if (fseek(fp, 0, SEEK_SET) != 0) {
+    SDDS_SetError("Unable to rewind file after layout cache miss (SDDS_LookupCachedLayout)");
+    return -1;
+  }
+  return 0;
+}
+
+/**
+ * Attempts to set up the layout of an input dataset from the layout cache.
+ *
+ * Must be called with the file positioned at its start.  On a hit, the cached layout is cloned into
+ * SDDS_dataset and the file is positioned at the end of the header.  On a miss the file is
+ * rewound so that the header can be read normally.  Files that cannot be rewound, such as pipes,
+ * are not looked up, and are left untouched.
+ *
+ * @param SDDS_dataset Pointer to the SDDS_DATASET being initialized for input.
+ *
+ * @return Returns 1 if the layout was taken from the cache, 0 if it was not, or -1 on error.
+ */
+int32_t SDDS_LookupCachedLayout(SDDS_DATASET *SDDS_dataset) {
+  int32_t cached;
+
+  if (!SDDS_dataset->layout.fp || ftell(SDDS_dataset->layout.fp) != 0)
+    return 0;
+#pragma omp critical(SDDS_LayoutCache)
+  cached = SDDS_LookupCachedLayoutLocked(SDDS_dataset);
+  return cached;
+}
+
+/* Body of SDDS_CacheLayout; the caller holds the SDDS_LayoutCache lock. */
+static int32_t SDDS_CacheLayoutLocked(SDDS_DATASET *SDDS_dataset) {
+  FILE *fp;
+  int64_t length;
+  char *header;
+  int32_t i;
+  SDDS_CACHED_LAYOUT *entry;
+
+  if (!layoutCacheSize || !(fp = SDDS_dataset->layout.fp))
+    return 1;
+  if ((length = ftell(fp)) <= 0 || length > SDDS_LAYOUT_CACHE_MAX_HEADER)
+    return 1;
+  if (!(header = malloc(length + 1)))
+    return 1;
+  if (fseek(fp, 0, SEEK_SET) != 0 || fread(header, 1, length, fp) != (size_t)length) {
+    free(header);
+    if (fseek(fp, length, SEEK_SET) != 0) {
+      SDDS_SetError("Unable to reposition file after reading header (SDDS_CacheLayout)");
+      return 0;
+    }
+    return 1;
+  }
+  header[length] = 0;
+  if (strstr(header, "&include")) {
+    free(header);
+    return 1;
+  }
+  if (!layoutCache && !(layoutCache = calloc(layoutCacheSize, sizeof(*layoutCache)))) {
+    free(header);
+    return 1;
+  }
+  if (layoutCacheEntries < layoutCacheSize)
+    entry = layoutCache + layoutCacheEntries++;
+  else {
+    /* replace the least recently used entry */
+    entry = layoutCache;
+    for (i = 1; i < layoutCacheEntries; i++)
+      if (layoutCache[i].lastUse < entry->lastUse)
+        entry = layoutCache + i;
+    SDDS_FreeCachedLayout(entry);
+  }
+  entry->header = header;
+  entry->length = length;
+  entry->hash = SDDS_HashHeader(header, length);
+  entry->lastUse = ++layoutCacheClock;
+  if (!(entry->layout = calloc(1, sizeof(*entry->layout))) || !SDDS_CopyLayoutDefinitions(entry->layout, SDDS_dataset) ||
+      !SDDS_SaveLayout(entry->layout)) {
+    /* not fatal for the caller--the layout simply isn't cached */
+    SDDS_ClearErrors();
+    SDDS_FreeCachedLayout(entry);
+    if (entry != layoutCache + --layoutCacheEntries) {
+      *entry = layoutCache[layoutCacheEntries];
+      memset(layoutCache + layoutCacheEntries, 0, sizeof(*entry));
+    }
+  }
+  return 1;
+}
+
+/**
+ * Adds the layout just read by SDDS_ReadLayout to the layout cache.
+ *
+ * The raw header bytes (from the start of the file up to the current position) are re-read to form
+ * the cache key, after which the file is left where it was.  Headers that use &include are not cached,
+ * since their meaning depends on other files, and neither are the headers of files that cannot be
+ * rewound.
+ *
+ * @param SDDS_dataset Pointer to the SDDS_DATASET whose layout was just read.
+ *
+ * @return Returns 1 on success (including when the layout is not cacheable); 0 on failure, with an error message recorded.
+ */
+int32_t SDDS_CacheLayout(SDDS_DATASET *SDDS_dataset) {
+  int32_t status;
+
+  if (!SDDS_dataset->layout.fp || ftell(SDDS_dataset->layout.fp) <= 0)
+    return 1;
+#pragma omp critical(SDDS_LayoutCache)
+  status = SDDS_CacheLayoutLocked(SDDS_dataset);
+  return status;
+}
+
 /**
  * Copies a row from the source SDDS_DATASET to the target SDDS_DATASET.
  * Only columns that exist in both datasets are copied.
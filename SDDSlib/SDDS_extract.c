@@ -3868,6 +3868,7 @@ int32_t SDDS_DeleteColumn(SDDS_DATASET *SDDS_dataset, char *column_name) {
   }
   if ((SDDS_dataset->layout.n_columns -= 1) == 0)
     SDDS_dataset->n_rows = 0;
+  SDDS_InvalidateNameHash(SDDS_dataset->layout.column_hash);
   return (1);
 }
 
@@ -3990,6 +3991,7 @@ int32_t SDDS_DeleteParameter(SDDS_DATASET *SDDS_dataset, char *parameter_name) {
     }
   }
   SDDS_dataset->layout.n_parameters -= 1;
+  SDDS_InvalidateNameHash(SDDS_dataset->layout.parameter_hash);
   return (1);
 }
 
@@ -0,0 +1,619 @@
+/**
+ * @file SDDS_follow.c
+ * @brief Incremental reading of binary SDDS files that are still being written.
+ *
+ * A follower keeps the file open and decodes only the bytes appended since the previous call: rows
+ * added to the current page, and new pages.  The bytes are read and decoded a few megabytes at a time,
+ * and decoded rows go into a ring buffer holding the newest rows, so memory is bounded however large
+ * the file is and however long it is followed.  SDDS_FollowWait sleeps until the file changes, using
+ * inotify on Linux and polling elsewhere, so a monitoring client costs CPU in proportion to the data
+ * written rather than to how often it looks.
+ *
+ * @copyright
+ *   - (c) 2002 The University of Chicago, as Operator of Argonne National Laboratory.
+ *   - (c) 2002 The Regents of the University of California, as Operator of Los Alamos National Laboratory.
+ *
+ * @license
+ * This file is distributed under the terms of the Software License Agreement
+ * found in the file LICENSE included with this distribution.
+ *
+ * @author M. Borland, C. Saunders, R. Soliday, H. Shang
+ */
+
+#include "mdb.h"
+#include "SDDS.h"
+#include "SDDS_internal.h"
+#if defined(__linux__)
+#  include <sys/inotify.h>
+#  include <poll.h>
+#  include <unistd.h>
+#endif
+
+#define SDDS_FOLLOW_POLL_INTERVAL 100000
+/* bytes read from the file at a time */
+#define SDDS_FOLLOW_CHUNK_SIZE 4194304
+
+static void SDDS_FollowSwapValue(void *data, int32_t type) {
+  switch (type) {
+  case SDDS_SHORT:
+    SDDS_SwapShort((short *)data);
+    break;
+  case SDDS_USHORT:
+    SDDS_SwapUShort((unsigned short *)data);
+    break;
+  case SDDS_LONG:
+    SDDS_SwapLong((int32_t *)data);
+    break;
+  case SDDS_ULONG:
+    SDDS_SwapULong((uint32_t *)data);
+    break;
+  case SDDS_LONG64:
+    SDDS_SwapLong64((int64_t *)data);
+    break;
+  case SDDS_ULONG64:
+    SDDS_SwapULong64((uint64_t *)data);
+    break;
+  case SDDS_FLOAT:
+    SDDS_SwapFloat((float *)data);
+    break;
+  case SDDS_DOUBLE:
+    SDDS_SwapDouble((double *)data);
+    break;
+  case SDDS_LONGDOUBLE:
+    SDDS_SwapLongDouble((long double *)data);
+    break;
+  default:
+    break;
+  }
+}
+
+/**
+ * Takes a binary string (length followed by characters) from the follower's buffer.
+ *
+ * @param follow Pointer to the SDDS_FOLLOW structure.
+ * @param position Position in the buffer; advanced past the string on success.
+ * @param string If not NULL, receives a newly allocated copy of the string.
+ *
+ * @return Returns 1 on success, 0 if the string is not complete yet, or -1 if the data is invalid.
+ */
+static int32_t SDDS_FollowTakeString(SDDS_FOLLOW *follow, int64_t *position, char **string) {
+  int32_t length;
+
+  if (follow->bufferLength - *position < (int64_t)sizeof(length))
+    return 0;
+  memcpy(&length, follow->buffer + *position, sizeof(length));
+  if (follow->dataset.swapByteOrder)
+    SDDS_SwapLong(&length);
+  if (length < 0)
+    return -1;
+  if (follow->bufferLength - *position - (int64_t)sizeof(length) < length)
+    return 0;
+  if (string) {
+    if (!(*string = malloc(length + 1)))
+      return -1;
+    memcpy(*string, follow->buffer + *position + sizeof(length), length);
+    (*string)[length] = 0;
+  }
+  *position += sizeof(length) + length;
+  return 1;
+}
+
+/**
+ * Scans the start of a page: row count, parameters and arrays.  Array data is skipped.
+ *
+ * @param follow Pointer to the SDDS_FOLLOW structure.
+ * @param position Position of the page in the buffer; advanced past the page header on success.
+ * @param rows Receives the row count of the page.
+ * @param store If nonzero, parameter values are stored in the follower's dataset.
+ *
+ * @return Returns 1 on success, 0 if the header is not complete yet, or -1 if the data is invalid.
+ */
+static int32_t SDDS_FollowScanPageHeader(SDDS_FOLLOW *follow, int64_t *position, int64_t *rows, int32_t store) {
+  SDDS_DATASET *SDDS_dataset;
+  SDDS_LAYOUT *layout;
+  int64_t p, elements, size;
+  int32_t i, j, rows32, dimension, status, type;
+  char buffer[SDDS_MAXLINE];
+
+  SDDS_dataset = &follow->dataset;
+  layout = &SDDS_dataset->layout;
+  p = *position;
+  if (follow->bufferLength - p < (int64_t)sizeof(rows32))
+    return 0;
+  memcpy(&rows32, follow->buffer + p, sizeof(rows32));
+  p += sizeof(rows32);
+  if (SDDS_dataset->swapByteOrder)
+    SDDS_SwapLong(&rows32);
+  if (rows32 == INT32_MIN) {
+    if (follow->bufferLength - p < (int64_t)sizeof(*rows))
+      return 0;
+    memcpy(rows, follow->buffer + p, sizeof(*rows));
+    p += sizeof(*rows);
+    if (SDDS_dataset->swapByteOrder)
+      SDDS_SwapLong64(rows);
+  } else
+    *rows = rows32;
+  if (*rows < 0)
+    return -1;
+
+  for (i = 0; i < layout->n_parameters; i++) {
+    if (layout->parameter_definition[i].definition_mode & SDDS_WRITEONLY_DEFINITION)
+      continue;
+    type = layout->parameter_definition[i].type;
+    if (layout->parameter_definition[i].fixed_value) {
+      if (store) {
+        strcpy(buffer, layout->parameter_definition[i].fixed_value);
+        if (!SDDS_ScanData(buffer, type, 0, SDDS_dataset->parameter[i], 0, 1))
+          return -1;
+      }
+    } else if (type == SDDS_STRING) {
+      if (store && *(char **)SDDS_dataset->parameter[i]) {
+        free(*(char **)SDDS_dataset->parameter[i]);
+        *(char **)SDDS_dataset->parameter[i] = NULL;
+      }
+      if ((status = SDDS_FollowTakeString(follow, &p, store ? (char **)SDDS_dataset->parameter[i] : NULL)) != 1)
+        return status;
+    } else {
+      size = SDDS_type_size[type - 1];
+      if (follow->bufferLength - p < size)
+        return 0;
+      if (store) {
+        memcpy(SDDS_dataset->parameter[i], follow->buffer + p, size);
+        if (SDDS_dataset->swapByteOrder)
+          SDDS_FollowSwapValue(SDDS_dataset->parameter[i], type);
+      }
+      p += size;
+    }
+  }
+
+  for (i = 0; i < layout->n_arrays; i++) {
+    elements = 1;
+    for (j = 0; j < layout->array_definition[i].dimensions; j++) {
+      if (follow->bufferLength - p < (int64_t)sizeof(dimension))
+        return 0;
+      memcpy(&dimension, follow->buffer + p, sizeof(dimension));
+      p += sizeof(dimension);
+      if (SDDS_dataset->swapByteOrder)
+        SDDS_SwapLong(&dimension);
+      if (dimension < 0)
+        return -1;
+      elements *= dimension;
+    }
+    if (layout->array_definition[i].type == SDDS_STRING) {
+      for (j = 0; j < elements; j++)
+        if ((status = SDDS_FollowTakeString(follow, &p, NULL)) != 1)
+          return status;
+    } else {
+      size = elements * SDDS_type_size[layout->array_definition[i].type - 1];
+      if (follow->bufferLength - p < size)
+        return 0;
+      p += size;
+    }
+  }
+  *position = p;
+  return 1;
+}
+
+/**
+ * Scans one row of the current page.
+ *
+ * @param follow Pointer to the SDDS_FOLLOW structure.
+ * @param position Position of the row in the buffer; advanced past the row on success.
+ * @param store If nonzero, the row is added to the ring buffer.
+ *
+ * @return Returns 1 on success, 0 if the row is not complete yet, or -1 if the data is invalid.
+ */
+static int32_t SDDS_FollowScanRow(SDDS_FOLLOW *follow, int64_t *position, int32_t store) {
+  SDDS_LAYOUT *layout;
+  int64_t p, slot, size;
+  int32_t i, type, status;
+  char **string;
+
+  layout = &follow->dataset.layout;
+  slot = 0;
+  if (store) {
+    if (follow->ringRows < follow->capacity)
+      slot = (follow->ringStart + follow->ringRows++) % follow->capacity;
+    else {
+      /* overwrite the oldest row */
+      slot = follow->ringStart;
+      follow->ringStart = (follow->ringStart + 1) % follow->capacity;
+    }
+  }
+  p = *position;
+  for (i = 0; i < layout->n_columns; i++) {
+    type = layout->column_definition[i].type;
+    if (type == SDDS_STRING) {
+      string = NULL;
+      if (store) {
+        string = (char **)follow->ring[i] + slot;
+        if (*string)
+          free(*string);
+        *string = NULL;
+      }
+      if ((status = SDDS_FollowTakeString(follow, &p, string)) != 1)
+        return status;
+    } else {
+      size = SDDS_type_size[type - 1];
+      if (follow->bufferLength - p < size)
+        return 0;
+      if (store) {
+        memcpy((char *)follow->ring[i] + slot * size, follow->buffer + p, size);
+        if (follow->dataset.swapByteOrder)
+          SDDS_FollowSwapValue((char *)follow->ring[i] + slot * size, type);
+      }
+      p += size;
+    }
+  }
+  *position = p;
+  return 1;
+}
+
+/**
+ * Re-reads the row count of the current page, which the writer updates in place as rows are added.
+ */
+static int32_t SDDS_FollowReadRowCount(SDDS_FOLLOW *follow, int64_t *rows) {
+  FILE *fp;
+  int32_t rows32;
+
+  fp = follow->dataset.layout.fp;
+  if (fseek(fp, follow->rowcountOffset, SEEK_SET) != 0 || fread(&rows32, sizeof(rows32), 1, fp) != 1)
+    return 0;
+  if (follow->dataset.swapByteOrder)
+    SDDS_SwapLong(&rows32);
+  if (rows32 == INT32_MIN) {
+    if (fread(rows, sizeof(*rows), 1, fp) != 1)
+      return 0;
+    if (follow->dataset.swapByteOrder)
+      SDDS_SwapLong64(rows);
+  } else
+    *rows = rows32;
+  return 1;
+}
+
+/**
+ * Opens a binary SDDS file for following as it grows.
+ *
+ * The file must be uncompressed, binary and row-major.  Rows are decoded into a ring buffer that keeps
+ * the newest @p capacity rows; the parameters of the newest page are available through
+ * follow->dataset with the usual SDDS_GetParameter routines.  Nothing is read until
+ * SDDS_FollowRead or SDDS_FollowWait is called.
+ *
+ * @param follow Pointer to the SDDS_FOLLOW structure to initialize.
+ * @param filename Name of the file to follow.
+ * @param capacity Number of rows kept in the ring buffer.
+ *
+ * @return Returns 1 on success; 0 on failure, with an error message recorded.
+ */
+int32_t SDDS_FollowInitialize(SDDS_FOLLOW *follow, char *filename, int64_t capacity) {
+  SDDS_LAYOUT *layout;
+  int32_t i;
+
+  memset(follow, 0, sizeof(*follow));
+  follow->notifyFd = follow->watchFd = -1;
+  follow->pollInterval = SDDS_FOLLOW_POLL_INTERVAL;
+  if (!filename || capacity < 1) {
+    SDDS_SetError("Invalid filename or ring buffer capacity (SDDS_FollowInitialize)");
+    return 0;
+  }
+  if (!SDDS_InitializeInput(&follow->dataset, filename))
+    return 0;
+  layout = &follow->dataset.layout;
+  if (layout->data_mode.mode != SDDS_BINARY || layout->data_mode.column_major ||
+      layout->gzipFile || layout->lzmaFile || layout->popenUsed || !follow->dataset.pagecount_offset) {
+    SDDS_SetError("Only uncompressed, row-major binary files can be followed (SDDS_FollowInitialize)");
+    SDDS_Terminate(&follow->dataset);
+    return 0;
+  }
+  /* allocates the parameter storage */
+  if (!SDDS_StartPage(&follow->dataset, 0)) {
+    SDDS_SetError("Unable to start page (SDDS_FollowInitialize)");
+    SDDS_Terminate(&follow->dataset);
+    return 0;
+  }
+  follow->capacity = capacity;
+  if (layout->n_columns && !(follow->ring = calloc(layout->n_columns, sizeof(*follow->ring)))) {
+    SDDS_SetError("Memory allocation failure (SDDS_FollowInitialize)");
+    SDDS_FollowTerminate(follow);
+    return 0;
+  }
+  for (i = 0; i < layout->n_columns; i++)
+    if (!(follow->ring[i] = calloc(capacity, SDDS_type_size[layout->column_definition[i].type - 1]))) {
+      SDDS_SetError("Memory allocation failure (SDDS_FollowInitialize)");
+      SDDS_FollowTerminate(follow);
+      return 0;
+    }
+  follow->offset = follow->dataset.pagecount_offset[0];
+#if defined(__linux__)
+  if ((follow->notifyFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC)) >= 0 &&
+      (follow->watchFd = inotify_add_watch(follow->notifyFd, filename, IN_MODIFY | IN_ATTRIB | IN_CLOSE_WRITE)) < 0) {
+    /* fall back to polling */
+    close(follow->notifyFd);
+    follow->notifyFd = -1;
+  }
+#endif
+  return 1;
+}
+
+/**
+ * Decodes the complete page headers and rows at the start of the follower's buffer and drops them
+ * from the buffer.
+ *
+ * @param follow Pointer to the SDDS_FOLLOW structure.
+ * @param newRows Incremented by the number of rows decoded.
+ *
+ * @return Returns 1 if decoding can continue once more data is read, 0 if it must wait for the next
+ *         call because the buffer may start a new page, or -1 if the data is invalid.
+ */
+static int32_t SDDS_FollowDecode(SDDS_FOLLOW *follow, int64_t *newRows) {
+  int64_t position, start, rows;
+  int32_t status, result;
+
+  position = 0;
+  status = result = 1;
+  while (status > 0) {
+    if (!follow->inPage) {
+      if (position == follow->bufferLength)
+        break;
+      start = position;
+      if ((status = SDDS_FollowScanPageHeader(follow, &position, &rows, 0)) <= 0)
+        break;
+      position = start;
+      if ((status = SDDS_FollowScanPageHeader(follow, &position, &rows, 1)) <= 0)
+        break;
+      follow->rowcountOffset = follow->offset + start;
+      follow->pageRows = rows;
+      follow->pageRowsRead = 0;
+      follow->inPage = 1;
+      follow->boundarySeen = 0;
+      follow->dataset.page_number = ++follow->page;
+    } else if (follow->pageRowsRead < follow->pageRows) {
+      start = position;
+      if ((status = SDDS_FollowScanRow(follow, &position, 0)) <= 0)
+        break;
+      position = start;
+      if ((status = SDDS_FollowScanRow(follow, &position, 1)) <= 0)
+        break;
+      follow->pageRowsRead++;
+      (*newRows)++;
+    } else {
+      if (position == follow->bufferLength)
+        break;
+      if (!follow->boundarySeen) {
+        follow->boundarySeen = 1;
+        result = 0;
+        break;
+      }
+      follow->inPage = 0;
+    }
+  }
+  if (status < 0)
+    return -1;
+
+  if (position) {
+    memmove(follow->buffer, follow->buffer + position, follow->bufferLength - position);
+    follow->bufferLength -= position;
+    follow->offset += position;
+  }
+  return result;
+}
+
+/**
+ * Decodes whatever has been appended to a followed file since the previous call, without waiting.
+ *
+ * New rows of the current page and any new pages are decoded; rows go into the ring buffer and the
+ * parameters of the newest page into follow->dataset.  Incomplete rows at the end of the file are
+ * left for the next call.  The file is read and decoded SDDS_FOLLOW_CHUNK_SIZE bytes at a time; the
+ * buffer only grows beyond that while a single row or page header does not fit in it.
+ *
+ * The writer updates the row count of the current page after appending its rows, so bytes beyond the
+ * last counted row are only taken as the start of a new page once two successive calls have seen
+ * them without the row count changing.  In files written with a fixed row count, the row count is an
+ * upper bound while the page is open, and page boundaries are only found once the writer has set the
+ * final count.
+ *
+ * @param follow Pointer to an SDDS_FOLLOW structure set up by SDDS_FollowInitialize.
+ *
+ * @return Returns the number of new rows (possibly zero); -1 on failure, with an error message recorded.
+ */
+int64_t SDDS_FollowRead(SDDS_FOLLOW *follow) {
+  FILE *fp;
+  int64_t size, length, rows, newRows;
+  int32_t status;
+  char *buffer;
+
+  if (!(fp = follow->dataset.layout.fp)) {
+    SDDS_SetError("File is not open (SDDS_FollowRead)");
+    return -1;
+  }
+  if (follow->inPage) {
+    if (!SDDS_FollowReadRowCount(follow, &rows)) {
+      SDDS_SetError("Unable to read row count (SDDS_FollowRead)");
+      return -1;
+    }
+    if (rows != follow->pageRows) {
+      follow->pageRows = rows;
+      follow->boundarySeen = 0;
+    }
+  }
+
+  if (fseek(fp, 0, SEEK_END) != 0 || (size = ftell(fp)) < 0) {
+    SDDS_SetError("Unable to determine file size (SDDS_FollowRead)");
+    return -1;
+  }
+  if (size < follow->offset + follow->bufferLength) {
+    SDDS_SetError("File was truncated (SDDS_FollowRead)");
+    return -1;
+  }
+
+  newRows = 0;
+  do {
+    if (size > follow->offset + follow->bufferLength) {
+      if (follow->bufferLength == follow->bufferSize) {
+        /* nothing in a full buffer could be decoded, so the next item is larger than the buffer */
+        length = follow->bufferSize ? 2 * follow->bufferSize : SDDS_FOLLOW_CHUNK_SIZE;
+        if (!(follow->buffer = SDDS_Realloc(follow->buffer, length))) {
+          SDDS_SetError("Memory allocation failure (SDDS_FollowRead)");
+          return -1;
+        }
+        follow->bufferSize = length;
+      }
+      length = size - follow->offset - follow->bufferLength;
+      if (length > follow->bufferSize - follow->bufferLength)
+        length = follow->bufferSize - follow->bufferLength;
+      if (fseek(fp, follow->offset + follow->bufferLength, SEEK_SET) != 0) {
+        SDDS_SetError("Unable to seek in file (SDDS_FollowRead)");
+        return -1;
+      }
+      if ((length = fread(follow->buffer + follow->bufferLength, 1, length, fp)) == 0)
+        size = follow->offset + follow->bufferLength;
+      follow->bufferLength += length;
+      clearerr(fp);
+    }
+    if ((status = SDDS_FollowDecode(follow, &newRows)) < 0) {
+      SDDS_SetError("Invalid data in file (SDDS_FollowRead)");
+      return -1;
+    }
+  } while (status > 0 && size > follow->offset + follow->bufferLength);
+
+  if (follow->bufferSize > SDDS_FOLLOW_CHUNK_SIZE && follow->bufferLength <= SDDS_FOLLOW_CHUNK_SIZE &&
+      (buffer = SDDS_Realloc(follow->buffer, SDDS_FOLLOW_CHUNK_SIZE))) {
+    /* give back the room taken by an item larger than a chunk */
+    follow->buffer = buffer;
+    follow->bufferSize = SDDS_FOLLOW_CHUNK_SIZE;
+  }
+  follow->totalRows += newRows;
+  return newRows;
+}
+
+/**
+ * Waits for new data in a followed file and decodes it.
+ *
+ * Returns as soon as new rows or a new page have been decoded, or when the timeout expires.  On Linux
+ * the wait uses inotify; elsewhere, or if the file cannot be watched, the file is checked every
+ * follow->pollInterval microseconds.
+ *
+ * @param follow Pointer to an SDDS_FOLLOW structure set up by SDDS_FollowInitialize.
+ * @param timeout Maximum time to wait in seconds.  A negative value waits indefinitely.
+ *
+ * @return Returns the number of new rows (zero on timeout or if only a new page was started); -1 on
+ *         failure, with an error message recorded.
+ */
+int64_t SDDS_FollowWait(SDDS_FOLLOW *follow, double timeout) {
+  double start, remaining;
+  int64_t rows;
+  int32_t page;
+  long interval;
+#if defined(__linux__)
+  struct pollfd pfd;
+  char events[4096];
+  int milliseconds;
+#endif
+
+  start = getTimeInSecs();
+  for (;;) {
+    page = follow->page;
+    if ((rows = SDDS_FollowRead(follow)) != 0 || follow->page != page)
+      return rows;
+    remaining = timeout - (getTimeInSecs() - start);
+    if (timeout >= 0 && remaining <= 0)
+      return 0;
+#if defined(__linux__)
+    if (follow->notifyFd >= 0) {
+      milliseconds = timeout < 0 ? -1 : (int)(remaining * 1e3) + 1;
+      /* bytes past the end of the page are rechecked shortly, since no further event may come */
+      if (follow->boundarySeen && (milliseconds < 0 || milliseconds > follow->pollInterval / 1000))
+        milliseconds = follow->pollInterval / 1000;
+      pfd.fd = follow->notifyFd;
+      pfd.events = POLLIN;
+      if (poll(&pfd, 1, milliseconds) > 0)
+        while (read(follow->notifyFd, events, sizeof(events)) > 0)
+          ;
+      continue;
+    }
+#endif
+    interval = follow->pollInterval;
+    if (timeout >= 0 && remaining * 1e6 < interval)
+      interval = (long)(remaining * 1e6) + 1;
+    usleepSystemIndependent(interval);
+  }
+}
+
+/**
+ * Returns the contents of the ring buffer for one column, oldest row first.
+ *
+ * @param follow Pointer to an SDDS_FOLLOW structure set up by SDDS_FollowInitialize.
+ * @param column_name Name of the column.
+ * @param rows Receives the number of rows returned.
+ *
+ * @return Returns a newly allocated array of the column's type (strings are copied), which the caller
+ *         must free; NULL on failure, with an error message recorded.
+ */
+void *SDDS_GetFollowColumn(SDDS_FOLLOW *follow, char *column_name, int64_t *rows) {
+  int32_t index, type, size;
+  int64_t i, first;
+  char *data;
+
+  if ((index = SDDS_GetColumnIndex(&follow->dataset, column_name)) < 0) {
+    SDDS_SetError("Unable to get column--name is not recognized (SDDS_GetFollowColumn)");
+    return NULL;
+  }
+  type = follow->dataset.layout.column_definition[index].type;
+  size = SDDS_type_size[type - 1];
+  if (!(data = malloc(size * (follow->ringRows ? follow->ringRows : 1)))) {
+    SDDS_SetError("Memory allocation failure (SDDS_GetFollowColumn)");
+    return NULL;
+  }
+  if (type == SDDS_STRING) {
+    for (i = 0; i < follow->ringRows; i++)
+      if (!SDDS_CopyString((char **)data + i, ((char **)follow->ring[index])[(follow->ringStart + i) % follow->capacity])) {
+        while (--i >= 0)
+          free(((char **)data)[i]);
+        free(data);
+        SDDS_SetError("Memory allocation failure (SDDS_GetFollowColumn)");
+        return NULL;
+      }
+  } else {
+    /* the rows are in at most two contiguous runs */
+    first = follow->ringRows < follow->capacity - follow->ringStart ? follow->ringRows : follow->capacity - follow->ringStart;
+    memcpy(data, (char *)follow->ring[index] + follow->ringStart * size, first * size);
+    memcpy(data + first * size, follow->ring[index], (follow->ringRows - first) * size);
+  }
+  *rows = follow->ringRows;
+  return data;
+}
+
+/**
+ * Closes a followed file and frees the ring buffer.
+ *
+ * @param follow Pointer to an SDDS_FOLLOW structure set up by SDDS_FollowInitialize.
+ *
+ * @return Returns 1 on success; 0 on failure, with an error message recorded.
+ */
+int32_t SDDS_FollowTerminate(SDDS_FOLLOW *follow) {
+  int32_t i, status;
+  int64_t j;
+
+  if (follow->ring) {
+    for (i = 0; i < follow->dataset.layout.n_columns; i++) {
+      if (!follow->ring[i])
+        continue;
+      if (follow->dataset.layout.column_definition[i].type == SDDS_STRING)
+        for (j = 0; j < follow->capacity; j++)
+          if (((char **)follow->ring[i])[j])
+            free(((char **)follow->ring[i])[j]);
+      free(follow->ring[i]);
+    }
+    free(follow->ring);
+  }
+  if (follow->buffer)
+    free(follow->buffer);
+#if defined(__linux__)
+  if (follow->notifyFd >= 0)
+    close(follow->notifyFd);
+#endif
+  status = SDDS_Terminate(&follow->dataset);
+  memset(follow, 0, sizeof(*follow));
+  follow->notifyFd = follow->watchFd = -1;
+  return status;
+}
@@ -425,6 +425,7 @@ int32_t SDDS_ChangeColumnInformation(SDDS_DATASET *SDDS_dataset, char *field_nam
       }
       SDDS_dataset->layout.column_index[i]->name = SDDS_dataset->layout.column_definition[column_index].name;
       qsort((char *)SDDS_dataset->layout.column_index, SDDS_dataset->layout.n_columns, sizeof(*SDDS_dataset->layout.column_index), SDDS_CompareIndexedNamesPtr);
+      SDDS_InvalidateNameHash(SDDS_dataset->layout.column_hash);
     }
   } else {
     if (mode & SDDS_PASS_BY_STRING) {
@@ -535,8 +536,10 @@ int32_t SDDS_ChangeParameterInformation(SDDS_DATASET *SDDS_dataset, char *field_
       SDDS_SetError("Unable to copy field data (SDDS_ChangeParameterInformation)");
       return (0);
     }
-    if (strcmp(field_name, "name") == 0)
+    if (strcmp(field_name, "name") == 0) {
       qsort((char *)SDDS_dataset->layout.parameter_index, SDDS_dataset->layout.n_parameters, sizeof(*SDDS_dataset->layout.parameter_index), SDDS_CompareIndexedNamesPtr);
+      SDDS_InvalidateNameHash(SDDS_dataset->layout.parameter_hash);
+    }
   } else {
     if (mode & SDDS_PASS_BY_STRING) {
       if (strcmp(field_name, "type") == 0 && (givenType = SDDS_IdentifyType((char *)memory)) > 0)
@@ -647,8 +650,10 @@ int32_t SDDS_ChangeArrayInformation(SDDS_DATASET *SDDS_dataset, char *field_name
       SDDS_SetError("Unable to copy field data (SDDS_ChangeArrayInformation)");
       return (0);
     }
-    if (strcmp(field_name, "name") == 0)
+    if (strcmp(field_name, "name") == 0) {
       qsort((char *)SDDS_dataset->layout.array_index, SDDS_dataset->layout.n_arrays, sizeof(*SDDS_dataset->layout.array_index), SDDS_CompareIndexedNamesPtr);
+      SDDS_InvalidateNameHash(SDDS_dataset->layout.array_hash);
+    }
   } else {
     if (mode & SDDS_PASS_BY_STRING) {
       if (strcmp(field_name, "type") == 0 && (givenType = SDDS_IdentifyType((char *)memory)) > 0)
@@ -49,6 +49,7 @@
 int32_t SDDS_InitializeInput(SDDS_DATASET *SDDS_dataset, char *filename) {
   /*  char *ptr, *datafile, *headerfile; */
   char s[SDDS_MAXLINE];
+  int32_t cached;
 #if defined(zLib)
   char *extension;
 #endif
@@ -125,9 +126,16 @@ int32_t SDDS_InitializeInput(SDDS_DATASET *SDDS_dataset, char *filename) {
     if (SDDS_dataset->layout.lzmaFile) {
       if (!SDDS_LZMAReadLayout(SDDS_dataset, SDDS_dataset->layout.lzmafp))
         return (0);
-    } else {
+    } else if (SDDS_dataset->layout.popenUsed || !filename) {
       if (!SDDS_ReadLayout(SDDS_dataset, SDDS_dataset->layout.fp))
         return (0);
+    } else {
+      /* plain file: headers identical to a recently read one are cloned rather than parsed (files
+         that cannot be rewound, such as named pipes, bypass the cache) */
+      if ((cached = SDDS_LookupCachedLayout(SDDS_dataset)) < 0)
+        return (0);
+      if (!cached && (!SDDS_ReadLayout(SDDS_dataset, SDDS_dataset->layout.fp) || !SDDS_CacheLayout(SDDS_dataset)))
+        return (0);
     }
 #if defined(zLib)
   }
@@ -552,6 +560,7 @@ int32_t SDDS_ReadLayout(SDDS_DATASET *SDDS_dataset, FILE *fp) {
     }
     SDDS_ResetSpecialCommentsModes(SDDS_dataset);
     SDDS_dataset->layout.data_command_seen = 0;
+    SDDS_dataset->layout.index_deferred = 1;
   }
   while (SDDS_GetNamelist(SDDS_dataset, SDDS_dataset->layout.s, SDDS_MAXLINE, fp)) {
 #if DEBUG
@@ -606,6 +615,10 @@ int32_t SDDS_ReadLayout(SDDS_DATASET *SDDS_dataset, FILE *fp) {
         SDDS_SetError("Unable to read layout--multiple data commands (SDDS_ReadLayout)");
         return (0);
       }
+      if (!SDDS_SortLayoutIndexes(SDDS_dataset)) {
+        SDDS_SetError("Unable to read layout--duplicate names (SDDS_ReadLayout)");
+        return (0);
+      }
       if (!SDDS_SaveLayout(SDDS_dataset)) {
         SDDS_SetError("Unable to read layout--couldn't save layout (SDDS_ReadLayout)");
         return (0);
@@ -715,6 +728,7 @@ int32_t SDDS_LZMAReadLayout(SDDS_DATASET *SDDS_dataset, struct lzmafile *lzmafp)
     }
     SDDS_ResetSpecialCommentsModes(SDDS_dataset);
     SDDS_dataset->layout.data_command_seen = 0;
+    SDDS_dataset->layout.index_deferred = 1;
   }
   while (SDDS_GetLZMANamelist(SDDS_dataset, SDDS_dataset->layout.s, SDDS_MAXLINE, lzmafp)) {
 #if DEBUG
@@ -769,6 +783,10 @@ int32_t SDDS_LZMAReadLayout(SDDS_DATASET *SDDS_dataset, struct lzmafile *lzmafp)
         SDDS_SetError("Unable to read layout--multiple data commands (SDDS_LZMAReadLayout)");
         return (0);
       }
+      if (!SDDS_SortLayoutIndexes(SDDS_dataset)) {
+        SDDS_SetError("Unable to read layout--duplicate names (SDDS_LZMAReadLayout)");
+        return (0);
+      }
       if (!SDDS_SaveLayout(SDDS_dataset)) {
         SDDS_SetError("Unable to read layout--couldn't save layout (SDDS_LZMAReadLayout)");
         return (0);
@@ -877,8 +895,10 @@ int32_t SDDS_GZipReadLayout(SDDS_DATASET *SDDS_dataset, gzFile gzfp) {
     return (0);
   }
   SDDS_ResetSpecialCommentsModes(SDDS_dataset);
-  if (SDDS_dataset->layout.depth == 0)
+  if (SDDS_dataset->layout.depth == 0) {
     SDDS_dataset->layout.data_command_seen = 0;
+    SDDS_dataset->layout.index_deferred = 1;
+  }
   while (SDDS_GetGZipNamelist(SDDS_dataset, SDDS_dataset->layout.s, SDDS_MAXLINE, gzfp)) {
 #  if DEBUG
     strcpy(buffer, SDDS_dataset->layout.s);
@@ -932,6 +952,10 @@ int32_t SDDS_GZipReadLayout(SDDS_DATASET *SDDS_dataset, gzFile gzfp) {
         SDDS_SetError("Unable to read layout--multiple data commands (SDDS_GZipReadLayout)");
         return (0);
       }
+      if (!SDDS_SortLayoutIndexes(SDDS_dataset)) {
+        SDDS_SetError("Unable to read layout--duplicate names (SDDS_GZipReadLayout)");
+        return (0);
+      }
       if (!SDDS_SaveLayout(SDDS_dataset)) {
         SDDS_SetError("Unable to read layout--couldn't save layout (SDDS_GZipReadLayout)");
         return (0);
@@ -1087,6 +1111,15 @@ int32_t SDDS_ReadPageSparse(SDDS_DATASET *SDDS_dataset, uint32_t mode, int64_t s
 
   if (!SDDS_CheckDataset(SDDS_dataset, "SDDS_ReadPageSparse"))
     return (0);
+#if SDDS_MPI_IO
+  if (SDDS_dataset->parallel_io) {
+    if (sparse_statistics) {
+      SDDS_SetError("sparse_statistics is not supported with parallel I/O (SDDS_ReadPageSparse)");
+      return (0);
+    }
+    return SDDS_MPI_ReadPageSparse(SDDS_dataset, sparse_interval, sparse_offset);
+  }
+#endif
   if (SDDS_dataset->layout.disconnected) {
     SDDS_SetError("Can't read page--file is disconnected (SDDS_ReadPageSparse)");
     return 0;
@@ -1113,36 +1146,41 @@ int32_t SDDS_ReadPageSparse(SDDS_DATASET *SDDS_dataset, uint32_t mode, int64_t s
 #if defined(zLib)
   }
 #endif
-  if (SDDS_dataset->original_layout.data_mode.mode == SDDS_ASCII) {
-    if ((retval = SDDS_ReadAsciiPage(SDDS_dataset, sparse_interval, sparse_offset, sparse_statistics)) < 1) {
-      return (retval);
-    }
-  } else if (SDDS_dataset->original_layout.data_mode.mode == SDDS_BINARY) {
-    if ((retval = SDDS_ReadBinaryPage(SDDS_dataset, sparse_interval, sparse_offset, sparse_statistics)) < 1) {
-      return (retval);
+  /* pages rejected by the read filters are skipped */
+  do {
+    if (SDDS_dataset->original_layout.data_mode.mode == SDDS_ASCII) {
+      if ((retval = SDDS_ReadAsciiPage(SDDS_dataset, sparse_interval, sparse_offset, sparse_statistics)) < 1) {
+        return (retval);
+      }
+    } else if (SDDS_dataset->original_layout.data_mode.mode == SDDS_BINARY) {
+      if ((retval = SDDS_ReadBinaryPage(SDDS_dataset, sparse_interval, sparse_offset, sparse_statistics)) < 1) {
+        return (retval);
+      }
+    } else {
+      SDDS_SetError("Unable to read page--unrecognized data mode (SDDS_ReadPageSparse)");
+      return (0);
     }
-  } else {
-    SDDS_SetError("Unable to read page--unrecognized data mode (SDDS_ReadPageSparse)");
-    return (0);
-  }
-  if (!SDDS_dataset->layout.gzipFile && !SDDS_dataset->layout.lzmaFile && !SDDS_dataset->layout.popenUsed && SDDS_dataset->layout.filename && SDDS_dataset->pagecount_offset) {
-    /* Data is not:
-         1. from a gzip file
-         2. from a file that is being internally decompressed by a command executed with popen()
-         3. from a pipe set up externally (e.g., -pipe=in on commandline)
-         and pagecount_offset has been allocate memory from SDDS_initializeInput()
-      */
-    if (SDDS_dataset->pagecount_offset[SDDS_dataset->pages_read] < SDDS_dataset->endOfFile_offset) {
-      SDDS_dataset->pages_read++;
-      if (!(SDDS_dataset->pagecount_offset = realloc(SDDS_dataset->pagecount_offset, sizeof(int64_t) * (SDDS_dataset->pages_read + 1)))) {
-        SDDS_SetError("Unable to allocate memory for pagecount_offset (SDDS_ReadPageSparse)");
-        exit(1);
+    if (!SDDS_dataset->layout.gzipFile && !SDDS_dataset->layout.lzmaFile && !SDDS_dataset->layout.popenUsed && SDDS_dataset->layout.filename && SDDS_dataset->pagecount_offset) {
+      /* Data is not:
+           1. from a gzip file
+           2. from a file that is being internally decompressed by a command executed with popen()
+           3. from a pipe set up externally (e.g., -pipe=in on commandline)
+           and pagecount_offset has been allocate memory from SDDS_initializeInput()
+        */
+      if (SDDS_dataset->pagecount_offset[SDDS_dataset->pages_read] < SDDS_dataset->endOfFile_offset) {
+        SDDS_dataset->pages_read++;
+        if (!(SDDS_dataset->pagecount_offset = realloc(SDDS_dataset->pagecount_offset, sizeof(int64_t) * (SDDS_dataset->pages_read + 1)))) {
+          SDDS_SetError("Unable to allocate memory for pagecount_offset (SDDS_ReadPageSparse)");
+          exit(1);
+        }
+        SDDS_dataset->pagecount_offset[SDDS_dataset->pages_read] = ftell(SDDS_dataset->layout.fp);
       }
-      SDDS_dataset->pagecount_offset[SDDS_dataset->pages_read] = ftell(SDDS_dataset->layout.fp);
+    } else {
+      SDDS_dataset->pages_read++;
     }
-  } else {
-    SDDS_dataset->pages_read++;
-  }
+  } while (SDDS_dataset->readFilters && !SDDS_PageMatchesReadFilters(SDDS_dataset));
+  if (SDDS_dataset->readFilters && !SDDS_ApplyColumnReadFilters(SDDS_dataset))
+    return (0);
   return (retval);
 }
 
@@ -1158,6 +1196,10 @@ int32_t SDDS_ReadPageLastRows(SDDS_DATASET *SDDS_dataset, int64_t last_rows) {
 
   if (!SDDS_CheckDataset(SDDS_dataset, "SDDS_ReadPageLastRows"))
     return (0);
+#if SDDS_MPI_IO
+  if (SDDS_dataset->parallel_io)
+    return SDDS_MPI_ReadPageLastRows(SDDS_dataset, last_rows);
+#endif
   if (SDDS_dataset->layout.disconnected) {
     SDDS_SetError("Can't read page--file is disconnected (SDDS_ReadPageLastRows)");
     return 0;
@@ -1184,37 +1226,192 @@ int32_t SDDS_ReadPageLastRows(SDDS_DATASET *SDDS_dataset, int64_t last_rows) {
 #if defined(zLib)
   }
 #endif
-  if (SDDS_dataset->original_layout.data_mode.mode == SDDS_ASCII) {
-    if ((retval = SDDS_ReadAsciiPageLastRows(SDDS_dataset, last_rows)) < 1) {
-      return (retval);
+  /* pages rejected by the read filters are skipped */
+  do {
+    if (SDDS_dataset->original_layout.data_mode.mode == SDDS_ASCII) {
+      if ((retval = SDDS_ReadAsciiPageLastRows(SDDS_dataset, last_rows)) < 1) {
+        return (retval);
+      }
+    } else if (SDDS_dataset->original_layout.data_mode.mode == SDDS_BINARY) {
+      if ((retval = SDDS_ReadBinaryPageLastRows(SDDS_dataset, last_rows)) < 1) {
+        return (retval);
+      }
+    } else {
+      SDDS_SetError("Unable to read page--unrecognized data mode (SDDS_ReadPageLastRows)");
+      return (0);
     }
-  } else if (SDDS_dataset->original_layout.data_mode.mode == SDDS_BINARY) {
-    if ((retval = SDDS_ReadBinaryPageLastRows(SDDS_dataset, last_rows)) < 1) {
-      return (retval);
+    if (!SDDS_dataset->layout.gzipFile && !SDDS_dataset->layout.lzmaFile && !SDDS_dataset->layout.popenUsed && SDDS_dataset->layout.filename && SDDS_dataset->pagecount_offset) {
+      /* Data is not:
+           1. from a gzip file
+           2. from a file that is being internally decompressed by a command executed with popen()
+           3. from a pipe set up externally (e.g., -pipe=in on commandline)
+           and pagecount_offset has been allocate memory from SDDS_initializeInput()
+        */
+      if (SDDS_dataset->pagecount_offset[SDDS_dataset->pages_read] < SDDS_dataset->endOfFile_offset) {
+        SDDS_dataset->pages_read++;
+        if (!(SDDS_dataset->pagecount_offset = realloc(SDDS_dataset->pagecount_offset, sizeof(int64_t) * (SDDS_dataset->pages_read + 1)))) {
+          SDDS_SetError("Unable to allocate memory for pagecount_offset (SDDS_ReadPageLastRows)");
+          exit(1);
+        }
+        SDDS_dataset->pagecount_offset[SDDS_dataset->pages_read] = ftell(SDDS_dataset->layout.fp);
+      }
+    } else {
+      SDDS_dataset->pages_read++;
     }
-  } else {
-    SDDS_SetError("Unable to read page--unrecognized data mode (SDDS_ReadPageLastRows)");
+  } while (SDDS_dataset->readFilters && !SDDS_PageMatchesReadFilters(SDDS_dataset));
+  if (SDDS_dataset->readFilters && !SDDS_ApplyColumnReadFilters(SDDS_dataset))
+    return (0);
+  return (retval);
+}
+
+/**
+ * Registers a predicate that is applied while pages are read.
+ *
+ * Parameter filters (SDDS_PARAMETER_READ_FILTER) reject any page whose value of the named
+ * parameter lies outside [lower, upper].  Such pages are skipped in the file without
+ * allocating or decoding their tabular data, and SDDS_ReadPage moves on to the next page.
+ *
+ * Column filters (SDDS_COLUMN_READ_FILTER) mark rows whose value of the named column lies outside
+ * [lower, upper] as not of interest, just as SDDS_FilterRowsOfInterest does with SDDS_AND logic.
+ * If the file carries per-page summaries of the column in parameters named <name>Min and <name>Max
+ * (as produced by sddsprocess -process=<name>,minimum and -process=<name>,maximum), pages whose
+ * range doesn't intersect [lower, upper] are skipped in the same way as for parameter filters.
+ *
+ * All registered filters must be satisfied.  Filters are kept until SDDS_ClearReadFilters or SDDS_Terminate
+ * is called.  Should be called after SDDS_InitializeInput.
+ *
+ * @param SDDS_dataset A pointer to an SDDS dataset.
+ * @param mode SDDS_PARAMETER_READ_FILTER or SDDS_COLUMN_READ_FILTER.
+ * @param name The name of a numeric parameter or column.
+ * @param lower The lower limit of the accepted range.
+ * @param upper The upper limit of the accepted range.
+ * @return 1 on success, 0 on error.
+ */
+int32_t SDDS_AddReadFilter(SDDS_DATASET *SDDS_dataset, uint32_t mode, char *name, double lower, double upper) {
+  int32_t index, type;
+  SDDS_READ_FILTER *filter;
+
+  if (!SDDS_CheckDataset(SDDS_dataset, "SDDS_AddReadFilter"))
+    return (0);
+  if (!name) {
+    SDDS_SetError("Unable to add read filter--name not given (SDDS_AddReadFilter)");
     return (0);
   }
-  if (!SDDS_dataset->layout.gzipFile && !SDDS_dataset->layout.lzmaFile && !SDDS_dataset->layout.popenUsed && SDDS_dataset->layout.filename && SDDS_dataset->pagecount_offset) {
-    /* Data is not:
-         1. from a gzip file
-         2. from a file that is being internally decompressed by a command executed with popen()
-         3. from a pipe set up externally (e.g., -pipe=in on commandline)
-         and pagecount_offset has been allocate memory from SDDS_initializeInput()
-      */
-    if (SDDS_dataset->pagecount_offset[SDDS_dataset->pages_read] < SDDS_dataset->endOfFile_offset) {
-      SDDS_dataset->pages_read++;
-      if (!(SDDS_dataset->pagecount_offset = realloc(SDDS_dataset->pagecount_offset, sizeof(int64_t) * (SDDS_dataset->pages_read + 1)))) {
-        SDDS_SetError("Unable to allocate memory for pagecount_offset (SDDS_ReadPageLastRows)");
-        exit(1);
-      }
-      SDDS_dataset->pagecount_offset[SDDS_dataset->pages_read] = ftell(SDDS_dataset->layout.fp);
+  if (mode == SDDS_PARAMETER_READ_FILTER) {
+    if ((index = SDDS_GetParameterIndex(SDDS_dataset, name)) < 0) {
+      SDDS_SetError("Unable to add read filter--parameter name is unrecognized (SDDS_AddReadFilter)");
+      return (0);
+    }
+    type = SDDS_GetParameterType(SDDS_dataset, index);
+  } else if (mode == SDDS_COLUMN_READ_FILTER) {
+    if ((index = SDDS_GetColumnIndex(SDDS_dataset, name)) < 0) {
+      SDDS_SetError("Unable to add read filter--column name is unrecognized (SDDS_AddReadFilter)");
+      return (0);
     }
+    type = SDDS_GetColumnType(SDDS_dataset, index);
   } else {
-    SDDS_dataset->pages_read++;
+    SDDS_SetError("Unable to add read filter--invalid mode (SDDS_AddReadFilter)");
+    return (0);
   }
-  return (retval);
+  if (!SDDS_NUMERIC_TYPE(type)) {
+    SDDS_SetError("Unable to add read filter--data is not a numeric type (SDDS_AddReadFilter)");
+    return (0);
+  }
+  if (!(SDDS_dataset->readFilter = SDDS_Realloc(SDDS_dataset->readFilter, sizeof(*SDDS_dataset->readFilter) * (SDDS_dataset->readFilters + 1)))) {
+    SDDS_SetError("Unable to add read filter--allocation failure (SDDS_AddReadFilter)");
+    return (0);
+  }
+  filter = SDDS_dataset->readFilter + SDDS_dataset->readFilters;
+  if (!SDDS_CopyString(&filter->name, name)) {
+    SDDS_SetError("Unable to add read filter--allocation failure (SDDS_AddReadFilter)");
+    return (0);
+  }
+  filter->mode = mode;
+  filter->lower = lower;
+  filter->upper = upper;
+  SDDS_dataset->readFilters++;
+  return (1);
+}
+
+/**
+ * Removes all predicates registered with SDDS_AddReadFilter.
+ *
+ * @param SDDS_dataset A pointer to an SDDS dataset.
+ * @return 1 on success, 0 on error.
+ */
+int32_t SDDS_ClearReadFilters(SDDS_DATASET *SDDS_dataset) {
+  int32_t i;
+
+  if (!SDDS_CheckDataset(SDDS_dataset, "SDDS_ClearReadFilters"))
+    return (0);
+  for (i = 0; i < SDDS_dataset->readFilters; i++)
+    free(SDDS_dataset->readFilter[i].name);
+  if (SDDS_dataset->readFilter)
+    free(SDDS_dataset->readFilter);
+  SDDS_dataset->readFilter = NULL;
+  SDDS_dataset->readFilters = 0;
+  return (1);
+}
+
+/**
+ * Checks the parameter values of the current page against the registered read filters.
+ *
+ * Only requires that the parameters of the page have been read, so it can be used to decide whether
+ * the tabular data of the page needs to be read at all.
+ *
+ * @param SDDS_dataset A pointer to an SDDS dataset.
+ * @return 1 if the page may contain data of interest, 0 if it can be skipped.
+ */
+int32_t SDDS_PageMatchesReadFilters(SDDS_DATASET *SDDS_dataset) {
+  int32_t i, index, minIndex, maxIndex, minType, maxType;
+  char name[SDDS_MAXLINE];
+  SDDS_READ_FILTER *filter;
+
+  if (!SDDS_dataset->parameter)
+    return (1);
+  for (i = 0; i < SDDS_dataset->readFilters; i++) {
+    filter = SDDS_dataset->readFilter + i;
+    if (filter->mode == SDDS_PARAMETER_READ_FILTER) {
+      if ((index = SDDS_GetParameterIndex(SDDS_dataset, filter->name)) < 0)
+        continue;
+      if (!SDDS_ItemInsideWindow(SDDS_dataset->parameter[index], 0, SDDS_dataset->layout.parameter_definition[index].type, filter->lower, filter->upper))
+        return (0);
+    } else if (strlen(filter->name) < SDDS_MAXLINE - 4) {
+      /* use the per-page column summary, if there is one */
+      sprintf(name, "%sMin", filter->name);
+      minIndex = SDDS_GetParameterIndex(SDDS_dataset, name);
+      sprintf(name, "%sMax", filter->name);
+      maxIndex = SDDS_GetParameterIndex(SDDS_dataset, name);
+      if (minIndex < 0 || maxIndex < 0)
+        continue;
+      minType = SDDS_dataset->layout.parameter_definition[minIndex].type;
+      maxType = SDDS_dataset->layout.parameter_definition[maxIndex].type;
+      if (!SDDS_NUMERIC_TYPE(minType) || !SDDS_NUMERIC_TYPE(maxType))
+        continue;
+      if (SDDS_ConvertToDouble(maxType, SDDS_dataset->parameter[maxIndex], 0) < filter->lower ||
+          SDDS_ConvertToDouble(minType, SDDS_dataset->parameter[minIndex], 0) > filter->upper)
+        return (0);
+    }
+  }
+  return (1);
+}
+
+/**
+ * Applies the registered column read filters to the row flags of the current page.
+ *
+ * @param SDDS_dataset A pointer to an SDDS dataset.
+ * @return 1 on success, 0 on error.
+ */
+int32_t SDDS_ApplyColumnReadFilters(SDDS_DATASET *SDDS_dataset) {
+  int32_t i;
+
+  for (i = 0; i < SDDS_dataset->readFilters; i++) {
+    if (SDDS_dataset->readFilter[i].mode != SDDS_COLUMN_READ_FILTER || !SDDS_dataset->n_rows)
+      continue;
+    if (SDDS_FilterRowsOfInterest(SDDS_dataset, SDDS_dataset->readFilter[i].name, SDDS_dataset->readFilter[i].lower, SDDS_dataset->readFilter[i].upper, SDDS_AND) < 0)
+      return (0);
+  }
+  return (1);
 }
 
 /**
@@ -1260,6 +1457,7 @@ int64_t SDDS_GetRowLimit() {
  */
 int32_t SDDS_GotoPage(SDDS_DATASET *SDDS_dataset, int32_t page_number) {
   int64_t offset;
+  int32_t readFilters;
 
   if (!SDDS_CheckDataset(SDDS_dataset, "SDDS_GotoPage"))
     return (0);
@@ -1309,12 +1507,17 @@ int32_t SDDS_GotoPage(SDDS_DATASET *SDDS_dataset, int32_t page_number) {
     offset = SDDS_dataset->pagecount_offset[SDDS_dataset->pages_read] - ftell(SDDS_dataset->layout.fp);
     fseek(SDDS_dataset->layout.fp, offset, 1);
     SDDS_dataset->page_number = SDDS_dataset->pages_read;
+    /* read filters must not hide pages while positioning the file */
+    readFilters = SDDS_dataset->readFilters;
+    SDDS_dataset->readFilters = 0;
     while (SDDS_dataset->pages_read < page_number) {
       if (SDDS_ReadPageSparse(SDDS_dataset, 0, 10000, 0, 0) <= 0) {
+        SDDS_dataset->readFilters = readFilters;
         SDDS_SetError("The page_number is greater than the total pages (SDDS_GotoPage)");
         return (0);
       }
     }
+    SDDS_dataset->readFilters = readFilters;
   } else {
     offset = SDDS_dataset->pagecount_offset[page_number - 1] - ftell(SDDS_dataset->layout.fp);
     fseek(SDDS_dataset->layout.fp, offset, 1); /*seek to the position from current offset */
@@ -1685,7 +1888,11 @@ int32_t SDDS_Terminate(SDDS_DATASET *SDDS_dataset) {
     free(layout->parameter_index);
   if (layout->array_index)
     free(layout->array_index);
+  SDDS_FreeNameHash(&layout->column_hash);
+  SDDS_FreeNameHash(&layout->parameter_hash);
+  SDDS_FreeNameHash(&layout->array_hash);
   SDDS_ZeroMemory(&SDDS_dataset->layout, sizeof(SDDS_LAYOUT));
+  SDDS_ClearReadFilters(SDDS_dataset);
   SDDS_ZeroMemory(SDDS_dataset, sizeof(SDDS_DATASET));
 #if DEBUG
   fprintf(stderr, "done\n");
@@ -110,10 +110,13 @@ extern int32_t SDDS_ReadBinaryPage(SDDS_DATASET *SDDS_dataset, int64_t sparse_in
 extern int32_t SDDS_ReadBinaryPageLastRows(SDDS_DATASET *SDDS_dataset, int64_t last_rows);
 extern int32_t SDDS_ReadBinaryPageDetailed(SDDS_DATASET *SDDS_dataset, int64_t sparse_interval, int64_t sparse_offset, int64_t last_rows, int32_t sparse_statistics);
 extern int32_t SDDS_ReadBinaryRow(SDDS_DATASET *SDDS_dataset, int64_t row, int32_t skip);
+extern int64_t SDDS_FixedBinaryRowSize(SDDS_DATASET *SDDS_dataset);
+extern int64_t SDDS_DecodeBufferedBinaryRows(SDDS_DATASET *SDDS_dataset, int64_t row, int64_t n_rows, int64_t rowSize);
 extern int32_t SDDS_ReadNonNativePageLastRows(SDDS_DATASET *SDDS_dataset, int64_t last_rows);
 extern int32_t SDDS_ReadNonNativeBinaryPageDetailed(SDDS_DATASET *SDDS_dataset, int64_t sparse_interval, int64_t sparse_offset, int64_t last_rows);
 extern int32_t SDDS_ReadNonNativePageDetailed(SDDS_DATASET *SDDS_dataset, uint32_t mode, int64_t sparse_interval, int64_t sparse_offset, int64_t last_rows);
 extern int32_t SDDS_ReadNonNativeBinaryPageLastRows(SDDS_DATASET *SDDS_dataset, int64_t last_rows);
+extern int32_t SDDS_SkipBinaryColumnData(SDDS_DATASET *SDDS_dataset, int64_t n_rows);
 
 extern int32_t SDDS_AllocateColumnFlags(SDDS_DATASET *SDDS_target);
 
@@ -138,6 +141,10 @@ extern int32_t SDDS_GZipWriteAsciiArrays(SDDS_DATASET *SDDS_dataset, gzFile gzfp
 extern int32_t SDDS_GZipWriteAsciiRow(SDDS_DATASET *SDDS_dataset, int64_t row, gzFile gzfp);
 #  endif
 
+/* routines from SDDS_copy.c : */
+extern int32_t SDDS_LookupCachedLayout(SDDS_DATASET *SDDS_dataset);
+extern int32_t SDDS_CacheLayout(SDDS_DATASET *SDDS_dataset);
+
 /* routines from SDDS_extract.c : */
 extern int32_t SDDS_CopyColumn(SDDS_DATASET *SDDS_dataset, int32_t target, int32_t source);
 extern int32_t SDDS_CopyParameter(SDDS_DATASET *SDDS_dataset, int32_t target, int32_t source);
@@ -147,6 +154,8 @@ extern int64_t SDDS_GetSelectedRowIndex(SDDS_DATASET *SDDS_dataset, int64_t srow
 /* routines from SDDS_utils.c : */
 extern int32_t SDDS_CheckTable(SDDS_DATASET *SDDS_dataset, const char *caller);
 extern int32_t SDDS_AdvanceCounter(int32_t *counter, int32_t *max_count, int32_t n_indices);
+extern int32_t SDDS_InsertIndexedName(SDDS_LAYOUT *layout, SORTED_INDEX **sorted, SDDS_NAME_HASH **hash, int32_t n, SORTED_INDEX *entry, int32_t *duplicate);
+extern int32_t SDDS_SortLayoutIndexes(SDDS_DATASET *SDDS_dataset);
 extern void SDDS_FreePointerArray(void **data, int32_t dimensions, int32_t *dimension);
 
 /* routines from SDDS_output.c : */
@@ -193,6 +202,8 @@ extern int32_t SDDS1_ProcessAssociateDefinition(SDDS_DATASET *SDDS_dataset, char
 extern int32_t SDDS1_ProcessDataMode(SDDS_DATASET *SDDS_dataset, char *s);
 
 /* internal input routines */
+extern int32_t SDDS_PageMatchesReadFilters(SDDS_DATASET *SDDS_dataset);
+extern int32_t SDDS_ApplyColumnReadFilters(SDDS_DATASET *SDDS_dataset);
 extern int32_t SDDS_ReadLayout(SDDS_DATASET *SDDS_dataset, FILE *fp);
 extern int32_t SDDS_LZMAReadLayout(SDDS_DATASET *SDDS_dataset, struct lzmafile *lzmafp);
 extern int32_t SDDS_UpdateAsciiPage(SDDS_DATASET *SDDS_dataset, uint32_t mode);
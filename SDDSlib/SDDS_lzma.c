@@ -79,7 +79,8 @@ void *lzma_open(const char *path, const char *mode) {
 #if LZMA_VERSION <= UINT32_C(49990030)
     ret = lzma_auto_decoder(&lf->str, NULL, NULL);
 #else
-    ret = lzma_auto_decoder(&lf->str, -1, 0);
+    /* parallel writers produce files made of several concatenated .xz streams */
+    ret = lzma_auto_decoder(&lf->str, -1, LZMA_CONCATENATED);
 #endif
     lf->str.avail_in = 0;
   } else {
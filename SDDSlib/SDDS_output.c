@@ -361,6 +361,220 @@ int32_t SDDS_InitializeAppend(SDDS_DATASET *SDDS_dataset, const char *filename)
   return 1;
 }
 
+/**
+ * @brief Returns the name of the file in which SDDS_InitializeAppendToPage records the last page of @p filename.
+ *
+ * @param[in] filename Name of the SDDS file.
+ *
+ * @return Newly allocated name, or @c NULL on allocation failure.
+ */
+static char *SDDS_AppendInfoName(const char *filename) {
+  char *name;
+
+  if ((name = SDDS_Malloc(sizeof(*name) * (strlen(filename) + 10))))
+    sprintf(name, "%s.lastpage", filename);
+  return name;
+}
+
+/**
+ * @brief Records the position of the last page of a file being appended to.
+ *
+ * The record is one line of text in <filename>.lastpage giving the end of the header, the start of the last
+ * page, the offset of its row count, the offset of its first row and the size of a row.  The last two are
+ * only known for binary files with fixed-width rows, and are -1 and 0 otherwise.  Failure to write the
+ * record is not an error, since SDDS_InitializeAppendToPage can always find the last page by reading the file.
+ *
+ * @param[in,out] SDDS_dataset Pointer to the SDDS_DATASET being appended to.
+ * @param[in] pageOffset Offset of the start of the last page.
+ * @param[in] dataOffset Offset of the first row of the last page, or -1 if not known.
+ * @param[in] rowSize Size of a row in bytes, or 0 if rows are not of fixed size.
+ */
+static void SDDS_WriteAppendInfo(SDDS_DATASET *SDDS_dataset, int64_t pageOffset, int64_t dataOffset, int64_t rowSize) {
+  char *name;
+  FILE *fp;
+
+  if (!SDDS_dataset->layout.filename || !(name = SDDS_AppendInfoName(SDDS_dataset->layout.filename)))
+    return;
+  if ((fp = fopen(name, "w"))) {
+    fprintf(fp, "SDDS append info: layout=%" PRId64 " page=%" PRId64 " rowcount=%" PRId64 " data=%" PRId64 " rowsize=%" PRId64 "\n",
+            SDDS_dataset->append_layout_offset, pageOffset, SDDS_dataset->rowcount_offset, dataOffset, rowSize);
+    fclose(fp);
+    SDDS_dataset->append_rowcount_offset = SDDS_dataset->rowcount_offset;
+  }
+  free(name);
+}
+
+/**
+ * @brief Reads the record written by SDDS_WriteAppendInfo.
+ *
+ * @return Returns 1 if a complete record was read, 0 otherwise.
+ */
+static int32_t SDDS_ReadAppendInfo(const char *filename, int64_t *layoutOffset, int64_t *pageOffset, int64_t *rowCountOffset, int64_t *dataOffset, int64_t *rowSize) {
+  char *name;
+  FILE *fp;
+  int32_t found;
+
+  found = 0;
+  if (!(name = SDDS_AppendInfoName(filename)))
+    return 0;
+  if ((fp = fopen(name, "r"))) {
+    found = fscanf(fp, "SDDS append info: layout=%" SCNd64 " page=%" SCNd64 " rowcount=%" SCNd64 " data=%" SCNd64 " rowsize=%" SCNd64,
+                   layoutOffset, pageOffset, rowCountOffset, dataOffset, rowSize) == 5;
+    fclose(fp);
+  }
+  free(name);
+  return found;
+}
+
+/**
+ * @brief Returns the size of a row of a binary file whose rows are all the same size, or 0.
+ */
+static int64_t SDDS_AppendRowSize(SDDS_DATASET *SDDS_dataset) {
+  SDDS_LAYOUT *layout;
+  int64_t size;
+  int32_t i;
+
+  layout = &SDDS_dataset->layout;
+  if (layout->data_mode.mode != SDDS_BINARY || layout->data_mode.column_major || layout->data_mode.fixed_row_count)
+    return 0;
+  size = 0;
+  for (i = 0; i < layout->n_columns; i++) {
+    if (layout->column_definition[i].type == SDDS_STRING)
+      return 0;
+    size += SDDS_type_size[layout->column_definition[i].type - 1];
+  }
+  return size;
+}
+
+/**
+ * @brief Keeps the last-page record current after a page has been written or updated.
+ *
+ * @param[in,out] SDDS_dataset Pointer to the SDDS_DATASET being appended to.
+ * @param[in] pageOffset File position before the write if it started a new page, or -1.  Only used for
+ *                       ASCII files; binary pages start at their row count.
+ */
+static void SDDS_UpdateAppendInfo(SDDS_DATASET *SDDS_dataset, int64_t pageOffset) {
+  if (!SDDS_dataset->append_layout_offset || SDDS_dataset->rowcount_offset == SDDS_dataset->append_rowcount_offset || SDDS_dataset->rowcount_offset < 0)
+    return;
+  if (SDDS_dataset->layout.data_mode.mode == SDDS_BINARY)
+    pageOffset = SDDS_dataset->rowcount_offset;
+  if (pageOffset >= 0)
+    SDDS_WriteAppendInfo(SDDS_dataset, pageOffset, -1, SDDS_AppendRowSize(SDDS_dataset));
+}
+
+/**
+ * @brief Reads the row count of a page of a file being appended to.
+ *
+ * @param[in] SDDS_dataset Pointer to the SDDS_DATASET being appended to.
+ * @param[in] rowCountOffset Offset of the row count in the file.
+ * @param[out] rows Row count.
+ *
+ * @return Returns 1 on success, 0 on failure with an error message recorded.
+ */
+static int32_t SDDS_ReadAppendRowCount(SDDS_DATASET *SDDS_dataset, int64_t rowCountOffset, int64_t *rows) {
+  FILE *fp;
+  int32_t rows32;
+  char buffer[30];
+
+  fp = SDDS_dataset->layout.fp;
+  if (fseek(fp, rowCountOffset, 0) == -1) {
+    SDDS_SetError("Unable to initialize input--seek failure (SDDS_InitializeAppendToPage)");
+    return 0;
+  }
+  if (SDDS_dataset->layout.data_mode.mode == SDDS_BINARY) {
+    if (fread(&rows32, sizeof(rows32), 1, fp) != 1) {
+      SDDS_SetError("Unable to initialize input--row count not present (SDDS_InitializeAppendToPage)");
+      return 0;
+    }
+    if (SDDS_dataset->swapByteOrder)
+      SDDS_SwapLong(&rows32);
+    if (rows32 == INT32_MIN) {
+      if (fread(rows, sizeof(*rows), 1, fp) != 1) {
+        SDDS_SetError("Unable to initialize input--row count not present (SDDS_InitializeAppendToPage)");
+        return 0;
+      }
+      if (SDDS_dataset->swapByteOrder)
+        SDDS_SwapLong64(rows);
+    } else
+      *rows = rows32;
+  } else {
+    if (!fgets(buffer, 30, fp) || strlen(buffer) != 21 || sscanf(buffer, "%" SCNd64, rows) != 1) {
+#ifdef DEBUG
+      fprintf(stderr, "buffer for row count data: >%s<\n", buffer);
+#endif
+      SDDS_SetError("Unable to initialize input--row count not present or not correct length (SDDS_InitializeAppendToPage)");
+      return 0;
+    }
+  }
+  return 1;
+}
+
+/**
+ * @brief Loads the parameters and arrays of a binary page without reading its rows.
+ *
+ * Leaves the dataset as reading the page would, apart from the rows, so that the parameter values of the
+ * last page carry over to pages written after appending.
+ *
+ * @param[in,out] SDDS_dataset Pointer to the SDDS_DATASET being appended to.
+ * @param[in] rowCountOffset Offset of the row count of the page.
+ *
+ * @return Returns 1 on success, 0 on failure with an error message recorded.
+ */
+static int32_t SDDS_ReadAppendPageHeader(SDDS_DATASET *SDDS_dataset, int64_t rowCountOffset) {
+  int64_t rows;
+
+  if (!SDDS_ReadAppendRowCount(SDDS_dataset, rowCountOffset, &rows))
+    return 0;
+  if (!SDDS_StartPage(SDDS_dataset, 0)) {
+    SDDS_SetError("Unable to initialize input--couldn't start page (SDDS_InitializeAppendToPage)");
+    return 0;
+  }
+  if (SDDS_dataset->swapByteOrder) {
+    if (!SDDS_ReadNonNativeBinaryParameters(SDDS_dataset) || !SDDS_ReadNonNativeBinaryArrays(SDDS_dataset)) {
+      SDDS_SetError("Unable to initialize input--error reading last page (SDDS_InitializeAppendToPage)");
+      return 0;
+    }
+  } else if (!SDDS_ReadBinaryParameters(SDDS_dataset) || !SDDS_ReadBinaryArrays(SDDS_dataset)) {
+    SDDS_SetError("Unable to initialize input--error reading last page (SDDS_InitializeAppendToPage)");
+    return 0;
+  }
+  return 1;
+}
+
+/**
+ * @brief Reads pages from the current file position to the end of the file to find the last page.
+ *
+ * @param[in,out] SDDS_dataset Pointer to the SDDS_DATASET being appended to.
+ * @param[out] firstRowCountOffset Row count offset of the first page read; unchanged if no page is read.
+ * @param[out] pageOffset Offset of the start of the last page read; unchanged if no page is read.
+ * @param[out] rowCountOffset Row count offset of the last page read; unchanged if no page is read.
+ * @param[out] rowsPresent Row count of the last page read.
+ *
+ * @return Returns 1 on success, 0 if a row count could not be read, with an error message recorded.
+ */
+static int32_t SDDS_FindLastPage(SDDS_DATASET *SDDS_dataset, int64_t *firstRowCountOffset, int64_t *pageOffset, int64_t *rowCountOffset, int64_t *rowsPresent) {
+  int64_t start, offset;
+  int32_t pages;
+
+  pages = 0;
+  start = ftell(SDDS_dataset->layout.fp);
+  while (SDDS_ReadPageSparse(SDDS_dataset, 0, 10000, 0, 0) > 0) {
+    *rowCountOffset = SDDS_dataset->rowcount_offset;
+    *pageOffset = start;
+    if (pages++ == 0)
+      *firstRowCountOffset = *rowCountOffset;
+    offset = ftell(SDDS_dataset->layout.fp);
+    if (!SDDS_ReadAppendRowCount(SDDS_dataset, *rowCountOffset, rowsPresent))
+      return 0;
+    fseek(SDDS_dataset->layout.fp, offset, 0);
+    start = offset;
+#ifdef DEBUG
+    fprintf(stderr, "%" PRId64 " rows present\n", *rowsPresent);
+#endif
+  }
+  return 1;
+}
+
 /**
  * @brief Initializes the SDDS dataset for appending data to the last page of an existing file.
  *
@@ -388,6 +602,12 @@ int32_t SDDS_InitializeAppend(SDDS_DATASET *SDDS_dataset, const char *filename)
  * @note
  *   - If @c filename is @c NULL, data will be appended from standard input.
  *   - The function sets internal flags indicating whether the file already contained data prior to appending.
+ *   - The position of the last page is recorded in <filename>.lastpage and kept current as pages are written,
+ *     so that the next call need not read the whole file.  For binary files with fixed-size rows the record
+ *     is checked against the file size and only the parameters and arrays of the last page are read; otherwise
+ *     only the pages from the recorded one onwards are read.  Either way the last page's parameter values are
+ *     loaded, as when the whole file is read.  A missing or stale record falls back to reading the file from
+ *     the start.
  *
  * @warning
  *   - Appending to a compressed file is not supported and will result in an error.
@@ -396,11 +616,11 @@ int32_t SDDS_InitializeAppend(SDDS_DATASET *SDDS_dataset, const char *filename)
 int32_t SDDS_InitializeAppendToPage(SDDS_DATASET *SDDS_dataset, const char *filename, int64_t updateInterval, int64_t *rowsPresentReturn) {
   /*  char *ptr, *datafile, *headerfile; */
   char s[SDDS_MAXLINE];
-  int64_t endOfLayoutOffset, endOfFileOffset, rowCountOffset, offset;
-  int32_t rowsPresent32;
+  int64_t endOfLayoutOffset, endOfFileOffset, rowCountOffset, firstRowCountOffset, pageOffset, dataOffset, rowSize;
+  int64_t infoLayoutOffset, infoPageOffset, infoRowCountOffset, infoDataOffset, infoRowSize;
   int64_t rowsPresent;
   char *extension;
-  int32_t previousBufferSize;
+  int32_t previousBufferSize, errors, infoCurrent;
 
   *rowsPresentReturn = -1;
   if (!SDDS_CheckDataset(SDDS_dataset, "SDDS_InitializeAppendToPage"))
@@ -461,48 +681,56 @@ int32_t SDDS_InitializeAppendToPage(SDDS_DATASET *SDDS_dataset, const char *file
     SDDS_SetError("Unable to initialize input--memory allocation failure (SDDS_InitializeAppendToPage)");
     return 0;
   }
-  rowCountOffset = -1;
+  rowCountOffset = firstRowCountOffset = pageOffset = dataOffset = -1;
   rowsPresent = 0;
+  rowSize = SDDS_AppendRowSize(SDDS_dataset);
+  infoCurrent = 0;
 #ifdef DEBUG
   fprintf(stderr, "Data mode is %s\n", SDDS_data_mode[SDDS_dataset->layout.data_mode.mode - 1]);
 #endif
   SDDS_dataset->pagecount_offset = NULL;
   previousBufferSize = SDDS_SetDefaultIOBufferSize(0);
   if (!SDDS_dataset->layout.data_mode.no_row_counts) {
-    /* read pages to get to the last page */
-    while (SDDS_ReadPageSparse(SDDS_dataset, 0, 10000, 0, 0) > 0) {
-      rowCountOffset = SDDS_dataset->rowcount_offset;
-      offset = ftell(SDDS_dataset->layout.fp);
-      fseek(SDDS_dataset->layout.fp, rowCountOffset, 0);
-
-      if (SDDS_dataset->layout.data_mode.mode == SDDS_BINARY) {
-        fread(&rowsPresent32, sizeof(rowsPresent32), 1, SDDS_dataset->layout.fp);
-        if (SDDS_dataset->swapByteOrder) {
-          SDDS_SwapLong(&rowsPresent32);
-        }
-        if (rowsPresent32 == INT32_MIN) {
-          fread(&rowsPresent, sizeof(rowsPresent), 1, SDDS_dataset->layout.fp);
-          if (SDDS_dataset->swapByteOrder) {
-            SDDS_SwapLong64(&rowsPresent);
-          }
-        } else {
-          rowsPresent = rowsPresent32;
-        }
+    /* start from the last page recorded by a previous append, if the record still fits the file */
+    if (filename && SDDS_ReadAppendInfo(filename, &infoLayoutOffset, &infoPageOffset, &infoRowCountOffset, &infoDataOffset, &infoRowSize) &&
+        infoLayoutOffset == endOfLayoutOffset && infoPageOffset >= endOfLayoutOffset && infoRowCountOffset >= infoPageOffset &&
+        infoRowSize == rowSize && fseek(SDDS_dataset->layout.fp, 0, 2) == 0 && ftell(SDDS_dataset->layout.fp) > infoRowCountOffset) {
+      endOfFileOffset = ftell(SDDS_dataset->layout.fp);
+      errors = SDDS_NumberOfErrors();
+      if (rowSize && infoDataOffset > infoRowCountOffset && SDDS_ReadAppendRowCount(SDDS_dataset, infoRowCountOffset, &rowsPresent) &&
+          rowsPresent >= 0 && infoDataOffset + rowsPresent * rowSize == endOfFileOffset &&
+          SDDS_ReadAppendPageHeader(SDDS_dataset, infoRowCountOffset) && ftell(SDDS_dataset->layout.fp) == infoDataOffset) {
+        /* fixed-size rows that account for the rest of the file: only the page header need be read */
+        rowCountOffset = infoRowCountOffset;
+        SDDS_dataset->page_number = 1;
+        infoCurrent = 1;
       } else {
-        char buffer[30];
-        if (!fgets(buffer, 30, SDDS_dataset->layout.fp) || strlen(buffer) != 21 || sscanf(buffer, "%" SCNd64, &rowsPresent) != 1) {
-#ifdef DEBUG
-          fprintf(stderr, "buffer for row count data: >%s<\n", buffer);
-#endif
-          SDDS_SetError("Unable to initialize input--row count not present or not correct length (SDDS_InitializeAppendToPage)");
-          SDDS_SetDefaultIOBufferSize(previousBufferSize);
-          return 0;
-        }
+        /* read from the recorded page to the end of the file */
+        if (!errors)
+          SDDS_ClearErrors();
+        fseek(SDDS_dataset->layout.fp, infoPageOffset, 0);
+        SDDS_dataset->page_number = 1;
+        if (!SDDS_FindLastPage(SDDS_dataset, &firstRowCountOffset, &pageOffset, &rowCountOffset, &rowsPresent) || firstRowCountOffset != infoRowCountOffset) {
+          rowCountOffset = -1;
+          rowsPresent = 0;
+        } else if (rowCountOffset == infoRowCountOffset && !rowSize)
+          infoCurrent = 1;
+      }
+      if (rowCountOffset == -1) {
+        /* the record is stale */
+        if (!errors)
+          SDDS_ClearErrors();
+        SDDS_dataset->page_number = 0;
+        SDDS_dataset->autoRecovered = 0;
+      }
+    }
+    if (rowCountOffset == -1) {
+      /* read pages to get to the last page */
+      fseek(SDDS_dataset->layout.fp, endOfLayoutOffset, 0);
+      if (!SDDS_FindLastPage(SDDS_dataset, &firstRowCountOffset, &pageOffset, &rowCountOffset, &rowsPresent)) {
+        SDDS_SetDefaultIOBufferSize(previousBufferSize);
+        return 0;
       }
-      fseek(SDDS_dataset->layout.fp, offset, 0);
-#ifdef DEBUG
-      fprintf(stderr, "%" PRId64 " rows present\n", rowsPresent);
-#endif
     }
     if (rowCountOffset == -1) {
       SDDS_SetDefaultIOBufferSize(previousBufferSize);
@@ -540,6 +768,19 @@ int32_t SDDS_InitializeAppendToPage(SDDS_DATASET *SDDS_dataset, const char *file
       SDDS_dataset->writing_page = 1;
     }
   }
+  if (filename && !SDDS_dataset->layout.data_mode.no_row_counts) {
+    /* record the last page so that the next append need not read the file */
+    SDDS_dataset->append_layout_offset = endOfLayoutOffset;
+    if (rowCountOffset == -1)
+      SDDS_dataset->append_rowcount_offset = -1;
+    else if (infoCurrent)
+      SDDS_dataset->append_rowcount_offset = rowCountOffset;
+    else {
+      if (rowSize && endOfFileOffset - rowsPresent * rowSize > rowCountOffset)
+        dataOffset = endOfFileOffset - rowsPresent * rowSize;
+      SDDS_WriteAppendInfo(SDDS_dataset, pageOffset, dataOffset, rowSize);
+    }
+  }
 #ifdef DEBUG
   fprintf(stderr, "rowcount_offset = %" PRId64 ", n_rows_written = %" PRId64 ", first_row_in_mem = %" PRId64 ", last_row_written = %" PRId64 "\n", SDDS_dataset->rowcount_offset, SDDS_dataset->n_rows_written, SDDS_dataset->first_row_in_mem, SDDS_dataset->last_row_written);
 #endif
@@ -1221,6 +1462,7 @@ int32_t SDDS_WriteLayout(SDDS_DATASET *SDDS_dataset) {
  */
 int32_t SDDS_WritePage(SDDS_DATASET *SDDS_dataset) {
   int32_t result;
+  int64_t pageOffset;
 #if SDDS_MPI_IO
   if (SDDS_dataset->parallel_io)
     return SDDS_MPI_WritePage(SDDS_dataset);
@@ -1235,6 +1477,9 @@ int32_t SDDS_WritePage(SDDS_DATASET *SDDS_dataset) {
     SDDS_SetError("Can't write page--file is disconnected (SDDS_WritePage)");
     return 0;
   }
+  pageOffset = -1;
+  if (SDDS_dataset->append_layout_offset && !SDDS_dataset->writing_page && SDDS_dataset->layout.fp)
+    pageOffset = ftell(SDDS_dataset->layout.fp);
   if (SDDS_dataset->layout.data_mode.mode == SDDS_ASCII)
     result = SDDS_WriteAsciiPage(SDDS_dataset);
   else if (SDDS_dataset->layout.data_mode.mode == SDDS_BINARY)
@@ -1243,9 +1488,11 @@ int32_t SDDS_WritePage(SDDS_DATASET *SDDS_dataset) {
     SDDS_SetError("Unable to write page--unknown data mode (SDDS_WritePage)");
     return 0;
   }
-  if (result == 1)
+  if (result == 1) {
     if (SDDS_SyncDataSet(SDDS_dataset) != 0)
       return 0;
+    SDDS_UpdateAppendInfo(SDDS_dataset, pageOffset);
+  }
   return (result);
 }
 
@@ -1284,6 +1531,7 @@ int32_t SDDS_WritePage(SDDS_DATASET *SDDS_dataset) {
  */
 int32_t SDDS_UpdatePage(SDDS_DATASET *SDDS_dataset, uint32_t mode) {
   int32_t result;
+  int64_t pageOffset;
   if (!SDDS_CheckDataset(SDDS_dataset, "SDDS_UpdatePage"))
     return 0;
   if (SDDS_dataset->layout.disconnected) {
@@ -1294,6 +1542,9 @@ int32_t SDDS_UpdatePage(SDDS_DATASET *SDDS_dataset, uint32_t mode) {
     SDDS_SetError("Can't update page--no page started (SDDS_UpdatePage)");
     return 0;
   }
+  pageOffset = -1;
+  if (SDDS_dataset->append_layout_offset && !SDDS_dataset->writing_page && SDDS_dataset->layout.fp)
+    pageOffset = ftell(SDDS_dataset->layout.fp);
   if (SDDS_dataset->layout.data_mode.mode == SDDS_ASCII)
     result = SDDS_UpdateAsciiPage(SDDS_dataset, mode);
   else if (SDDS_dataset->layout.data_mode.mode == SDDS_BINARY)
@@ -1302,9 +1553,11 @@ int32_t SDDS_UpdatePage(SDDS_DATASET *SDDS_dataset, uint32_t mode) {
     SDDS_SetError("Unable to update page--unknown data mode (SDDS_UpdatePage)");
     return 0;
   }
-  if (result == 1)
+  if (result == 1) {
     if (SDDS_SyncDataSet(SDDS_dataset) != 0)
       return 0;
+    SDDS_UpdateAppendInfo(SDDS_dataset, pageOffset);
+  }
   return (result);
 }
 
@@ -1487,7 +1740,7 @@ int32_t SDDS_DefineParameter(SDDS_DATASET *SDDS_dataset, const char *name, const
   }
   if (!SDDS_CopyString(&new_indexed_parameter->name, name))
     return -1;
-  index = binaryInsert((void **)layout->parameter_index, layout->n_parameters, new_indexed_parameter, SDDS_CompareIndexedNames, &duplicate);
+  index = SDDS_InsertIndexedName(layout, layout->parameter_index, &layout->parameter_hash, layout->n_parameters, new_indexed_parameter, &duplicate);
   if (duplicate) {
     sprintf(s, "Parameter %s already exists (SDDS_DefineParameter)", name);
     SDDS_SetError(s);
@@ -1536,6 +1789,7 @@ int32_t SDDS_DefineParameter(SDDS_DATASET *SDDS_dataset, const char *name, const
     definition->memory_number = SDDS_CreateRpnMemory(name, 1);
   else
     definition->memory_number = SDDS_CreateRpnMemory(name, 0);
+  SDDS_AddIndexedName(layout->parameter_hash, new_indexed_parameter, layout->n_parameters);
   layout->n_parameters += 1;
   return (layout->n_parameters - 1);
 }
@@ -1614,7 +1868,7 @@ int32_t SDDS_DefineArray(SDDS_DATASET *SDDS_dataset, const char *name, const cha
 
   if (!SDDS_CopyString(&new_indexed_array->name, name))
     return -1;
-  index = binaryInsert((void **)layout->array_index, layout->n_arrays, new_indexed_array, SDDS_CompareIndexedNames, &duplicate);
+  index = SDDS_InsertIndexedName(layout, layout->array_index, &layout->array_hash, layout->n_arrays, new_indexed_array, &duplicate);
   if (duplicate) {
     sprintf(s, "Array %s already exists (SDDS_DefineArray)", name);
     SDDS_SetError(s);
@@ -1654,6 +1908,7 @@ int32_t SDDS_DefineArray(SDDS_DATASET *SDDS_dataset, const char *name, const cha
     SDDS_SetError("Invalid number of dimensions for array (SDDS_DefineArray)");
     return (-1);
   }
+  SDDS_AddIndexedName(layout->array_hash, new_indexed_array, layout->n_arrays);
   layout->n_arrays += 1;
   return (layout->n_arrays - 1);
 }
@@ -1731,7 +1986,7 @@ int32_t SDDS_DefineColumn(SDDS_DATASET *SDDS_dataset, const char *name, const ch
   }
   if (!SDDS_CopyString(&new_indexed_column->name, name))
     return -1;
-  index = binaryInsert((void **)layout->column_index, layout->n_columns, new_indexed_column, SDDS_CompareIndexedNames, &duplicate);
+  index = SDDS_InsertIndexedName(layout, layout->column_index, &layout->column_hash, layout->n_columns, new_indexed_column, &duplicate);
   if (duplicate) {
     sprintf(s, "Column %s already exists (SDDS_DefineColumn)", name);
     SDDS_SetError(s);
@@ -1797,6 +2052,7 @@ int32_t SDDS_DefineColumn(SDDS_DATASET *SDDS_dataset, const char *name, const ch
   sprintf(s, "&%s", name);
   definition->pointer_number = SDDS_CreateRpnArray(s);
 
+  SDDS_AddIndexedName(layout->column_hash, new_indexed_column, layout->n_columns);
   layout->n_columns += 1;
   return (layout->n_columns - 1);
 }
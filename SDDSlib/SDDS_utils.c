@@ -273,6 +273,8 @@ static int32_t n_errors_max = 0;
 static char **error_description = NULL;
 static char *registeredProgramName = NULL;
 
+static void SDDS_PushError(char *error_text);
+
 /**
  * @brief Registers the executable program name for use in error messages.
  *
@@ -377,8 +379,12 @@ void SDDS_Warning(char *message) {
  * @see SDDS_ClearErrors
  */
 void SDDS_SetError(char *error_text) {
-  SDDS_SetError0(error_text);
-  SDDS_SetError0("\n");
+  /* keep the text and its line break together when several threads record errors (SDDS_CombineFiles) */
+#pragma omp critical(SDDS_ErrorStack)
+  {
+    SDDS_PushError(error_text);
+    SDDS_PushError("\n");
+  }
 }
 
 /**
@@ -393,6 +399,11 @@ void SDDS_SetError(char *error_text) {
  * @see SDDS_SetError
  */
 void SDDS_SetError0(char *error_text) {
+#pragma omp critical(SDDS_ErrorStack)
+  SDDS_PushError(error_text);
+}
+
+static void SDDS_PushError(char *error_text) {
   if (n_errors >= n_errors_max) {
     if (!(error_description = SDDS_Realloc(error_description, (n_errors_max += 10) * sizeof(*error_description)))) {
       fputs("Error trying to allocate additional error description string (SDDS_SetError)\n", stderr);
@@ -1293,6 +1304,213 @@ int SDDS_CompareIndexedNamesPtr(const void *s1, const void *s2) {
   return strcmp((*((SORTED_INDEX **)s1))->name, (*((SORTED_INDEX **)s2))->name);
 }
 
+static uint32_t SDDS_HashName(const char *name) {
+  /* FNV-1a */
+  uint32_t hash = 2166136261U;
+  while (*name) {
+    hash ^= (unsigned char)*name++;
+    hash *= 16777619U;
+  }
+  return hash;
+}
+
+static void SDDS_InsertHashedName(SDDS_NAME_HASH *hash, SORTED_INDEX *entry) {
+  uint32_t mask, i;
+  mask = hash->size - 1;
+  i = SDDS_HashName(entry->name) & mask;
+  while (hash->slot[i])
+    i = (i + 1) & mask;
+  hash->slot[i] = entry;
+  hash->entries++;
+}
+
+/**
+ * @brief Rebuilds a name hash from the first @p n entries of a sorted index.
+ *
+ * The table is sized to at most one-quarter full so that subsequent definitions
+ * can be added incrementally by SDDS_AddIndexedName() before another rebuild is needed.
+ *
+ * @param[in,out] hash   Address of the hash pointer; the hash is allocated if needed.
+ * @param[in]     sorted Sorted index array (e.g., `layout.column_index`).
+ * @param[in]     n      Number of valid entries in @p sorted.
+ *
+ * @return 1 on success, 0 on allocation failure.
+ */
+static int32_t SDDS_BuildNameHash(SDDS_NAME_HASH **hash, SORTED_INDEX **sorted, int32_t n) {
+  uint32_t size;
+  int32_t i;
+
+  if (!*hash && !(*hash = (SDDS_NAME_HASH *)calloc(1, sizeof(**hash))))
+    return 0;
+  for (size = 16; size < 4 * (uint32_t)n; size <<= 1)
+    ;
+  if (size != (*hash)->size) {
+    free((*hash)->slot);
+    if (!((*hash)->slot = (SORTED_INDEX **)malloc(sizeof(*(*hash)->slot) * size))) {
+      (*hash)->size = 0;
+      (*hash)->entries = -1;
+      return 0;
+    }
+    (*hash)->size = size;
+  }
+  memset((*hash)->slot, 0, sizeof(*(*hash)->slot) * size);
+  (*hash)->entries = 0;
+  for (i = 0; i < n; i++)
+    SDDS_InsertHashedName(*hash, sorted[i]);
+  return 1;
+}
+
+/**
+ * @brief Looks up a name in a sorted index, using its hash when possible.
+ *
+ * The hash mirrors the first @p n entries of @p sorted and is rebuilt if the
+ * number of entries it holds does not match.  If the hash cannot be built, the
+ * sorted index is searched with a binary search instead.
+ *
+ * @param[in,out] hash   Address of the hash pointer for this index.
+ * @param[in]     sorted Sorted index array.
+ * @param[in]     n      Number of valid entries in @p sorted.
+ * @param[in]     name   Name to look up.
+ *
+ * @return The `index` member of the matching entry, or -1 if not found.
+ */
+int32_t SDDS_LookupIndexedName(SDDS_NAME_HASH **hash, SORTED_INDEX **sorted, int32_t n, char *name) {
+  SORTED_INDEX key, *entry;
+  uint32_t mask, i;
+  int64_t j;
+
+  if (n <= 0)
+    return -1;
+  if ((!*hash || (*hash)->entries != n) && !SDDS_BuildNameHash(hash, sorted, n)) {
+    key.name = name;
+    if ((j = binaryIndexSearch((void **)sorted, n, &key, SDDS_CompareIndexedNames, 0)) < 0)
+      return -1;
+    return sorted[j]->index;
+  }
+  mask = (*hash)->size - 1;
+  i = SDDS_HashName(name) & mask;
+  while ((entry = (*hash)->slot[i])) {
+    if (strcmp(entry->name, name) == 0)
+      return entry->index;
+    i = (i + 1) & mask;
+  }
+  return -1;
+}
+
+/**
+ * @brief Adds a newly defined entry to a name hash.
+ *
+ * If the hash is current for the @p n entries that preceded this one and has room,
+ * the entry is inserted directly; otherwise the hash is marked stale and rebuilt on
+ * the next lookup.
+ *
+ * @param[in,out] hash  Hash for the index, may be NULL.
+ * @param[in]     entry The new sorted index entry.
+ * @param[in]     n     Number of entries in the index before this one was added.
+ */
+void SDDS_AddIndexedName(SDDS_NAME_HASH *hash, SORTED_INDEX *entry, int32_t n) {
+  if (!hash)
+    return;
+  if (hash->entries != n || 2 * ((uint32_t)n + 1) > hash->size) {
+    hash->entries = -1;
+    return;
+  }
+  SDDS_InsertHashedName(hash, entry);
+}
+
+/**
+ * @brief Inserts a new entry into a layout name index.
+ *
+ * Normally the entry is placed in sorted position.  While `layout->index_deferred` is set
+ * (i.e., while a header is being read), the entry is appended and duplicates are detected
+ * through the name hash, so that defining n names costs O(n) rather than O(n^2); the index
+ * is sorted once afterwards by SDDS_SortLayoutIndexes().
+ *
+ * @param[in]     layout    Layout that owns the index.
+ * @param[in,out] sorted    Index array, with room for @p n + 1 entries.
+ * @param[in,out] hash      Address of the hash pointer for this index.
+ * @param[in]     n         Number of entries in the index.
+ * @param[in]     entry     Entry to insert.
+ * @param[out]    duplicate Set to 1 if the name is already present, otherwise 0.
+ *
+ * @return Position of the entry in @p sorted (or of the existing entry, if a duplicate).
+ */
+int32_t SDDS_InsertIndexedName(SDDS_LAYOUT *layout, SORTED_INDEX **sorted, SDDS_NAME_HASH **hash, int32_t n, SORTED_INDEX *entry, int32_t *duplicate) {
+  if (!layout->index_deferred)
+    return binaryInsert((void **)sorted, n, entry, SDDS_CompareIndexedNames, duplicate);
+  if ((*duplicate = SDDS_LookupIndexedName(hash, sorted, n, entry->name) >= 0))
+    return n;
+  sorted[n] = entry;
+  return n;
+}
+
+/**
+ * @brief Sorts the column, parameter and array name indexes after deferred insertion.
+ *
+ * Clears `layout.index_deferred`.  Duplicate names that slipped past the hash
+ * (only possible if the hash could not be allocated) are reported here.
+ *
+ * @param[in,out] SDDS_dataset Dataset whose layout indexes are to be sorted.
+ *
+ * @return 1 on success, 0 if duplicate names were found.
+ */
+int32_t SDDS_SortLayoutIndexes(SDDS_DATASET *SDDS_dataset) {
+  SDDS_LAYOUT *layout;
+  SORTED_INDEX **sorted[3];
+  int32_t n[3], i, j;
+  static char *kind[3] = {"column", "parameter", "array"};
+  char s[SDDS_MAXLINE];
+
+  layout = &SDDS_dataset->layout;
+  if (!layout->index_deferred)
+    return 1;
+  layout->index_deferred = 0;
+  sorted[0] = layout->column_index;
+  n[0] = layout->n_columns;
+  sorted[1] = layout->parameter_index;
+  n[1] = layout->n_parameters;
+  sorted[2] = layout->array_index;
+  n[2] = layout->n_arrays;
+  for (i = 0; i < 3; i++) {
+    if (n[i] < 2)
+      continue;
+    qsort((char *)sorted[i], n[i], sizeof(*sorted[i]), SDDS_CompareIndexedNamesPtr);
+    for (j = 1; j < n[i]; j++)
+      if (strcmp(sorted[i][j - 1]->name, sorted[i][j]->name) == 0) {
+        snprintf(s, sizeof(s), "Duplicate %s name %s (SDDS_SortLayoutIndexes)", kind[i], sorted[i][j]->name);
+        SDDS_SetError(s);
+        return 0;
+      }
+  }
+  return 1;
+}
+
+/**
+ * @brief Marks a name hash as stale so that it is rebuilt on the next lookup.
+ *
+ * Must be called whenever entries of the corresponding sorted index are renamed or removed.
+ *
+ * @param[in,out] hash Hash for the index, may be NULL.
+ */
+void SDDS_InvalidateNameHash(SDDS_NAME_HASH *hash) {
+  if (hash)
+    hash->entries = -1;
+}
+
+/**
+ * @brief Frees a name hash and sets the pointer to NULL.
+ *
+ * @param[in,out] hash Address of the hash pointer.
+ */
+void SDDS_FreeNameHash(SDDS_NAME_HASH **hash) {
+  if (*hash) {
+    if ((*hash)->slot)
+      free((*hash)->slot);
+    free(*hash);
+    *hash = NULL;
+  }
+}
+
 /**
  * @brief Retrieves the index of a named column in the SDDS dataset.
  *
@@ -1307,19 +1525,13 @@ int SDDS_CompareIndexedNamesPtr(const void *s1, const void *s2) {
  * @see SDDS_SetError
  */
 int32_t SDDS_GetColumnIndex(SDDS_DATASET *SDDS_dataset, char *name) {
-  int64_t i;
-  SORTED_INDEX key;
-
   if (!SDDS_CheckDataset(SDDS_dataset, "SDDS_GetColumnIndex"))
     return (-1);
   if (!name) {
     SDDS_SetError("Unable to get column index--name is NULL (SDDS_GetColumnIndex)");
     return (-1);
   }
-  key.name = name;
-  if ((i = binaryIndexSearch((void **)SDDS_dataset->layout.column_index, SDDS_dataset->layout.n_columns, &key, SDDS_CompareIndexedNames, 0)) < 0)
-    return -1;
-  return SDDS_dataset->layout.column_index[i]->index;
+  return SDDS_LookupIndexedName(&SDDS_dataset->layout.column_hash, SDDS_dataset->layout.column_index, SDDS_dataset->layout.n_columns, name);
 }
 
 /**
@@ -1336,19 +1548,13 @@ int32_t SDDS_GetColumnIndex(SDDS_DATASET *SDDS_dataset, char *name) {
  * @see SDDS_SetError
  */
 int32_t SDDS_GetParameterIndex(SDDS_DATASET *SDDS_dataset, char *name) {
-  int32_t i;
-  SORTED_INDEX key;
-
   if (!SDDS_CheckDataset(SDDS_dataset, "SDDS_GetParameterIndex"))
     return (-1);
   if (!name) {
     SDDS_SetError("Unable to get parameter index--name is NULL (SDDS_GetParameterIndex)");
     return (-1);
   }
-  key.name = name;
-  if ((i = binaryIndexSearch((void **)SDDS_dataset->layout.parameter_index, SDDS_dataset->layout.n_parameters, &key, SDDS_CompareIndexedNames, 0)) < 0)
-    return -1;
-  return SDDS_dataset->layout.parameter_index[i]->index;
+  return SDDS_LookupIndexedName(&SDDS_dataset->layout.parameter_hash, SDDS_dataset->layout.parameter_index, SDDS_dataset->layout.n_parameters, name);
 }
 
 /**
@@ -1365,19 +1571,13 @@ int32_t SDDS_GetParameterIndex(SDDS_DATASET *SDDS_dataset, char *name) {
  * @see SDDS_SetError
  */
 int32_t SDDS_GetArrayIndex(SDDS_DATASET *SDDS_dataset, char *name) {
-  int32_t i;
-  SORTED_INDEX key;
-
   if (!SDDS_CheckDataset(SDDS_dataset, "SDDS_GetArrayIndex"))
     return (-1);
   if (!name) {
     SDDS_SetError("Unable to get array index--name is NULL (SDDS_GetArrayIndex)");
     return (-1);
   }
-  key.name = name;
-  if ((i = binaryIndexSearch((void **)SDDS_dataset->layout.array_index, SDDS_dataset->layout.n_arrays, &key, SDDS_CompareIndexedNames, 0)) < 0)
-    return -1;
-  return SDDS_dataset->layout.array_index[i]->index;
+  return SDDS_LookupIndexedName(&SDDS_dataset->layout.array_hash, SDDS_dataset->layout.array_index, SDDS_dataset->layout.n_arrays, name);
 }
 
 /**
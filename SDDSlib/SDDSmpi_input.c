@@ -24,6 +24,7 @@
 #include "SDDS.h"
 #include "SDDS_internal.h"
 #include "scan.h"
+#include <stddef.h>
 
 #if defined(_WIN32)
 #  include <fcntl.h>
@@ -76,7 +77,7 @@ typedef struct
 {
   int32_t n_columns, n_parameters, n_associates, n_arrays, description_len, contents_len, version, layout_offset, filename_len;
   int32_t mode, lines_per_row, no_row_counts, fixed_row_count, fsync_data, additional_header_lines; /*data_mode definition */
-  short layout_written, disconnected, gzipFile, lzmaFile, popenUsed, swapByteOrder, column_memory_mode;
+  short layout_written, disconnected, gzipFile, lzmaFile, popenUsed, swapByteOrder, column_memory_mode, column_major;
   uint32_t byteOrderDeclared;
   int32_t depth;
   int32_t data_command_seen;
@@ -140,6 +141,61 @@ int32_t SDDS_MPI_ReadPage(SDDS_DATASET *SDDS_dataset) {
   }
 }
 
+/**
+ * @brief Reads every sparse_interval-th row of a page, starting at row sparse_offset, using MPI.
+ *
+ * The selected rows are divided among the processors and each processor reads only its share
+ * with a single collective read, so sampling a page costs I/O in proportion to the sample.
+ * Only fixed-width binary pages (no string columns) can be read this way.
+ *
+ * @param SDDS_dataset Pointer to the SDDS_DATASET structure representing the dataset.
+ * @param sparse_interval Interval between the rows read; values below 2 read every row.
+ * @param sparse_offset Number of initial rows to skip.
+ * @return Page number on success, -1 at end-of-file, 0 on error.
+ *
+ * @sa SDDS_ReadPageSparse, SDDS_MPI_ReadSelectedRows
+ */
+int32_t SDDS_MPI_ReadPageSparse(SDDS_DATASET *SDDS_dataset, int64_t sparse_interval, int64_t sparse_offset) {
+  MPI_DATASET *MPI_dataset;
+  int32_t retval;
+
+  if (!SDDS_CheckDataset(SDDS_dataset, "SDDS_MPI_ReadPageSparse"))
+    return (0);
+  MPI_dataset = SDDS_dataset->MPI_dataset;
+  MPI_dataset->sparse_interval = sparse_interval;
+  MPI_dataset->sparse_offset = sparse_offset;
+  MPI_dataset->last_rows = 0;
+  retval = SDDS_MPI_ReadPage(SDDS_dataset);
+  MPI_dataset->sparse_interval = MPI_dataset->sparse_offset = 0;
+  return retval;
+}
+
+/**
+ * @brief Reads the last rows of a page using MPI.
+ *
+ * The last last_rows rows (or the whole page, if it is shorter) are divided among the processors
+ * and read with a single collective read, as in SDDS_MPI_ReadPageSparse.
+ *
+ * @param SDDS_dataset Pointer to the SDDS_DATASET structure representing the dataset.
+ * @param last_rows Number of rows to read from the end of the page.
+ * @return Page number on success, -1 at end-of-file, 0 on error.
+ *
+ * @sa SDDS_ReadPageLastRows, SDDS_MPI_ReadSelectedRows
+ */
+int32_t SDDS_MPI_ReadPageLastRows(SDDS_DATASET *SDDS_dataset, int64_t last_rows) {
+  MPI_DATASET *MPI_dataset;
+  int32_t retval;
+
+  if (!SDDS_CheckDataset(SDDS_dataset, "SDDS_MPI_ReadPageLastRows"))
+    return (0);
+  MPI_dataset = SDDS_dataset->MPI_dataset;
+  MPI_dataset->sparse_interval = MPI_dataset->sparse_offset = 0;
+  MPI_dataset->last_rows = last_rows;
+  retval = SDDS_MPI_ReadPage(SDDS_dataset);
+  MPI_dataset->last_rows = 0;
+  return retval;
+}
+
 /**
  * @brief Broadcasts the layout of an SDDS dataset to all MPI processes.
  *
@@ -176,16 +232,20 @@ int32_t SDDS_MPI_BroadcastLayout(SDDS_DATASET *SDDS_dataset) {
   ELEMENT_DEF *column = NULL, *parameter = NULL, *array = NULL;
   ASSOCIATE_DEF *associate = NULL;
   OTHER_DEF other;
-  MPI_Datatype elementType, otherType, oldtypes[4], associateType;
-  int blockcounts[4];
+  MPI_Datatype elementType, otherType, oldtypes[6], associateType;
+  int blockcounts[6];
   /* MPI_Aint type used to be consistent with syntax of */
   /* MPI_Type_extent routine */
-  MPI_Aint offsets[4], int_ext, short_ext, uint_ext;
-  MPI_Aint int_lb, short_lb, uint_lb;
+  MPI_Aint offsets[6], int_ext;
+  MPI_Aint int_lb;
+  MPI_Comm node_comm = MPI_COMM_NULL, bcast_comm;
+  MPI_Win window = MPI_WIN_NULL;
+  MPI_Aint shared_size;
+  char *shared_base = NULL;
+  int node_rank = 0, disp_unit;
+  int32_t status = 1;
 
   MPI_Type_get_extent(MPI_INT, &int_lb, &int_ext);
-  MPI_Type_get_extent(MPI_UNSIGNED, &uint_lb, &uint_ext);
-  MPI_Type_get_extent(MPI_SHORT, &short_lb, &short_ext);
 
   layout = &(SDDS_dataset->layout);
   /*commit element type */
@@ -199,25 +259,33 @@ int32_t SDDS_MPI_BroadcastLayout(SDDS_DATASET *SDDS_dataset) {
   MPI_Type_create_struct(2, blockcounts, offsets, oldtypes, &elementType);
   MPI_Type_commit(&elementType);
 
-  /*commit other type */
-  offsets[0] = 0;
+  /*commit other type; the offsets follow the structure's padding */
+  offsets[0] = offsetof(OTHER_DEF, n_columns);
   oldtypes[0] = MPI_INT;
   blockcounts[0] = 15;
 
-  offsets[1] = 15 * int_ext;
+  offsets[1] = offsetof(OTHER_DEF, layout_written);
   oldtypes[1] = MPI_SHORT;
-  blockcounts[1] = 4;
+  blockcounts[1] = 8;
 
-  blockcounts[2] = 1;
+  offsets[2] = offsetof(OTHER_DEF, byteOrderDeclared);
   oldtypes[2] = MPI_UNSIGNED;
-  offsets[2] = offsets[1] + 4 * short_ext;
+  blockcounts[2] = 1;
+
+  offsets[3] = offsetof(OTHER_DEF, depth);
+  oldtypes[3] = MPI_INT;
+  blockcounts[3] = 2;
+
+  offsets[4] = offsetof(OTHER_DEF, commentFlags);
+  oldtypes[4] = MPI_UNSIGNED;
+  blockcounts[4] = 1;
 
-  blockcounts[3] = 1024 + 1024 + 1024;
-  oldtypes[3] = MPI_CHAR;
-  offsets[3] = offsets[2] + 1 * uint_ext;
+  offsets[5] = offsetof(OTHER_DEF, description);
+  oldtypes[5] = MPI_CHAR;
+  blockcounts[5] = 1024 + 1024 + 1024;
 
   /* Now define structured type and commit it */
-  MPI_Type_create_struct(4, blockcounts, offsets, oldtypes, &otherType);
+  MPI_Type_create_struct(6, blockcounts, offsets, oldtypes, &otherType);
   MPI_Type_commit(&otherType);
 
   if (MPI_dataset->myid == 0) {
@@ -242,6 +310,7 @@ int32_t SDDS_MPI_BroadcastLayout(SDDS_DATASET *SDDS_dataset) {
     other.no_row_counts = layout->data_mode.no_row_counts;
     other.fixed_row_count = layout->data_mode.fixed_row_count;
     other.column_memory_mode = layout->data_mode.column_memory_mode;
+    other.column_major = layout->data_mode.column_major;
     other.fsync_data = layout->data_mode.fsync_data;
     other.additional_header_lines = layout->data_mode.additional_header_lines;
     other.description_len = other.contents_len = other.filename_len = 0;
@@ -270,14 +339,52 @@ int32_t SDDS_MPI_BroadcastLayout(SDDS_DATASET *SDDS_dataset) {
   /* broadcaset the layout other to other processors */
   MPI_Bcast(&other, 1, otherType, 0, MPI_dataset->comm);
   MPI_Type_free(&otherType);
-  if (other.n_columns)
-    column = malloc(sizeof(*column) * other.n_columns);
-  if (other.n_parameters)
-    parameter = malloc(sizeof(*parameter) * other.n_parameters);
-  if (other.n_arrays)
-    array = malloc(sizeof(*array) * other.n_arrays);
-  if (other.n_associates)
-    associate = malloc(sizeof(*associate) * other.n_associates);
+  bcast_comm = MPI_dataset->comm;
+  if (MPI_dataset->shared_layout) {
+    /* keep one copy of the definitions per node, in memory shared by the node's processors;
+       only the first processor of each node takes part in the broadcast */
+    MPI_Comm_split_type(MPI_dataset->comm, MPI_COMM_TYPE_SHARED, MPI_dataset->myid, MPI_INFO_NULL, &node_comm);
+    MPI_Comm_rank(node_comm, &node_rank);
+    MPI_Comm_split(MPI_dataset->comm, node_rank == 0 ? 0 : MPI_UNDEFINED, MPI_dataset->myid, &bcast_comm);
+    shared_size = sizeof(ELEMENT_DEF) * ((MPI_Aint)other.n_columns + other.n_parameters + other.n_arrays) + sizeof(ASSOCIATE_DEF) * (MPI_Aint)other.n_associates;
+    if (MPI_Win_allocate_shared(node_rank == 0 ? shared_size : 0, 1, MPI_INFO_NULL, node_comm, &shared_base, &window) != MPI_SUCCESS) {
+      SDDS_SetError("Unable to allocate shared memory for layout (SDDS_MPI_BroadcastLayout)");
+      window = MPI_WIN_NULL;
+      status = 0;
+    }
+    /* every processor must give up if any node could not allocate its window */
+    MPI_Allreduce(MPI_IN_PLACE, &status, 1, MPI_INT32_T, MPI_MIN, MPI_dataset->comm);
+    if (!status) {
+      if (window != MPI_WIN_NULL)
+        MPI_Win_free(&window);
+      if (bcast_comm != MPI_COMM_NULL)
+        MPI_Comm_free(&bcast_comm);
+      MPI_Comm_free(&node_comm);
+      MPI_Type_free(&elementType);
+      SDDS_SetError("Unable to share layout (SDDS_MPI_BroadcastLayout)");
+      return 0;
+    }
+    if (node_rank)
+      MPI_Win_shared_query(window, 0, &shared_size, &disp_unit, &shared_base);
+    MPI_Win_lock_all(MPI_MODE_NOCHECK, window);
+    if (other.n_columns)
+      column = (ELEMENT_DEF *)shared_base;
+    if (other.n_parameters)
+      parameter = (ELEMENT_DEF *)shared_base + other.n_columns;
+    if (other.n_arrays)
+      array = (ELEMENT_DEF *)shared_base + other.n_columns + other.n_parameters;
+    if (other.n_associates)
+      associate = (ASSOCIATE_DEF *)((ELEMENT_DEF *)shared_base + other.n_columns + other.n_parameters + other.n_arrays);
+  } else {
+    if (other.n_columns)
+      column = malloc(sizeof(*column) * other.n_columns);
+    if (other.n_parameters)
+      parameter = malloc(sizeof(*parameter) * other.n_parameters);
+    if (other.n_arrays)
+      array = malloc(sizeof(*array) * other.n_arrays);
+    if (other.n_associates)
+      associate = malloc(sizeof(*associate) * other.n_associates);
+  }
   if (MPI_dataset->myid == 0) {
     /*fill elements */
     for (i = 0; i < other.n_columns; i++) {
@@ -426,6 +533,7 @@ int32_t SDDS_MPI_BroadcastLayout(SDDS_DATASET *SDDS_dataset) {
     layout->data_mode.fixed_row_count = other.fixed_row_count;
     layout->data_mode.fsync_data = other.fsync_data;
     layout->data_mode.column_memory_mode = other.column_memory_mode;
+    layout->data_mode.column_major = other.column_major;
     layout->data_mode.additional_header_lines = other.additional_header_lines;
     if (other.description_len)
       SDDS_CopyString(&layout->description, other.description);
@@ -433,14 +541,16 @@ int32_t SDDS_MPI_BroadcastLayout(SDDS_DATASET *SDDS_dataset) {
       SDDS_CopyString(&layout->contents, other.contents);
     SDDS_dataset->swapByteOrder = other.swapByteOrder;
   }
-  if (other.n_columns)
-    MPI_Bcast(column, other.n_columns, elementType, 0, MPI_dataset->comm);
-  if (other.n_parameters)
-    MPI_Bcast(parameter, other.n_parameters, elementType, 0, MPI_dataset->comm);
-  if (other.n_arrays)
-    MPI_Bcast(array, other.n_arrays, elementType, 0, MPI_dataset->comm);
+  if (bcast_comm != MPI_COMM_NULL) {
+    if (other.n_columns)
+      MPI_Bcast(column, other.n_columns, elementType, 0, bcast_comm);
+    if (other.n_parameters)
+      MPI_Bcast(parameter, other.n_parameters, elementType, 0, bcast_comm);
+    if (other.n_arrays)
+      MPI_Bcast(array, other.n_arrays, elementType, 0, bcast_comm);
+  }
   MPI_Type_free(&elementType);
-  if (other.n_associates) {
+  if (other.n_associates && bcast_comm != MPI_COMM_NULL) {
     /* create and commit associate type */
     offsets[0] = 0;
     oldtypes[0] = MPI_INT;
@@ -452,9 +562,15 @@ int32_t SDDS_MPI_BroadcastLayout(SDDS_DATASET *SDDS_dataset) {
 
     MPI_Type_create_struct(2, blockcounts, offsets, oldtypes, &associateType);
     MPI_Type_commit(&associateType);
-    MPI_Bcast(associate, other.n_associates, associateType, 0, MPI_dataset->comm);
+    MPI_Bcast(associate, other.n_associates, associateType, 0, bcast_comm);
     MPI_Type_free(&associateType);
   }
+  if (MPI_dataset->shared_layout) {
+    /* make the node leader's copy visible to the rest of the node */
+    MPI_Win_sync(window);
+    MPI_Barrier(node_comm);
+    MPI_Win_sync(window);
+  }
   if (MPI_dataset->myid) {
     for (i = 0; i < other.n_columns; i++) {
       symbol = units = description = format_string = NULL;
@@ -468,7 +584,8 @@ int32_t SDDS_MPI_BroadcastLayout(SDDS_DATASET *SDDS_dataset) {
         SDDS_CopyString(&symbol, column[i].symbol);
       if (SDDS_DefineColumn(SDDS_dataset, column[i].name, symbol, units, description, format_string, column[i].type, column[i].field_length) < 0) {
         SDDS_SetError("Unable to define column (SDDS_MPI_BroadcastLayout)");
-        return (0);
+        status = 0;
+        goto release;
       }
       if (units)
         free(units);
@@ -493,7 +610,8 @@ int32_t SDDS_MPI_BroadcastLayout(SDDS_DATASET *SDDS_dataset) {
         SDDS_CopyString(&fixed_value, parameter[i].fixed_value);
       if (SDDS_DefineParameter(SDDS_dataset, parameter[i].name, symbol, units, description, format_string, parameter[i].type, fixed_value) < 0) {
         SDDS_SetError("Unable to define parameter (SDDS_MPI_BroadcastLayout)");
-        return (0);
+        status = 0;
+        goto release;
       }
       if (units)
         free(units);
@@ -507,9 +625,10 @@ int32_t SDDS_MPI_BroadcastLayout(SDDS_DATASET *SDDS_dataset) {
         free(fixed_value);
     }
     for (i = 0; i < other.n_arrays; i++) {
-      if (SDDS_DefineArray(SDDS_dataset, array[i].name, array[i].symbol, array[i].units, array[i].description, array[i].format_string, array[i].type, array[i].field_length, array[i].dimensions, array[i].group_name) < 0) {
+      if (SDDS_DefineArray(SDDS_dataset, array[i].name, array[i].symbol_len ? array[i].symbol : NULL, array[i].units_len ? array[i].units : NULL, array[i].description_len ? array[i].description : NULL, array[i].format_string_len ? array[i].format_string : NULL, array[i].type, array[i].field_length, array[i].dimensions, array[i].group_name_len ? array[i].group_name : NULL) < 0) {
         SDDS_SetError("Unable to define array (SDDS_BroadcastLayout)");
-        return (0);
+        status = 0;
+        goto release;
       }
     }
     for (i = 0; i < other.n_associates; i++) {
@@ -524,7 +643,8 @@ int32_t SDDS_MPI_BroadcastLayout(SDDS_DATASET *SDDS_dataset) {
         SDDS_CopyString(&contents, associate[i].contents);
       if (SDDS_DefineAssociate(SDDS_dataset, associate[i].name, filename, path, description, contents, associate[i].sdds) < 0) {
         SDDS_SetError("Unable to define associate (SDDS_MPI_BroadcastLayout)");
-        return (0);
+        status = 0;
+        goto release;
       }
       if (description)
         free(description);
@@ -537,19 +657,35 @@ int32_t SDDS_MPI_BroadcastLayout(SDDS_DATASET *SDDS_dataset) {
     }
     if (!SDDS_SaveLayout(SDDS_dataset)) {
       SDDS_SetError("Unable to save layout (SDDS_BroadcastLayout)");
-      return (0);
+      status = 0;
+      goto release;
     }
   }
-  if (column)
-    free(column);
-  if (array)
-    free(array);
-  if (parameter)
-    free(parameter);
-  if (associate)
-    free(associate);
+release:
+  if (MPI_dataset->shared_layout) {
+    /* freeing the window is collective over the node, so it is done even if a definition failed */
+    MPI_Win_unlock_all(window);
+    MPI_Win_free(&window);
+    if (bcast_comm != MPI_COMM_NULL)
+      MPI_Comm_free(&bcast_comm);
+    MPI_Comm_free(&node_comm);
+    MPI_Allreduce(MPI_IN_PLACE, &status, 1, MPI_INT32_T, MPI_MIN, MPI_dataset->comm);
+  } else {
+    if (column)
+      free(column);
+    if (array)
+      free(array);
+    if (parameter)
+      free(parameter);
+    if (associate)
+      free(associate);
+  }
   column = array = parameter = NULL;
   associate = NULL;
+  if (!status) {
+    SDDS_SetError("Unable to define layout (SDDS_MPI_BroadcastLayout)");
+    return 0;
+  }
   MPI_dataset->file_offset = other.layout_offset;
   return 1;
 }
@@ -587,12 +723,13 @@ int32_t SDDS_MPI_BroadcastLayout(SDDS_DATASET *SDDS_dataset) {
  * - Sets the dataset mode to read-only and initializes file offsets for sequential reading.
  * - Closes the file pointer after reading the layout.
  * - Broadcasts the layout information to all MPI processes if `MASTER_READTITLE_ONLY`
- *   is defined.
+ *   is defined or a shared layout was requested with SDDS_MPI_SetSharedLayout.
  * - Opens the MPI file for parallel reading and retrieves the file size and column offsets.
  *
  * @note
  * - The function assumes that only one page of data is present in the input file.
  * - If `MASTER_READTITLE_ONLY` is defined, only the root process reads the title.
+ * - With a shared layout only the root process reads the header; see SDDS_MPI_SetSharedLayout.
  *
  * @sa SDDS_CheckDataset, SDDS_SetError, SDDS_CopyString, SDDS_ReadLayout,
  *     SDDS_GZipReadLayout, SDDS_LZMAReadLayout, SDDS_SaveLayout,
@@ -604,6 +741,8 @@ int32_t SDDS_MPI_InitializeInput(SDDS_DATASET *SDDS_dataset, char *filename) {
 
 #if defined(MASTER_READTITLE_ONLY)
   if (MPI_dataset->myid == 0)
+#else
+  if (MPI_dataset->myid == 0 || !MPI_dataset->shared_layout)
 #endif
   {
     /*  char *ptr, *datafile, *headerfile; */
@@ -720,7 +859,18 @@ int32_t SDDS_MPI_InitializeInput(SDDS_DATASET *SDDS_dataset, char *filename) {
   if (!SDDS_MPI_BroadcastLayout(SDDS_dataset))
     return 0;
 #else
-  MPI_dataset->file_offset = SDDS_dataset->pagecount_offset[0];
+  if (MPI_dataset->shared_layout) {
+    if (!SDDS_MPI_BroadcastLayout(SDDS_dataset))
+      return 0;
+    if (MPI_dataset->myid) {
+      if (SDDS_dataset->layout.n_columns && !SDDS_AllocateColumnFlags(SDDS_dataset)) {
+        SDDS_SetError("Unable to initialize input--memory allocation failure (SDDS_MPI_InitializeInput)");
+        return 0;
+      }
+      SDDS_dataset->mode = SDDS_READMODE;
+    }
+  } else
+    MPI_dataset->file_offset = SDDS_dataset->pagecount_offset[0];
 #endif
 
   if (!SDDS_MPI_File_Open(MPI_dataset, filename, SDDS_MPI_READ_ONLY)) {
@@ -738,6 +888,34 @@ int32_t SDDS_MPI_InitializeInput(SDDS_DATASET *SDDS_dataset, char *filename) {
   return 1;
 }
 
+/**
+ * @brief Select whether SDDS_MPI_InitializeInput shares one copy of the layout per node.
+ *
+ * By default every processor opens the file and parses the header itself.  With a shared layout
+ * only the root processor parses the header; the definitions are broadcast once to the first
+ * processor of each node into an MPI-3 shared-memory window, and the other processors of the node
+ * build their layout from that window instead of from their own copy of the broadcast.
+ * Must be called after SDDS_MPI_Setup and before SDDS_MPI_InitializeInput.
+ *
+ * Only the broadcast definitions are shared, and only while the layout is being set up.  Every
+ * processor still decodes a private SDDS_LAYOUT from the window, since the rest of the library
+ * updates the layout in place, so the memory held by the layouts is not reduced.  The parameter and
+ * array data of each page are still broadcast to every processor by SDDS_MPI_BroadcastTitleData.
+ * If any node cannot allocate its window, SDDS_MPI_InitializeInput fails on every processor.
+ *
+ * @param SDDS_dataset Pointer to the SDDS_DATASET structure.
+ * @param shared Nonzero to share the layout within each node, zero for per-processor parsing.
+ * @return 1 on success, 0 on failure.
+ */
+int32_t SDDS_MPI_SetSharedLayout(SDDS_DATASET *SDDS_dataset, short shared) {
+  if (!SDDS_dataset->MPI_dataset) {
+    SDDS_SetError("Dataset is not set up for parallel I/O (SDDS_MPI_SetSharedLayout)");
+    return 0;
+  }
+  SDDS_dataset->MPI_dataset->shared_layout = shared ? 1 : 0;
+  return 1;
+}
+
 /**
  * @brief Initializes an SDDS dataset for input by searching the provided search path using MPI.
  *
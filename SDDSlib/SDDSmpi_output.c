@@ -396,6 +396,8 @@ int32_t SDDS_MPI_WriteAsciiString(SDDS_DATASET *SDDS_dataset, char *string) {
   fBuffer = &(SDDS_dataset->fBuffer);
   targetSize = strlen(string) * sizeof(char);
 
+  if (SDDS_dataset->layout.gzipFile || SDDS_dataset->layout.lzmaFile)
+    return SDDS_MPI_StageCompressedOutput(SDDS_dataset, string, targetSize);
   if (!fBuffer->bufferSize) {
     if ((mpi_code = MPI_File_write(MPI_dataset->MPI_file, string, targetSize, MPI_CHAR, MPI_STATUS_IGNORE)) != MPI_SUCCESS) {
       SDDS_MPI_GOTO_ERROR(stderr, "SDDS_MPI_WriteBufferedWrite(MPI_File_write_at failed)", mpi_code, 0);
@@ -782,6 +784,12 @@ int32_t SDDS_MPI_Terminate(SDDS_DATASET *SDDS_dataset) {
   layout = &(SDDS_dataset->original_layout);
   if (!SDDS_CheckDataset(SDDS_dataset, "SDDS_Terminate"))
     return (0);
+  if (!SDDS_MPI_CompletePendingWrite(SDDS_dataset))
+    return (0);
+  if (SDDS_dataset->mode == SDDS_WRITEMODE && !SDDS_dataset->layout.disconnected && !SDDS_MPI_FlushCompressedOutput(SDDS_dataset))
+    return (0);
+  if (MPI_dataset->compress_buffer)
+    free(MPI_dataset->compress_buffer);
   if (SDDS_dataset->pagecount_offset)
     free(SDDS_dataset->pagecount_offset);
   if (SDDS_dataset->row_flag)
@@ -946,6 +954,9 @@ int32_t SDDS_MPI_Terminate(SDDS_DATASET *SDDS_dataset) {
     free(layout->parameter_index);
   if (layout->array_index)
     free(layout->array_index);
+  SDDS_FreeNameHash(&layout->column_hash);
+  SDDS_FreeNameHash(&layout->parameter_hash);
+  SDDS_FreeNameHash(&layout->array_hash);
   SDDS_ZeroMemory(&SDDS_dataset->layout, sizeof(SDDS_LAYOUT));
   SDDS_ZeroMemory(SDDS_dataset, sizeof(SDDS_DATASET));
 #if DEBUG
@@ -957,6 +968,29 @@ int32_t SDDS_MPI_Terminate(SDDS_DATASET *SDDS_dataset) {
   return (1);
 }
 
+/**
+ * @brief Selects compressed parallel output from the file name extension.
+ *
+ * As in SDDS_InitializeOutput, a ".gz" extension selects gzip and ".xz" or ".lzma" selects xz.
+ * The processors then write their data as independent compressed members (see
+ * SDDS_MPI_WriteCompressedData).
+ *
+ * @param SDDS_dataset Pointer to the `SDDS_DATASET` structure.
+ * @param filename The name of the output file.
+ */
+static void SDDS_MPI_SetCompressedOutput(SDDS_DATASET *SDDS_dataset, char *filename) {
+  char *extension;
+
+  SDDS_dataset->layout.gzipFile = SDDS_dataset->layout.lzmaFile = 0;
+  SDDS_dataset->MPI_dataset->compress_size = SDDS_dataset->MPI_dataset->compressed_offset = 0;
+  if (!filename || !(extension = strrchr(filename, '.')))
+    return;
+  if (strcmp(extension, ".gz") == 0)
+    SDDS_dataset->layout.gzipFile = 1;
+  else if (strcmp(extension, ".xz") == 0 || strcmp(extension, ".lzma") == 0)
+    SDDS_dataset->layout.lzmaFile = 1;
+}
+
 /**
  * @brief Initializes the SDDS dataset for MPI output.
  *
@@ -983,6 +1017,7 @@ int32_t SDDS_MPI_InitializeOutput(SDDS_DATASET *SDDS_dataset, char *description,
   }
   /*  SDDS_dataset->MPI_dataset = MPI_dataset; */
   SDDS_dataset->layout.data_mode.column_major = column_major;
+  SDDS_MPI_SetCompressedOutput(SDDS_dataset, filename);
   if (!SDDS_MPI_File_Open(MPI_dataset, filename, flags)) {
     SDDS_SetError("Failed in opening file for MPI output!");
     return 0;
@@ -1034,6 +1069,7 @@ int32_t SDDS_MPI_InitializeCopy(SDDS_DATASET *SDDS_target, SDDS_DATASET *SDDS_so
     return (0);
   /*  SDDS_target->MPI_dataset = MPI_target; */
   SDDS_target->layout.data_mode.column_major = column_major;
+  SDDS_MPI_SetCompressedOutput(SDDS_target, filename);
   if (!SDDS_MPI_File_Open(MPI_target, filename, SDDS_MPI_WRITE_ONLY))
     return 0;
   SDDS_target->parallel_io = 1;
@@ -1108,6 +1144,8 @@ int32_t SDDS_MPI_DisconnectFile(SDDS_DATASET *SDDS_dataset) {
      SDDS_SetError("Can't disconnect file.  Problem updating page. (SDDS_MPI_DisconnectFile)");
      return 0;
      } */
+  if (!SDDS_MPI_CompletePendingWrite(SDDS_dataset) || !SDDS_MPI_FlushCompressedOutput(SDDS_dataset))
+    return 0;
   SDDS_dataset->layout.disconnected = 1;
   MPI_File_close(&(MPI_dataset->MPI_file));
   return 1;
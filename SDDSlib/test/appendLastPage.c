@@ -0,0 +1,153 @@
+/**
+ * @file appendLastPage.c
+ * @brief Checks that appending with a <filename>.lastpage record gives the same file as appending without it.
+ *
+ * A file is written whose last page has parameter values P=2 and S="str", then rows are appended to it
+ * twice, the second time both with the record left by the first append and with the record removed.
+ * Each append checks that the last page's parameters were loaded; the second also writes a further page
+ * whose parameters are carried over from the last page.  The two files must be identical.
+ *
+ * @copyright
+ *   - (c) 2002 The University of Chicago, as Operator of Argonne National Laboratory.
+ *   - (c) 2002 The Regents of the University of California, as Operator of Los Alamos National Laboratory.
+ *
+ * @license
+ * This file is distributed under the terms of the Software License Agreement
+ * found in the file LICENSE included with this distribution.
+ */
+
+#include "SDDS.h"
+#include "mdb.h"
+
+static int32_t setRows(SDDS_DATASET *SDDS_dataset, int64_t first, int64_t rows, int64_t id0, int32_t stringColumn) {
+  int64_t i;
+  char name[40];
+
+  for (i = 0; i < rows; i++) {
+    sprintf(name, "r%" PRId64, id0 + i);
+    if (!SDDS_SetRowValues(SDDS_dataset, SDDS_SET_BY_NAME | SDDS_PASS_BY_VALUE, first + i,
+                           "x", (id0 + i) * 0.5, "id", (int32_t)(id0 + i), NULL) ||
+        (stringColumn && !SDDS_SetRowValues(SDDS_dataset, SDDS_SET_BY_NAME | SDDS_PASS_BY_VALUE, first + i, "name", name, NULL)))
+      return 0;
+  }
+  return 1;
+}
+
+static int32_t createFile(const char *filename, int32_t mode, int32_t stringColumn) {
+  SDDS_DATASET SDDS_dataset;
+  int32_t page, dimension = 3;
+  double array[3] = {1, 2, 3};
+
+  if (!SDDS_InitializeOutput(&SDDS_dataset, mode, 1, NULL, NULL, filename) ||
+      SDDS_DefineColumn(&SDDS_dataset, "x", NULL, NULL, NULL, NULL, SDDS_DOUBLE, 0) < 0 ||
+      SDDS_DefineColumn(&SDDS_dataset, "id", NULL, NULL, NULL, NULL, SDDS_LONG, 0) < 0 ||
+      (stringColumn && SDDS_DefineColumn(&SDDS_dataset, "name", NULL, NULL, NULL, NULL, SDDS_STRING, 0) < 0) ||
+      SDDS_DefineParameter(&SDDS_dataset, "P", NULL, NULL, NULL, NULL, SDDS_LONG, NULL) < 0 ||
+      SDDS_DefineParameter(&SDDS_dataset, "S", NULL, NULL, NULL, NULL, SDDS_STRING, NULL) < 0 ||
+      SDDS_DefineArray(&SDDS_dataset, "A", NULL, NULL, NULL, NULL, SDDS_DOUBLE, 0, 1, NULL) < 0 ||
+      !SDDS_WriteLayout(&SDDS_dataset))
+    return 0;
+  for (page = 1; page <= 2; page++) {
+    array[0] = page;
+    if (!SDDS_StartPage(&SDDS_dataset, 10) ||
+        !SDDS_SetParameters(&SDDS_dataset, SDDS_SET_BY_NAME | SDDS_PASS_BY_VALUE, "P", page, "S", page == 2 ? "str" : "first", NULL) ||
+        !SDDS_SetArray(&SDDS_dataset, "A", SDDS_CONTIGUOUS_DATA, array, &dimension) ||
+        !setRows(&SDDS_dataset, 0, 10, page * 100, stringColumn) || !SDDS_WritePage(&SDDS_dataset))
+      return 0;
+  }
+  return SDDS_Terminate(&SDDS_dataset);
+}
+
+static int32_t appendToFile(const char *filename, int64_t id0, int32_t newPage) {
+  SDDS_DATASET SDDS_dataset;
+  int64_t rowsPresent;
+  int32_t P, stringColumn;
+  char *S = NULL;
+
+  if (!SDDS_InitializeAppendToPage(&SDDS_dataset, filename, 10, &rowsPresent))
+    return 0;
+  stringColumn = SDDS_GetColumnIndex(&SDDS_dataset, "name") >= 0;
+  if (!SDDS_GetParameterAsLong(&SDDS_dataset, "P", &P) || !SDDS_GetParameter(&SDDS_dataset, "S", &S))
+    return 0;
+  if (P != 2 || strcmp(S, "str") != 0) {
+    fprintf(stderr, "%s: last page parameters not loaded (P=%" PRId32 ", S=\"%s\")\n", filename, P, S ? S : "");
+    return 0;
+  }
+  free(S);
+  if (!setRows(&SDDS_dataset, rowsPresent, 5, id0, stringColumn) || !SDDS_UpdatePage(&SDDS_dataset, FLUSH_TABLE))
+    return 0;
+  if (newPage && (!SDDS_StartPage(&SDDS_dataset, 10) || !setRows(&SDDS_dataset, 0, 3, id0 + 50, stringColumn) ||
+                  !SDDS_WritePage(&SDDS_dataset)))
+    return 0;
+  return SDDS_Terminate(&SDDS_dataset);
+}
+
+static int32_t sameFiles(const char *name1, const char *name2) {
+  FILE *fp1, *fp2;
+  int c1, c2;
+
+  if (!(fp1 = fopen(name1, "rb")))
+    return 0;
+  if (!(fp2 = fopen(name2, "rb"))) {
+    fclose(fp1);
+    return 0;
+  }
+  do {
+    c1 = getc(fp1);
+    c2 = getc(fp2);
+  } while (c1 == c2 && c1 != EOF);
+  fclose(fp1);
+  fclose(fp2);
+  return c1 == c2;
+}
+
+static int32_t copyFile(const char *source, const char *target) {
+  FILE *fpIn, *fpOut;
+  int c;
+
+  if (!(fpIn = fopen(source, "rb")))
+    return 0;
+  if (!(fpOut = fopen(target, "wb"))) {
+    fclose(fpIn);
+    return 0;
+  }
+  while ((c = getc(fpIn)) != EOF)
+    putc(c, fpOut);
+  fclose(fpIn);
+  return fclose(fpOut) == 0;
+}
+
+int main(int argc, char **argv) {
+  const char *withRecord = "appendLastPage1.sdds", *withoutRecord = "appendLastPage2.sdds";
+  const char *withRecordInfo = "appendLastPage1.sdds.lastpage", *withoutRecordInfo = "appendLastPage2.sdds.lastpage";
+  /* data mode, string column, byte order of binary data */
+  struct {
+    int32_t mode, stringColumn;
+    char *endianess;
+  } test[4] = {
+    {SDDS_BINARY, 0, NULL}, {SDDS_BINARY, 0, NULL}, {SDDS_BINARY, 1, NULL}, {SDDS_ASCII, 1, NULL}};
+  int32_t i, failures = 0;
+
+  /* the second test writes binary data in the non-native byte order */
+  test[1].endianess = SDDS_IsBigEndianMachine() ? "SDDS_OUTPUT_ENDIANESS=little" : "SDDS_OUTPUT_ENDIANESS=big";
+  for (i = 0; i < 4; i++) {
+    putenv(test[i].endianess ? test[i].endianess : "SDDS_OUTPUT_ENDIANESS=");
+    remove(withRecordInfo);
+    remove(withoutRecordInfo);
+    if (!createFile(withRecord, test[i].mode, test[i].stringColumn) || !appendToFile(withRecord, 1000, 0) ||
+        !copyFile(withRecord, withoutRecord) ||
+        !appendToFile(withRecord, 2000, 1) || !appendToFile(withoutRecord, 2000, 1)) {
+      SDDS_PrintErrors(stderr, SDDS_VERBOSE_PrintErrors);
+      failures++;
+    } else if (!sameFiles(withRecord, withoutRecord)) {
+      fprintf(stderr, "%s and %s differ (test %" PRId32 ")\n", withRecord, withoutRecord, i);
+      failures++;
+    }
+  }
+  remove(withRecord);
+  remove(withRecordInfo);
+  remove(withoutRecord);
+  remove(withoutRecordInfo);
+  fprintf(stderr, "appendLastPage: %s\n", failures ? "FAILED" : "passed");
+  return failures ? 1 : 0;
+}
@@ -0,0 +1,109 @@
+/**
+ * @file combineCharacter.c
+ * @brief Checks that SDDS_CombineFiles copies character columns, parameters and arrays.
+ *
+ * Two files with a character column and parameter are combined, once as binary files whose data are
+ * passed through, and once as a binary and an ASCII file that also have a character array and are
+ * decoded.  The output is read back and checked.
+ *
+ * @copyright
+ *   - (c) 2002 The University of Chicago, as Operator of Argonne National Laboratory.
+ *   - (c) 2002 The Regents of the University of California, as Operator of Los Alamos National Laboratory.
+ *
+ * @license
+ * This file is distributed under the terms of the Software License Agreement
+ * found in the file LICENSE included with this distribution.
+ */
+
+#include "SDDS.h"
+#include "mdb.h"
+
+#define ROWS 4
+
+static int32_t createFile(const char *filename, int32_t mode, char first, int32_t withArray) {
+  SDDS_DATASET SDDS_dataset;
+  int32_t i, dimension = 2;
+  char array[2];
+
+  array[0] = first;
+  array[1] = first + 1;
+  if (!SDDS_InitializeOutput(&SDDS_dataset, mode, 1, NULL, NULL, filename) ||
+      SDDS_DefineColumn(&SDDS_dataset, "c", NULL, NULL, NULL, NULL, SDDS_CHARACTER, 0) < 0 ||
+      SDDS_DefineColumn(&SDDS_dataset, "x", NULL, NULL, NULL, NULL, SDDS_DOUBLE, 0) < 0 ||
+      SDDS_DefineParameter(&SDDS_dataset, "C", NULL, NULL, NULL, NULL, SDDS_CHARACTER, NULL) < 0 ||
+      (withArray && SDDS_DefineArray(&SDDS_dataset, "A", NULL, NULL, NULL, NULL, SDDS_CHARACTER, 0, 1, NULL) < 0) ||
+      !SDDS_WriteLayout(&SDDS_dataset) || !SDDS_StartPage(&SDDS_dataset, ROWS) ||
+      !SDDS_SetParameters(&SDDS_dataset, SDDS_SET_BY_NAME | SDDS_PASS_BY_VALUE, "C", first, NULL) ||
+      (withArray && !SDDS_SetArray(&SDDS_dataset, "A", SDDS_CONTIGUOUS_DATA, array, &dimension)))
+    return 0;
+  for (i = 0; i < ROWS; i++)
+    if (!SDDS_SetRowValues(&SDDS_dataset, SDDS_SET_BY_NAME | SDDS_PASS_BY_VALUE, i, "c", (char)(first + i), "x", (double)i, NULL))
+      return 0;
+  return SDDS_WritePage(&SDDS_dataset) && SDDS_Terminate(&SDDS_dataset);
+}
+
+static int32_t combine(char **input, const char *output) {
+  SDDS_DATASET SDDS_input, SDDS_output;
+  int64_t pages;
+
+  if (!SDDS_InitializeInput(&SDDS_input, input[0]) ||
+      !SDDS_InitializeCopy(&SDDS_output, &SDDS_input, (char *)output, "w") ||
+      !SDDS_Terminate(&SDDS_input))
+    return 0;
+  if ((pages = SDDS_CombineFiles(&SDDS_output, input, 2, 2, 0)) != 2) {
+    if (pages >= 0)
+      fprintf(stderr, "%" PRId64 " pages combined, expected 2\n", pages);
+    return 0;
+  }
+  return SDDS_Terminate(&SDDS_output);
+}
+
+static int32_t checkOutput(const char *filename, const char *first, int32_t withArray) {
+  SDDS_DATASET SDDS_dataset;
+  SDDS_ARRAY *array = NULL;
+  char *c, C;
+  int32_t page, i, ok;
+
+  if (!SDDS_InitializeInput(&SDDS_dataset, (char *)filename))
+    return 0;
+  ok = 1;
+  for (page = 0; ok && page < 2; page++) {
+    if (SDDS_ReadPage(&SDDS_dataset) != page + 1 || SDDS_CountRowsOfInterest(&SDDS_dataset) != ROWS ||
+        !SDDS_GetParameter(&SDDS_dataset, "C", &C) || !(c = SDDS_GetColumn(&SDDS_dataset, "c")) ||
+        (withArray && !(array = SDDS_GetArray(&SDDS_dataset, "A", NULL))))
+      return 0;
+    if (C != first[page] ||
+        (withArray && (array->elements != 2 || ((char *)array->data)[0] != first[page] || ((char *)array->data)[1] != first[page] + 1)))
+      ok = 0;
+    for (i = 0; i < ROWS; i++)
+      if (c[i] != first[page] + i)
+        ok = 0;
+    if (!ok)
+      fprintf(stderr, "%s: wrong character data on page %" PRId32 "\n", filename, page + 1);
+    free(c);
+    if (array)
+      SDDS_FreeArray(array);
+    array = NULL;
+  }
+  return SDDS_Terminate(&SDDS_dataset) && ok;
+}
+
+int main(int argc, char **argv) {
+  char *input[2] = {"combineCharacter1.sdds", "combineCharacter2.sdds"};
+  const char *output = "combineCharacter3.sdds";
+  int32_t i, failures = 0;
+
+  /* binary files passed through, then a binary and an ASCII file with arrays, which are decoded */
+  for (i = 0; i < 2; i++) {
+    if (!createFile(input[0], SDDS_BINARY, 'a', i) || !createFile(input[1], i ? SDDS_ASCII : SDDS_BINARY, 'p', i) ||
+        !combine(input, output) || !checkOutput(output, "ap", i)) {
+      SDDS_PrintErrors(stderr, SDDS_VERBOSE_PrintErrors);
+      failures++;
+    }
+  }
+  remove(input[0]);
+  remove(input[1]);
+  remove(output);
+  fprintf(stderr, "combineCharacter: %s\n", failures ? "FAILED" : "passed");
+  return failures ? 1 : 0;
+}
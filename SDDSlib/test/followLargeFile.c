@@ -0,0 +1,115 @@
+/**
+ * @file followLargeFile.c
+ * @brief Checks that SDDS_FollowRead decodes a large file with bounded memory.
+ *
+ * A file several times the size of the follower's read buffer is written, with a string column and a
+ * page whose array is larger than the buffer.  The whole file is then followed, and the rows decoded,
+ * the newest rows kept, and the size of the read buffer are checked.
+ *
+ * @copyright
+ *   - (c) 2002 The University of Chicago, as Operator of Argonne National Laboratory.
+ *   - (c) 2002 The Regents of the University of California, as Operator of Los Alamos National Laboratory.
+ *
+ * @license
+ * This file is distributed under the terms of the Software License Agreement
+ * found in the file LICENSE included with this distribution.
+ */
+
+#include "SDDS.h"
+#include "mdb.h"
+
+#define PAGES 6
+#define PAGE_ROWS 200000
+#define ARRAY_ELEMENTS 1000000
+#define CAPACITY 1000
+
+static int32_t createFile(const char *filename) {
+  SDDS_DATASET SDDS_dataset;
+  int32_t page, dimension;
+  int64_t i, id;
+  double *array;
+  char name[40];
+
+  if (!(array = calloc(ARRAY_ELEMENTS, sizeof(*array))))
+    return 0;
+  if (!SDDS_InitializeOutput(&SDDS_dataset, SDDS_BINARY, 1, NULL, NULL, filename) ||
+      SDDS_DefineColumn(&SDDS_dataset, "x", NULL, NULL, NULL, NULL, SDDS_DOUBLE, 0) < 0 ||
+      SDDS_DefineColumn(&SDDS_dataset, "id", NULL, NULL, NULL, NULL, SDDS_LONG64, 0) < 0 ||
+      SDDS_DefineColumn(&SDDS_dataset, "name", NULL, NULL, NULL, NULL, SDDS_STRING, 0) < 0 ||
+      SDDS_DefineParameter(&SDDS_dataset, "page", NULL, NULL, NULL, NULL, SDDS_LONG, NULL) < 0 ||
+      SDDS_DefineArray(&SDDS_dataset, "A", NULL, NULL, NULL, NULL, SDDS_DOUBLE, 0, 1, NULL) < 0 ||
+      !SDDS_WriteLayout(&SDDS_dataset))
+    return 0;
+  id = 0;
+  for (page = 1; page <= PAGES; page++) {
+    /* the array of the second page is larger than the follower's buffer */
+    dimension = page == 2 ? ARRAY_ELEMENTS : 1;
+    if (!SDDS_StartPage(&SDDS_dataset, PAGE_ROWS) ||
+        !SDDS_SetParameters(&SDDS_dataset, SDDS_SET_BY_NAME | SDDS_PASS_BY_VALUE, "page", page, NULL) ||
+        !SDDS_SetArray(&SDDS_dataset, "A", SDDS_CONTIGUOUS_DATA, array, &dimension))
+      return 0;
+    for (i = 0; i < PAGE_ROWS; i++, id++) {
+      sprintf(name, "row%" PRId64, id);
+      if (!SDDS_SetRowValues(&SDDS_dataset, SDDS_SET_BY_NAME | SDDS_PASS_BY_VALUE, i, "x", id * 0.5, "id", id, "name", name, NULL))
+        return 0;
+    }
+    if (!SDDS_WritePage(&SDDS_dataset))
+      return 0;
+  }
+  free(array);
+  return SDDS_Terminate(&SDDS_dataset);
+}
+
+int main(int argc, char **argv) {
+  const char *filename = "followLargeFile.sdds";
+  SDDS_FOLLOW follow;
+  FILE *fp;
+  int64_t fileSize, rows, maxBufferSize, *id;
+  int32_t page, page0, ok;
+  char **name, expected[40];
+
+  ok = 0;
+  if (createFile(filename) && (fp = fopen(filename, "rb"))) {
+    fseek(fp, 0, SEEK_END);
+    fileSize = ftell(fp);
+    fclose(fp);
+    if (SDDS_FollowInitialize(&follow, (char *)filename, CAPACITY)) {
+      maxBufferSize = 0;
+      /* a call stops where a page may end, so read until nothing changes */
+      do {
+        page0 = follow.page;
+        if ((rows = SDDS_FollowRead(&follow)) < 0)
+          break;
+        if (follow.bufferSize > maxBufferSize)
+          maxBufferSize = follow.bufferSize;
+      } while (rows > 0 || follow.page != page0);
+      if (rows >= 0 && SDDS_GetParameterAsLong(&follow.dataset, "page", &page) &&
+          (id = SDDS_GetFollowColumn(&follow, "id", &rows)) && (name = SDDS_GetFollowColumn(&follow, "name", &rows))) {
+        sprintf(expected, "row%" PRId64, (int64_t)PAGES * PAGE_ROWS - 1);
+        ok = 1;
+        if (follow.totalRows != (int64_t)PAGES * PAGE_ROWS || follow.page != PAGES || page != PAGES || rows != CAPACITY ||
+            id[CAPACITY - 1] != (int64_t)PAGES * PAGE_ROWS - 1 || id[0] != (int64_t)PAGES * PAGE_ROWS - CAPACITY ||
+            strcmp(name[CAPACITY - 1], expected) != 0) {
+          fprintf(stderr, "wrong data: %" PRId64 " rows, %" PRId32 " pages\n", follow.totalRows, follow.page);
+          ok = 0;
+        }
+        /* the buffer grows for the large array within a call, but not with the file */
+        if (maxBufferSize >= ARRAY_ELEMENTS * (int64_t)sizeof(double) || maxBufferSize > fileSize / 4) {
+          fprintf(stderr, "read buffer of %" PRId64 " bytes for a file of %" PRId64 " bytes\n", maxBufferSize, fileSize);
+          ok = 0;
+        }
+        free(id);
+        for (rows = 0; rows < CAPACITY; rows++)
+          free(name[rows]);
+        free(name);
+      }
+      if (!SDDS_FollowTerminate(&follow))
+        ok = 0;
+    }
+  }
+  if (!ok)
+    SDDS_PrintErrors(stderr, SDDS_VERBOSE_PrintErrors);
+  remove(filename);
+  fprintf(stderr, "followLargeFile: %s\n", ok ? "passed" : "FAILED");
+  return ok ? 0 : 1;
+}
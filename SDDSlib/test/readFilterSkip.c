@@ -0,0 +1,100 @@
+/**
+ * @file readFilterSkip.c
+ * @brief Checks that pages rejected by a read filter are skipped in plain and compressed files.
+ *
+ * Files with three pages of data much larger than the file buffer are written uncompressed, with
+ * gzip and with xz, in row- and column-major order.  They are read with a parameter filter that
+ * rejects the first two pages, and the data of the remaining page are checked.
+ *
+ * @copyright
+ *   - (c) 2002 The University of Chicago, as Operator of Argonne National Laboratory.
+ *   - (c) 2002 The Regents of the University of California, as Operator of Los Alamos National Laboratory.
+ *
+ * @license
+ * This file is distributed under the terms of the Software License Agreement
+ * found in the file LICENSE included with this distribution.
+ */
+
+#include "SDDS.h"
+#include "mdb.h"
+
+#define PAGES 3
+#define ROWS 100000
+
+static int32_t createFile(const char *filename, int32_t columnMajor) {
+  SDDS_DATASET SDDS_dataset;
+  double *x, *y;
+  int32_t page;
+  int64_t i;
+
+  if (!(x = malloc(sizeof(*x) * ROWS)) || !(y = malloc(sizeof(*y) * ROWS)))
+    return 0;
+  if (!SDDS_InitializeOutput(&SDDS_dataset, SDDS_BINARY, 1, NULL, NULL, filename) ||
+      SDDS_DefineColumn(&SDDS_dataset, "x", NULL, NULL, NULL, NULL, SDDS_DOUBLE, 0) < 0 ||
+      SDDS_DefineColumn(&SDDS_dataset, "y", NULL, NULL, NULL, NULL, SDDS_DOUBLE, 0) < 0 ||
+      SDDS_DefineParameter(&SDDS_dataset, "P", NULL, NULL, NULL, NULL, SDDS_LONG, NULL) < 0)
+    return 0;
+  SDDS_dataset.layout.data_mode.column_major = columnMajor;
+  if (!SDDS_WriteLayout(&SDDS_dataset))
+    return 0;
+  for (page = 1; page <= PAGES; page++) {
+    for (i = 0; i < ROWS; i++) {
+      x[i] = page * ROWS + i;
+      y[i] = -x[i];
+    }
+    if (!SDDS_StartPage(&SDDS_dataset, ROWS) ||
+        !SDDS_SetParameters(&SDDS_dataset, SDDS_SET_BY_NAME | SDDS_PASS_BY_VALUE, "P", page, NULL) ||
+        !SDDS_SetColumn(&SDDS_dataset, SDDS_SET_BY_NAME, x, ROWS, "x") ||
+        !SDDS_SetColumn(&SDDS_dataset, SDDS_SET_BY_NAME, y, ROWS, "y") || !SDDS_WritePage(&SDDS_dataset))
+      return 0;
+  }
+  free(x);
+  free(y);
+  return SDDS_Terminate(&SDDS_dataset);
+}
+
+static int32_t readFile(const char *filename) {
+  SDDS_DATASET SDDS_dataset;
+  double *x, *y;
+  int32_t P, ok;
+  int64_t i;
+
+  if (!SDDS_InitializeInput(&SDDS_dataset, (char *)filename) ||
+      !SDDS_AddReadFilter(&SDDS_dataset, SDDS_PARAMETER_READ_FILTER, "P", PAGES, PAGES))
+    return 0;
+  if (SDDS_ReadPage(&SDDS_dataset) != PAGES || SDDS_CountRowsOfInterest(&SDDS_dataset) != ROWS ||
+      !SDDS_GetParameterAsLong(&SDDS_dataset, "P", &P) ||
+      !(x = SDDS_GetColumnInDoubles(&SDDS_dataset, "x")) || !(y = SDDS_GetColumnInDoubles(&SDDS_dataset, "y")))
+    return 0;
+  ok = P == PAGES;
+  for (i = 0; ok && i < ROWS; i++)
+    if (x[i] != PAGES * ROWS + i || y[i] != -x[i])
+      ok = 0;
+  if (!ok)
+    fprintf(stderr, "%s: wrong data on the page read\n", filename);
+  free(x);
+  free(y);
+  if (ok && SDDS_ReadPage(&SDDS_dataset) != -1) {
+    fprintf(stderr, "%s: page found after the last page\n", filename);
+    ok = 0;
+  }
+  return SDDS_Terminate(&SDDS_dataset) && ok;
+}
+
+int main(int argc, char **argv) {
+  char *filename[3] = {"readFilterSkip.sdds", "readFilterSkip.sdds.gz", "readFilterSkip.sdds.xz"};
+  int32_t i, columnMajor, failures = 0;
+
+  for (i = 0; i < 3; i++) {
+    for (columnMajor = 0; columnMajor < 2; columnMajor++) {
+      if (!createFile(filename[i], columnMajor) || !readFile(filename[i])) {
+        SDDS_PrintErrors(stderr, SDDS_VERBOSE_PrintErrors);
+        fprintf(stderr, "%s (%s-major) failed\n", filename[i], columnMajor ? "column" : "row");
+        failures++;
+      }
+    }
+    remove(filename[i]);
+  }
+  fprintf(stderr, "readFilterSkip: %s\n", failures ? "FAILED" : "passed");
+  return failures ? 1 : 0;
+}
@@ -35,6 +35,10 @@
 #define SDDS_MPI_READ_WRITE  0x0004UL
 #define SDDS_MPI_STRING_COLUMN_LEN 16
 
+#define SDDS_MPI_READ_BY_ROWS 0
+#define SDDS_MPI_READ_BY_COLUMNS 1
+#define SDDS_MPI_READ_BY_COLUMN_BYTES 2
+
 #define SDDS_COLUMN_MAJOR_ORDER 0x0001UL
 #define SDDS_ROW_MAJOR_ORDER    0x0002UL
 
@@ -60,6 +64,16 @@ typedef struct {
   int32_t               end_of_file;    /* flag for end of MPI_file */
   int32_t               master_read;   /*determine if master processor read the page data or not*/
   int64_t               start_row, end_row; /* the start row and end row that current processor's data that is going to be written to output or read from input */
+  short                 async_io;       /* page writes return before the data reaches the file */
+  int32_t               n_pending_writes;
+  MPI_Request           *pending_write; /* outstanding non-blocking collective writes */
+  char                  *pending_buffer; /* packed page data owned by the outstanding writes */
+  short                 read_decomposition; /* SDDS_MPI_READ_BY_ROWS, _BY_COLUMNS or _BY_COLUMN_BYTES */
+  short                 shared_layout;  /* header parsed once, layout shared per node */
+  int64_t               sparse_interval, sparse_offset, last_rows; /* row selection for the page being read */
+  char                  *compress_buffer; /* header and title bytes waiting to be compressed (gzip/xz output) */
+  int64_t               compress_size, compress_allocated;
+  MPI_Offset            compressed_offset; /* end of the compressed data written so far */
   FILE *fpdeb;
 } MPI_DATASET;
 #endif
@@ -202,6 +216,17 @@ extern "C" {
   int SDDS_CompareIndexedNames(const void *s1, const void *s2);
   int SDDS_CompareIndexedNamesPtr(const void *s1, const void *s2);
 
+  /* open-addressed hash over the entries of a SORTED_INDEX array, rebuilt lazily when stale */
+  typedef struct {
+    SORTED_INDEX **slot;
+    uint32_t size;
+    int32_t entries;
+  } SDDS_NAME_HASH;
+  int32_t SDDS_LookupIndexedName(SDDS_NAME_HASH **hash, SORTED_INDEX **sorted, int32_t n, char *name);
+  void SDDS_AddIndexedName(SDDS_NAME_HASH *hash, SORTED_INDEX *entry, int32_t n);
+  void SDDS_InvalidateNameHash(SDDS_NAME_HASH *hash);
+  void SDDS_FreeNameHash(SDDS_NAME_HASH **hash);
+
   typedef struct {
     int32_t mode, lines_per_row, no_row_counts, fixed_row_count, fixed_row_increment, fsync_data;
     int32_t additional_header_lines, endian;
@@ -266,6 +291,8 @@ extern "C" {
     ARRAY_DEFINITION *array_definition;
     ASSOCIATE_DEFINITION *associate_definition;
     SORTED_INDEX **column_index, **parameter_index, **array_index;
+    SDDS_NAME_HASH *column_hash, *parameter_hash, *array_hash;
+    short index_deferred; /* while set, name indexes are appended to unsorted; see SDDS_SortLayoutIndexes */
 
     char *filename;
     FILE *fp;
@@ -303,6 +330,12 @@ extern "C" {
 
 #define SDDS_FILEBUFFER_SIZE  262144
 
+  typedef struct {
+    char *name;
+    uint32_t mode;
+    double lower, upper;
+  } SDDS_READ_FILTER;
+
   typedef struct {
     SDDS_LAYOUT layout, original_layout;
     short swapByteOrder;
@@ -326,6 +359,9 @@ extern "C" {
     short file_had_data;   /* indicates that file being appended to already had some data in it (i.e.,
                             * more than just a header.  Affects no_row_counts=1 output.
                             */
+    /* set by SDDS_InitializeAppendToPage: end of the header and the row count offset recorded in the
+     * <filename>.lastpage file, which is rewritten whenever a new page is started (0 if not kept) */
+    int64_t append_layout_offset, append_rowcount_offset;
     short autoRecover;
     short autoRecovered;
     short parallel_io;        /*flag for parallel SDDS */
@@ -339,6 +375,10 @@ extern "C" {
     /* array of SDDS_ARRAY structures for storing array data */
     SDDS_ARRAY *array;
 
+    /* predicates registered with SDDS_AddReadFilter, used to skip pages while reading */
+    SDDS_READ_FILTER *readFilter;
+    int32_t readFilters;
+
     /* array for parameter data.  The address of the data for the ith parameter
      * is parameter[i].  So *(<type-name> *)parameter[i] gives the data itself.  For type
      * SDDS_STRING the "data itself" is actually the address of the string, and the type-name
@@ -359,6 +399,23 @@ extern "C" {
 
   typedef SDDS_DATASET SDDS_TABLE;
 
+  /* state of a reader following a growing file (SDDS_FollowInitialize) */
+  typedef struct {
+    SDDS_DATASET dataset;       /* layout of the file; parameters of the newest page */
+    char *buffer;               /* bytes read from the file but not yet decoded */
+    int64_t bufferLength, bufferSize;
+    int64_t offset;             /* file offset of buffer[0] */
+    int64_t rowcountOffset;     /* file offset of the row count of the current page */
+    int64_t pageRows, pageRowsRead;
+    int32_t page;               /* number of pages started so far */
+    short inPage, boundarySeen;
+    /* ring buffer holding the newest rows; column i is ring[i] */
+    void **ring;
+    int64_t capacity, ringStart, ringRows, totalRows;
+    int32_t notifyFd, watchFd;
+    long pollInterval;          /* microseconds, used when file notification is unavailable */
+  } SDDS_FOLLOW;
+
   /* prototypes for routines to prepare and write SDDS files */
   epicsShareFuncSDDS extern int32_t SDDS_InitializeOutput(SDDS_DATASET *SDDS_dataset, int32_t data_mode,
                                                           int32_t lines_per_row, const char *description,
@@ -375,6 +432,11 @@ extern "C" {
   epicsShareFuncSDDS extern long SDDS_DisconnectInputFile(SDDS_DATASET *SDDS_dataset);
   epicsShareFuncSDDS extern int32_t SDDS_ReconnectInputFile(SDDS_DATASET *SDDS_dataset, long position);
   epicsShareFuncSDDS extern int32_t SDDS_ReadNewBinaryRows(SDDS_DATASET *SDDS_dataset);
+  epicsShareFuncSDDS extern int32_t SDDS_FollowInitialize(SDDS_FOLLOW *follow, char *filename, int64_t capacity);
+  epicsShareFuncSDDS extern int64_t SDDS_FollowRead(SDDS_FOLLOW *follow);
+  epicsShareFuncSDDS extern int64_t SDDS_FollowWait(SDDS_FOLLOW *follow, double timeout);
+  epicsShareFuncSDDS extern void *SDDS_GetFollowColumn(SDDS_FOLLOW *follow, char *column_name, int64_t *rows);
+  epicsShareFuncSDDS extern int32_t SDDS_FollowTerminate(SDDS_FOLLOW *follow);
   epicsShareFuncSDDS extern int32_t SDDS_FreeStringData(SDDS_DATASET *SDDS_dataset);
   epicsShareFuncSDDS extern int32_t SDDS_Terminate(SDDS_DATASET *SDDS_dataset);
   epicsShareFuncSDDS extern void SDDS_SetTerminateMode(uint32_t mode);
@@ -440,6 +502,9 @@ extern "C" {
   epicsShareFuncSDDS extern void SDDS_DeferSavingLayout(SDDS_DATASET *SDDS_dataset, int32_t mode);
   epicsShareFuncSDDS extern int32_t SDDS_SaveLayout(SDDS_DATASET *SDDS_dataset);
   epicsShareFuncSDDS extern int32_t SDDS_RestoreLayout(SDDS_DATASET *SDDS_dataset);
+  epicsShareFuncSDDS extern int32_t SDDS_SetLayoutCacheSize(int32_t entries);
+#define SDDS_COMBINE_NO_PASSTHROUGH 0x0001UL
+  epicsShareFuncSDDS extern int64_t SDDS_CombineFiles(SDDS_DATASET *SDDS_output, char **input, int32_t inputs, int32_t threads, uint32_t mode);
 
 #define SDDS_BY_INDEX 1
 #define SDDS_BY_NAME  2
@@ -481,6 +546,7 @@ extern "C" {
 
   epicsShareFuncSDDS extern void SDDS_SetReadRecoveryMode(SDDS_DATASET *SDDS_dataset, int32_t mode);
   epicsShareFuncSDDS extern int32_t SDDS_SetDefaultIOBufferSize(int32_t bufferSize);
+  epicsShareFuncSDDS extern int32_t SDDS_SetAsciiReadThreads(int32_t threads);
 
   /* prototypes for routines to read and use SDDS files  */
   epicsShareFuncSDDS extern int32_t SDDS_InitializeInputFromSearchPath(SDDS_DATASET *SDDSin, char *file);
@@ -497,6 +563,10 @@ extern "C" {
                                                         int64_t sparse_offset, int32_t sparse_statistics);
   epicsShareFuncSDDS extern int32_t SDDS_ReadPageLastRows(SDDS_DATASET *SDDS_dataset, int64_t last_rows);
 #define SDDS_ReadTable(a) SDDS_ReadPage(a)
+#define SDDS_PARAMETER_READ_FILTER 0x0001UL
+#define SDDS_COLUMN_READ_FILTER    0x0002UL
+  epicsShareFuncSDDS extern int32_t SDDS_AddReadFilter(SDDS_DATASET *SDDS_dataset, uint32_t mode, char *name, double lower, double upper);
+  epicsShareFuncSDDS extern int32_t SDDS_ClearReadFilters(SDDS_DATASET *SDDS_dataset);
   epicsShareFuncSDDS extern int32_t SDDS_ReadAsciiPage(SDDS_DATASET *SDDS_dataset, int64_t sparse_interval,
                                                        int64_t sparse_offset, int32_t sparse_statistics);
   epicsShareFuncSDDS extern int32_t SDDS_ReadRecoveryPossible(SDDS_DATASET *SDDS_dataset);
@@ -886,7 +956,7 @@ extern "C" {
   int32_t SDDS_MPI_BufferedReadNonNativeBinaryTitle(SDDS_DATASET *SDDS_dataset);
   int32_t SDDS_MPI_CollectiveReadByRow(SDDS_DATASET *SDDS_dataset);
   MPI_Offset SDDS_MPI_Get_Column_Size(SDDS_DATASET *MPI_dataset);
-  int32_t SDDS_MPI_CollectiveWriteByRow(SDDS_DATASET *SDDS_dataset);
+  int32_t SDDS_MPI_CollectiveWritePage(SDDS_DATASET *SDDS_dataset, MPI_Offset data_offset, int64_t prev_rows, int64_t total_rows, int32_t swap_lengths);
   int32_t SDDS_MPI_Get_Title_Size(SDDS_DATASET *MPI_dataset);
   int32_t SDDS_MPI_BufferedWrite(void *target, int64_t targetSize, SDDS_DATASET *MPI_dataset);
   int32_t SDDS_MPI_FlushBuffer(SDDS_DATASET *MPI_Dataset);
@@ -914,10 +984,23 @@ extern "C" {
   int32_t SDDS_MPI_WriteBinaryPageByColumn(SDDS_DATASET *MPI_dataset);
   epicsShareFuncSDDS extern void SDDS_MPI_SetWriteKludgeUsleep(long value);
   epicsShareFuncSDDS extern void SDDS_MPI_SetFileSync(short value);
+  epicsShareFuncSDDS extern void SDDS_MPI_SetCollectiveWriteHints(int32_t cb_nodes, int32_t cb_buffer_size);
+  epicsShareFuncSDDS extern int32_t SDDS_MPI_SetAsynchronousWrite(SDDS_DATASET *SDDS_dataset, short async_io);
+  epicsShareFuncSDDS extern int32_t SDDS_MPI_CompletePendingWrite(SDDS_DATASET *SDDS_dataset);
+  epicsShareFuncSDDS extern int32_t SDDS_MPI_SetReadDecomposition(SDDS_DATASET *SDDS_dataset, short mode);
+  epicsShareFuncSDDS extern int32_t SDDS_MPI_SetSharedLayout(SDDS_DATASET *SDDS_dataset, short shared);
+  int32_t SDDS_MPI_ReadPageByColumns(SDDS_DATASET *SDDS_dataset);
+  int32_t SDDS_MPI_ReadSelectedRows(SDDS_DATASET *SDDS_dataset);
+  int32_t SDDS_MPI_StageCompressedOutput(SDDS_DATASET *SDDS_dataset, void *data, int64_t size);
+  int32_t SDDS_MPI_WriteCompressedData(SDDS_DATASET *SDDS_dataset, char *data, int64_t *piece_size, int32_t n_pieces);
+  int32_t SDDS_MPI_WriteCompressedPage(SDDS_DATASET *SDDS_dataset, int64_t rows, int32_t swap_lengths);
+  int32_t SDDS_MPI_FlushCompressedOutput(SDDS_DATASET *SDDS_dataset);
   epicsShareFuncSDDS extern void SDDS_MPI_Setup(SDDS_DATASET *SDDS_dataset, int32_t parallel_io, int32_t n_processors, int32_t myid, MPI_Comm comm, short master_read);
   
   /*SDDSmpi_input.c */
   epicsShareFuncSDDS extern int32_t SDDS_MPI_ReadPage(SDDS_DATASET *MPI_dataset);
+  epicsShareFuncSDDS extern int32_t SDDS_MPI_ReadPageSparse(SDDS_DATASET *SDDS_dataset, int64_t sparse_interval, int64_t sparse_offset);
+  epicsShareFuncSDDS extern int32_t SDDS_MPI_ReadPageLastRows(SDDS_DATASET *SDDS_dataset, int64_t last_rows);
   epicsShareFuncSDDS extern int32_t SDDS_MPI_InitializeInput(SDDS_DATASET *MPI_dataset, char *filename);
   epicsShareFuncSDDS extern int32_t SDDS_MPI_InitializeInputFromSearchPath(SDDS_DATASET *MPI_dataset, char *file);
   epicsShareFuncSDDS extern int32_t SDDS_Master_InitializeInput(SDDS_DATASET *SDDS_dataset, MPI_DATASET *MPI_dataset, char *file);
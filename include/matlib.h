@@ -67,6 +67,7 @@ extern "C" {
 typedef struct {
 	double **a;
 	int n, m;
+	double *block;	/* storage for all rows if allocated by m_alloc_contiguous(), else NULL */
 	} MATRIX;
 
 typedef struct {
@@ -92,6 +93,9 @@ epicsShareFuncMATLIB extern void mat_alloc(MATRIX **A, int n, int m);
 epicsShareFuncMATLIB extern void mat_alloc1(MATRIX **A, int n, int m);
 #define m_alloc1(A,n,m) mat_alloc1(A,n,m)
  
+epicsShareFuncMATLIB extern void mat_alloc_contiguous(MATRIX **A, int n, int m);
+#define m_alloc_contiguous(A,n,m) mat_alloc_contiguous(A,n,m)
+ 
 epicsShareFuncMATLIB extern int mat_copy(MATRIX *A, MATRIX *B);
 #define m_copy(A,B) mat_copy(A,B)
  
@@ -130,6 +134,10 @@ epicsShareFuncMATLIB extern void mat_identity(MATRIX *A);
  
 epicsShareFuncMATLIB extern int mat_check(MATRIX *A);
 #define m_check(A) mat_check(A)
+ 
+epicsShareFuncMATLIB extern int mat_set_threads(int threads);
+epicsShareFuncMATLIB extern int mat_get_threads(void);
+epicsShareFuncMATLIB extern void mat_benchmark(FILE *fp, int max_n, int threads);
 
 /* float versions  */
 
@@ -953,10 +953,38 @@ epicsShareFuncMDBMTH extern double random_oag(long iseed, long increment);
 epicsShareFuncMDBMTH extern double gauss_rn_oag(long iseed, long increment, double (*urandom)(long iseed1, long increment));
 epicsShareFuncMDBMTH extern double gauss_rn_lim_oag(double mean, double sigma, double limit_in_sigmas, long increment, double (*urandom)(long iseed, long increment));
 
+/* counter-based random number generator from drand.c */
+typedef struct {
+  uint32_t key[2];
+  uint64_t stream;   /* stream number, e.g., thread or MPI rank */
+  uint64_t position; /* number of uniform deviates drawn so far */
+} PHILOX_RNG;
+epicsShareFuncMDBMTH extern void philox_init(PHILOX_RNG *rng, uint64_t seed, uint64_t stream);
+epicsShareFuncMDBMTH extern void philox_skip(PHILOX_RNG *rng, uint64_t n);
+epicsShareFuncMDBMTH extern double philox_uniform(PHILOX_RNG *rng);
+epicsShareFuncMDBMTH extern double philox_gauss(PHILOX_RNG *rng);
+epicsShareFuncMDBMTH extern void philox_fill_uniform(PHILOX_RNG *rng, double *x, int64_t n);
+epicsShareFuncMDBMTH extern void philox_fill_gauss(PHILOX_RNG *rng, double *x, int64_t n);
+
 epicsShareFuncMDBMTH extern long randomizeOrder(char *ptr, long size, long length, long iseed, double (*urandom)(long iseed1));
 epicsShareFuncMDBMTH extern double nextHaltonSequencePoint(long ID);
 epicsShareFuncMDBMTH extern int32_t startHaltonSequence(int32_t *radix, double value);
 epicsShareFuncMDBMTH extern int32_t restartHaltonSequence(long ID, double value);
+/* multi-dimensional Halton sequences with explicit state, from halton.c */
+typedef struct {
+  long dimensions;
+  int32_t *radix;          /* prime base of each dimension */
+  long *digits;            /* base-radix digits in a 64-bit index */
+  long *tableDigits;       /* low digits looked up in table */
+  double **table;          /* radical inverse of the low digits, per dimension */
+  int32_t **permutation;   /* digit permutation per digit position, or NULL if not scrambled */
+  uint64_t index;          /* index of the next point */
+} HALTON_SEQUENCE;
+epicsShareFuncMDBMTH extern HALTON_SEQUENCE *halton_sequence_create(long dimensions, const int32_t *radix, long scramble, uint64_t seed);
+epicsShareFuncMDBMTH extern void halton_sequence_free(HALTON_SEQUENCE *seq);
+epicsShareFuncMDBMTH extern void halton_sequence_jump(HALTON_SEQUENCE *seq, uint64_t index);
+epicsShareFuncMDBMTH extern void halton_sequence_points(const HALTON_SEQUENCE *seq, uint64_t start, int64_t points, double *x);
+epicsShareFuncMDBMTH extern void halton_sequence_fill(HALTON_SEQUENCE *seq, double *x, int64_t points);
 epicsShareFuncMDBMTH extern double nextModHaltonSequencePoint(long ID);
 epicsShareFuncMDBMTH extern int32_t startModHaltonSequence(int32_t *radix, double value);
 epicsShareFuncMDBMTH extern int32_t restartModHaltonSequence(long ID, double tiny);
@@ -999,6 +1027,9 @@ epicsShareFuncMDBCOMMON long lsfg(double *xd, double *yd, double *sy,
     long n_pts, long n_terms, int32_t *order,
     double *coef, double *s_coef, double *chi, double *diff,
     double (*fn)(double x, long ord));
+epicsShareFuncMDBCOMMON long lsf_basis_fit(double *xd, double *yd, double *sy, long n_pts, long n_terms,
+    void (*basis)(double *row, double x, long n_terms, void *context), void *context,
+    double *coef, double *s_coef, double *chi, double *diff);
 
 /*functions for generation file names, moved from SDDSepics.c, May 8, 2002 */
 /*i.e. the declarations of functions in logfile_generation.c */
@@ -1130,6 +1161,7 @@ epicsShareFuncMDBMTH extern long mmid_odeint3_na(
     double exit_accuracy);
 
 epicsShareFuncMDBMTH void smoothData(double *data, long rows, long smoothPoints, long smoothPasses);
+epicsShareFuncMDBMTH void smoothDataColumns(double **data, long columns, long rows, long smoothPoints, long smoothPasses, long numThreads);
 epicsShareFuncMDBMTH long despikeData(double *data, long rows, long neighbors, long passes, long averageOf,
     double threshold, long countLimit);
 void SavitzkyGolayCoefficients(double *coef, long maxCoefs,
@@ -1138,6 +1170,9 @@ void SavitzkyGolayCoefficients(double *coef, long maxCoefs,
 epicsShareFuncMDBCOMMON long SavitzkyGolaySmooth(double *data, long rows,
                                               long order, long nLeft, 
                                               long nRight, long derivativeOrder);
+epicsShareFuncMDBCOMMON long SavitzkyGolaySmoothColumns(double **data, long columns, long rows,
+                                                     long order, long nLeft, long nRight,
+                                                     long derivativeOrder, long numThreads);
 epicsShareFuncMDBMTH void TouchFile(char *filename);
 
 #define SavitzyGolaySmooth(data, rows, order, nLeft, nRight, derivativeOrder) \
@@ -1231,8 +1266,30 @@ epicsShareFuncMDBMTH extern long compute_percentile(double *value, double *x, lo
 epicsShareFuncMDBMTH extern long compute_percentiles(double *value, double *percent, long values, double *x, long n);
 epicsShareFuncMDBMTH extern long compute_percentiles_flagged(double *position, double *percent, long positions, double *x,
                                                              int32_t *keep, int64_t n);
+epicsShareFuncMDBMTH extern long compute_percentiles_buffered(double *position, double *percent, long positions, double *x, long n,
+                                                              double *buffer);
+epicsShareFuncMDBMTH extern long select_order_statistics(double *value, long *rank, long ranks, double *x, long n);
 epicsShareFuncMDBMTH extern long approximate_percentiles(double *value, double *percent, long values, double *x, long n, long bins);
 
+/* streaming quantile sketch from median.c */
+typedef struct {
+  long k, levels;
+  long *size, *space; /* items held and allocated at each level */
+  long *capacity;     /* capacity of each level, recomputed when a level is added */
+  long totalCapacity;
+  double **item;      /* an item at level h stands for 2^h values */
+  int64_t count;
+  double min, max;
+  uint64_t random;
+} QUANTILE_SKETCH;
+epicsShareFuncMDBMTH extern QUANTILE_SKETCH *quantile_sketch_create(long k, uint64_t seed);
+epicsShareFuncMDBMTH extern void quantile_sketch_free(QUANTILE_SKETCH *sketch);
+epicsShareFuncMDBMTH extern long quantile_sketch_add(QUANTILE_SKETCH *sketch, double *x, long n);
+epicsShareFuncMDBMTH extern long quantile_sketch_merge(QUANTILE_SKETCH *target, QUANTILE_SKETCH *source);
+epicsShareFuncMDBMTH extern long quantile_sketch_percentiles(double *position, double *percent, long positions, QUANTILE_SKETCH *sketch);
+epicsShareFuncMDBMTH extern void *quantile_sketch_serialize(QUANTILE_SKETCH *sketch, long *bytes);
+epicsShareFuncMDBMTH extern QUANTILE_SKETCH *quantile_sketch_deserialize(void *buffer, long bytes);
+
 epicsShareFuncMDBMTH extern long find_average(double *value, double *x, long n);
 epicsShareFuncMDBMTH extern long find_middle(double *value, double *x, long n);
 epicsShareFuncMDBMTH extern long find_median(double *value, double *x, long n);
@@ -1243,6 +1300,10 @@ epicsShareFuncMDBMTH extern long make_histogram(double *hist, long n_bins, doubl
     int64_t n_pts, long new_start);
 epicsShareFuncMDBMTH extern long make_histogram_weighted(double *hist, long n_bins, double lo, double hi, double *data,
     long n_pts, long new_start, double *weight);
+epicsShareFuncMDBMTH extern int64_t make_histogram_threaded(double *hist, long n_bins, double lo, double hi, double *data,
+    double *weight, int64_t n_pts, long new_start, long numThreads);
+epicsShareFuncMDBMTH extern int64_t make_histogram_2d(double *hist, long x_bins, double x_lo, double x_hi, long y_bins, double y_lo,
+    double y_hi, double *x, double *y, double *weight, int64_t n_pts, long new_start, long numThreads);
 epicsShareFuncMDBMTH long computeMode(double *result, double *data, long pts, double binSize, long bins);
 
 epicsShareFuncMDBMTH int64_t findCrossingPoint(int64_t start, double *data, int64_t points, double level, long direction,
@@ -1301,6 +1362,7 @@ extern int find_max(double *max, double *loc, double *c1, double *c2, long n);
 epicsShareFuncMDBMTH extern double max_in_array(double *array, long n);
 epicsShareFuncMDBMTH extern double min_in_array(double *array, long n);
 epicsShareFuncMDBMTH extern void median_filter(double *x, double *m, long n, long w);
+epicsShareFuncMDBMTH extern void median_filter_rows(double **x, double **m, long rows, long n, long w, long numThreads);
 
 /*interpolate functions from interp.c */
 typedef struct {
@@ -1318,6 +1380,9 @@ epicsShareFuncMDBMTH extern double interpolate(double *f, double *x, int64_t n,
                                                OUTRANGE_CONTROL *belowRange, 
                                                OUTRANGE_CONTROL *aboveRange, 
                                                long order, unsigned long *returnCode, long M);
+epicsShareFuncMDBMTH extern unsigned long interpolate_array(double *result, unsigned long *returnCode, double *xo, int64_t nOut,
+                                                        double *f, double *x, int64_t n, OUTRANGE_CONTROL *belowRange,
+                                                        OUTRANGE_CONTROL *aboveRange, long order, long M, int64_t *bracket);
 epicsShareFuncMDBMTH extern double interp(double *y, double *x, long n, double x0, long warn, long order, long *returnCode);
 int interpolate_minimum(double *fmin, double *zmin, double *value, double z_lo,
     double z_hi, long n);
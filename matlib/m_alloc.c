@@ -41,6 +41,7 @@ void mat_alloc(MATRIX **A, int n, int m)
         if (((*A)->a = (double**)tmalloc(sizeof(double*)*n))) {
             (*A)->n = n;
             (*A)->m = m;
+            (*A)->block = NULL;
             if (m!=0) {
                 /* m==0 means only row pointers were wanted */
                 for (i=0; i<n; i++) {
@@ -58,6 +59,35 @@ void mat_alloc(MATRIX **A, int n, int m)
     abort();
     }
 
+/* Like m_alloc(), but the rows are consecutive in one block of memory, which the
+ * kernels in m_mult(), m_trans() and m_invert() traverse more efficiently.
+ * Such a matrix is freed by m_free() as usual, but its row pointers must not be
+ * freed or replaced individually.
+ */
+void mat_alloc_contiguous(MATRIX **A, int n, int m)
+{
+    register long i;
+
+    if (n<=0 || m<=0) {
+      fprintf(stderr, "error in m_alloc_contiguous: %d x %d array requested\n", n, m);
+      exit(1);
+    }
+    if ((*A = (MATRIX*)tmalloc(sizeof(**A)))) {
+        (*A)->a = (double**)tmalloc(sizeof(double*)*n);
+        (*A)->block = (double*)tmalloc(sizeof(double)*n*(size_t)m);
+        if ((*A)->a && (*A)->block) {
+            (*A)->n = n;
+            (*A)->m = m;
+            for (i=0; i<n; i++)
+                (*A)->a[i] = (*A)->block + i*(size_t)m;
+            m_zero(*A);
+            return;
+            }
+        }
+    puts("Allocation failure in m_alloc_contiguous().");
+    abort();
+    }
+
 void m_alloc1(MATRIX **A, int n, int m)
 {
     if (n<=0 || m<=0) {
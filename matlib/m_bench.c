@@ -27,6 +27,60 @@
 #include "matlib.h"
 
 void m_rand(MATRIX *A, double lo, double hi);
+
+/* Times the m_mult(), m_trans() and m_invert() kernels on square matrices of dimension 64, 128, ...
+ * up to max_n, with row-by-row (m_alloc) and contiguous (m_alloc_contiguous) storage, and prints
+ * GFLOP/s for multiplication (2n^3 flops) and inversion (2n^3 flops), and GB/s moved for transposition.
+ */
+void mat_benchmark(FILE *fp, int max_n, int threads)
+{
+    MATRIX *A, *B, *C;
+    int n, contiguous, previous;
+    long reps, r;
+    double start, mult, trans, invert, flops;
+
+    previous = mat_set_threads(threads);
+    fprintf(fp, "%6s %-10s %7s %12s %12s %12s\n", "n", "storage", "threads", "mult GFLOP/s", "trans GB/s", "inv GFLOP/s");
+    for (n=64; n<=max_n; n*=2) {
+        for (contiguous=0; contiguous<2; contiguous++) {
+            A = B = C = NULL;
+            if (contiguous) {
+                m_alloc_contiguous(&A, n, n);
+                m_alloc_contiguous(&B, n, n);
+                m_alloc_contiguous(&C, n, n);
+                }
+            else {
+                m_alloc(&A, n, n);
+                m_alloc(&B, n, n);
+                m_alloc(&C, n, n);
+                }
+            m_rand(A, -1.0, 1.0);
+            m_rand(B, -1.0, 1.0);
+            flops = 2.0*n*n*n;
+            /* repeat each kernel for about 1e9 flops or 1e8 elements */
+            reps = 1e9/flops<1 ? 1 : (long)(1e9/flops);
+            start = getTimeInSecs();
+            for (r=0; r<reps; r++)
+                m_mult(C, A, B);
+            mult = flops*reps/(getTimeInSecs()-start)/1e9;
+            start = getTimeInSecs();
+            for (r=0; r<reps; r++)
+                m_invert(C, A);
+            invert = flops*reps/(getTimeInSecs()-start)/1e9;
+            reps = 1e8/((double)n*n)<1 ? 1 : (long)(1e8/((double)n*n));
+            start = getTimeInSecs();
+            for (r=0; r<reps; r++)
+                m_trans(C, A);
+            trans = 2.0*sizeof(double)*n*n*reps/(getTimeInSecs()-start)/1e9;
+            fprintf(fp, "%6d %-10s %7d %12.3f %12.3f %12.3f\n", n, contiguous?"contiguous":"rows", mat_get_threads(), mult, trans, invert);
+            m_free(&A);
+            m_free(&B);
+            m_free(&C);
+            }
+        }
+    mat_set_threads(previous);
+    }
+
 void matlib_main()
 {
     MATRIX *A, *B, *C;
@@ -70,6 +124,10 @@ void matlib_main()
 #ifdef VAX_VMS
     report_stats(stdout, "stats: ");
 #endif
+
+    n = query_long("largest dimension for timing (0 to skip)", 1024L);
+    if (n>0)
+        mat_benchmark(stdout, (int)n, (int)query_long("number of threads", 1L));
     }
 
 void m_rand(
@@ -45,11 +45,16 @@ void mat_free(MATRIX **A)
     if (!A || !*A || !(*A)->a)
         return;
     n = (*A)->n;
-    for (i=0; i<n; i++) {
-        if ((*A)->a[i])
-            free((*A)->a[i]);
-        (*A)->a[i] = NULL;
+    if ((*A)->block) {
+        free((*A)->block);
+        (*A)->block = NULL;
         }
+    else
+        for (i=0; i<n; i++) {
+            if ((*A)->a[i])
+                free((*A)->a[i]);
+            (*A)->a[i] = NULL;
+            }
     free((*A)->a);
     (*A)->a = NULL;
     free(*A);
@@ -11,7 +11,7 @@
  * purpose: invert a matrix
  * usage: m_invert(A, B) ==>  A=INV(B); A and B must point to matrix
  * 	  structures of the same size.
- * Michael Borland, 1986 (after CITLIB routine MATINV)
+ * Michael Borland, 1986 (originally Gauss-Jordan after CITLIB routine MATINV; now LU-based)
  $Log: not supported by cvs2svn $
  Revision 1.3  1998/04/21 21:26:40  borland
  New names to allow concurrent use with the Meschach library.
@@ -24,18 +24,19 @@
 #include "mdb.h"
 #include "float.h"
 
-#define NDECADES (DBL_MAX_EXP-1)
-
+/* Columns of the inverse are found in strips of this width, which are shared among threads. */
+#define INVERT_STRIP 64
 
+/* Inverts B by LU decomposition with partial pivoting, PB = LU, then solves L.U.A = P for A.
+ * The work is done in private contiguous storage, so A and B may be the same matrix and several
+ * threads may invert different matrices at once.
+ */
 int mat_invert(MATRIX *A, MATRIX *B)         /* A=inv(B) */
 {
-    register long i, j, k, l, m, n;
-    static long *ipivot=NULL, **index=NULL, *ind_l;
-    static double *pivot=NULL, piv;
-    static double t, swap, amax, *tmp, abs_amax; 
-    static long row, col, max_n=0;
-    static double *a_j, *a_col, *a_m;
-    long log10_t, log10_piv;
+    long i, j, k, n, p, c0, c1;
+    long *perm, swap_index;
+    double *lu, *x, **row, *tmp, amax, piv, l, *r_i, *r_k, *x_i, *x_k;
+    int r, strip, strips, threads, bad;
 
     if (!A)
         bomb("NULL matrix (A) passed to m_invert", NULL);
@@ -51,114 +52,101 @@ int mat_invert(MATRIX *A, MATRIX *B)         /* A=inv(B) */
 	return(0);
         }
 
-    if (max_n<n) {
-        ipivot = trealloc(ipivot, sizeof(*ipivot)*n);
-        pivot  = trealloc(pivot, sizeof(*pivot)*n);
-        if (!index || !max_n)
-            index = (long**)zarray_2d(sizeof(**index), n, 2);
-        else
-            index = (long**)resize_zarray_2d(sizeof(**index), max_n, 2, (void**)index, n, 2);
-        max_n = n;
+    lu   = (double*)tmalloc(sizeof(*lu)*n*n);
+    x    = (double*)tmalloc(sizeof(*x)*n*n);
+    row  = (double**)tmalloc(sizeof(*row)*n);
+    perm = (long*)tmalloc(sizeof(*perm)*n);
+    for (i=0; i<n; i++) {
+        row[i] = lu+i*n;
+        memcpy(row[i], B->a[i], sizeof(double)*n);
+        perm[i] = i;
         }
-    if (!ipivot)
-        bomb("pivot index array is NULL (m_invert)", NULL);
-    if (!index)
-        bomb("index array is NULL (m_invert)", NULL);
-    if (!pivot)
-        bomb("pivot array is NULL (m_invert)", NULL);
+    threads = (double)n*n*n<1e6 ? 1 : mat_get_threads();
 
-    m_copy(A, B);
-    for (j=0; j<n; j++) 
-	ipivot[j] = 0;
+    /* factor, swapping row pointers rather than data */
+    for (k=0; k<n; k++) {
+        amax = 0;
+        p = k;
+        for (i=k; i<n; i++)
+            if (fabs(row[i][k])>amax) {
+                amax = fabs(row[i][k]);
+                p = i;
+                }
+        if (amax==0) {
+            free(lu);
+            free(x);
+            free(row);
+            free(perm);
+            return(0);
+            }
+        if (p!=k) {
+            tmp = row[p];
+            row[p] = row[k];
+            row[k] = tmp;
+            swap_index = perm[p];
+            perm[p] = perm[k];
+            perm[k] = swap_index;
+            }
+        r_k = row[k];
+        piv = r_k[k];
+#pragma omp parallel for private(r_i, l, j) num_threads(threads) if(threads>1 && n-k>64)
+        for (r=(int)k+1; r<(int)n; r++) {
+            r_i = row[r];
+            l = (r_i[k] /= piv);
+            for (j=k+1; j<n; j++)
+                r_i[j] -= l*r_k[j];
+            }
+        }
 
-    for (i=0; i<n; i++) {
-	/* search for pivot element */
-	amax = abs_amax = 0;
-	for (j=0; j<n; j++) {    
-    	    if (!(a_j = A->a[j])) {
-                fprintf(stderr, "row %ld of matrix A is NULL (m_invert):\n", j);
-                m_show(A, "%14.6e ", NULL, stderr);
-                abort();
+    /* solve L.U.X = P one strip of columns at a time; row i of P is 1 in column perm[i] */
+    for (i=0; i<n*n; i++)
+        x[i] = 0;
+    for (i=0; i<n; i++)
+        x[i*n+perm[i]] = 1;
+    strips = (n+INVERT_STRIP-1)/INVERT_STRIP;
+#pragma omp parallel for private(c0, c1, i, j, k, x_i, x_k, l) num_threads(threads)
+    for (strip=0; strip<strips; strip++) {
+        c0 = (long)strip*INVERT_STRIP;
+        c1 = c0+INVERT_STRIP<n ? c0+INVERT_STRIP : n;
+        for (i=1; i<n; i++) {
+            x_i = x+i*n;
+            for (k=0; k<i; k++) {
+                if ((l = row[i][k])==0)
+                    continue;
+                x_k = x+k*n;
+                for (j=c0; j<c1; j++)
+                    x_i[j] -= l*x_k[j];
                 }
-	    if (ipivot[j]!=1) {
-		for (k=0; k<n; k++) {
-		    if (ipivot[k]>1)
-			return(0);
-		    if (ipivot[k]!=1 && abs_amax<fabs(a_j[k])) {
-			col = k;
-			row = j;
-			abs_amax = fabs(amax = a_j[k]);
-			}
-		    }
-		}
-	    }
-        if (amax == 0.)
-    	    return(0);
-        ipivot[col] = ipivot[col] + 1;
-        /* interchange rows to put pivot element on diagonal */
-        if (row!=col) {
-	    tmp       = A->a[row];
-	    A->a[row] = A->a[col];
-	    A->a[col] = tmp;
-	    }
-        if (!index[i])
-            bomb("pivot index array has NULL element (m_invert)", NULL);
-        index[i][0] = row;
-        index[i][1] = col;
-        pivot[i] = A->a[col][col];
-        /* divide pivot row by pivot element */
-        A->a[col][col] = 1.;
-        a_col = A->a[col];
-        piv = pivot[i];
-        log10_piv = log10(FABS(piv))+0.5;
-        for (l=0; l<n; l++) {
-            if (a_col[l]!=0 && ((long)log10(FABS(a_col[l]))-log10_piv > NDECADES)) {
-                fprintf(stderr, "error: floating overflow in m_invert (pivot too small):\n");
-                m_show(A, "%14.6e ", NULL, stderr);
-                return(0);
+            }
+        for (i=n-1; i>=0; i--) {
+            x_i = x+i*n;
+            for (k=i+1; k<n; k++) {
+                if ((l = row[i][k])==0)
+                    continue;
+                x_k = x+k*n;
+                for (j=c0; j<c1; j++)
+                    x_i[j] -= l*x_k[j];
                 }
-	    a_col[l] /= piv;
+            l = 1/row[i][i];
+            for (j=c0; j<c1; j++)
+                x_i[j] *= l;
             }
-        /* reduce non-pivot rows */
-        for (m=0; m<n; m++) {
-    	    if (m!=col) {
-	    	a_m = A->a[m];
-	        t = a_m[col];
-	        a_m[col] = 0.;
-                if (t!=0)
-                    log10_t = log10(FABS(t))+0.5;
-                else
-                    log10_t = 0;
-	        for (l=0; l<n; l++) {
-                    if ((a_col[l]!=0?(long)log10(FABS(a_col[l])+0.5):0)+log10_t > NDECADES) {
-                        fprintf(stderr, "error: floating-point overflow in m_invert():\n");
-                        m_show(A, "%14.6e ", NULL, stderr);
-                        return(0);
-                        }
-		    a_m[l] -= a_col[l]*t;
-                    }
-		}
-	    }
-	}
+        }
 
-    /* interchange columns */
-    for (i=0; i<n; i++) {
-	l = n - i - 1;
-	ind_l = index[l];
-	if (ind_l[0] == ind_l[1])
-	    continue;
-	if ((row = ind_l[0])<0 || row>n) 
-            bomb("row out of range in column interchange (m_invert)", NULL);
-	if ((col = ind_l[1])<0 || col>n)
-            bomb("column out of range in column interchange (m_invert)", NULL);
-	for (j=0; j<n; j++) {
-	    a_j = A->a[j];
-	    swap = a_j[row];
-	    a_j[row] = a_j[col];
-	    a_j[col] = swap;
-	    }
-	}
-    return(1);
+    bad = 0;
+    for (i=0; i<n*n; i++)
+        if (isnan(x[i]) || isinf(x[i])) {
+            bad = 1;
+            break;
+            }
+    if (bad)
+        fprintf(stderr, "error: floating overflow in m_invert (pivot too small)\n");
+    else
+        for (i=0; i<n; i++)
+            memcpy(A->a[i], x+i*n, sizeof(double)*n);
+    free(lu);
+    free(x);
+    free(row);
+    free(perm);
+    return(!bad);
     }
-
-
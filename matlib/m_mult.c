@@ -20,28 +20,86 @@
  *
  */
 #include "matlib.h"
+#include "mdb.h"
+
+/* C is computed in blocks of rows, with the inner products split into blocks of k and of j so that
+ * the rows of B in use stay in cache while a block of rows of C is updated.  The innermost loop runs
+ * along rows of B and C, so the compiler can vectorize it.  Each element is still summed in order of
+ * increasing k, so results are the same as for the straightforward triple loop.
+ */
+#define MULT_BLOCK_I 32
+#define MULT_BLOCK_K 128
+#define MULT_BLOCK_J 512
+/* products with fewer multiply-adds than this are not worth threading */
+#define MULT_THREAD_MIN_WORK 1000000.0
+
+static int matThreads = 1;
+
+/* Sets the number of threads used by m_mult(), m_trans() and m_invert(), returning the previous value. */
+int mat_set_threads(int threads)
+{
+    int previous;
+
+    previous = matThreads;
+    matThreads = threads<1 ? 1 : threads;
+    return(previous);
+    }
+
+int mat_get_threads(void)
+{
+    return(matThreads);
+    }
+
+static void mat_mult_rows(double **c, double **a, double **b, long i0, long i1, long m, long p)
+{
+    long i, j, k, jj, kk, jEnd, kEnd;
+    double *c_i, *b_k, a_i_k;
+
+    for (i=i0; i<i1; i++)
+        for (j=0, c_i=c[i]; j<p; j++)
+            c_i[j] = 0;
+    for (jj=0; jj<p; jj+=MULT_BLOCK_J) {
+        jEnd = jj+MULT_BLOCK_J<p ? jj+MULT_BLOCK_J : p;
+        for (kk=0; kk<m; kk+=MULT_BLOCK_K) {
+            kEnd = kk+MULT_BLOCK_K<m ? kk+MULT_BLOCK_K : m;
+            for (i=i0; i<i1; i++) {
+                c_i = c[i];
+                for (k=kk; k<kEnd; k++) {
+                    a_i_k = a[i][k];
+                    b_k = b[k];
+                    for (j=jj; j<jEnd; j++)
+                        c_i[j] += a_i_k*b_k[j];
+                    }
+                }
+            }
+        }
+    }
 
 int mat_mult(
     MATRIX *C, MATRIX *A, MATRIX *B
     )
 {
-    register long i, j, k;
-    long n, m, p;
-    register double *a_i, *c_i, c_i_j;
+    long n, m, p, i;
+    int block, blocks, threads;
+    MATRIX *T;
 
     if ((m=A->m)!=B->n || (n=A->n)!=C->n || (p=B->m)!=C->m) 
         return(0);
-    for (i=0; i<n; i++) {
-        a_i = A->a[i];
-        c_i = C->a[i];
-        for (j=0; j<p; j++) {
-            c_i_j = 0;
-            for (k=0; k<m; k++) 
-	        c_i_j += a_i[k]*B->a[k][j];
-            c_i[j] = c_i_j;
-            }
+    if (C==A || C==B) {
+        /* the product can't be built in place */
+        T = NULL;
+        m_alloc(&T, n, p);
+        mat_mult(T, A, B);
+        for (i=0; i<n; i++)
+            memcpy(C->a[i], T->a[i], sizeof(double)*p);
+        m_free(&T);
+        return(1);
         }
+    blocks = (n+MULT_BLOCK_I-1)/MULT_BLOCK_I;
+    threads = (double)n*m*p<MULT_THREAD_MIN_WORK ? 1 : matThreads;
+#pragma omp parallel for schedule(dynamic) num_threads(threads)
+    for (block=0; block<blocks; block++)
+        mat_mult_rows(C->a, A->a, B->a, (long)block*MULT_BLOCK_I,
+                      (long)block*MULT_BLOCK_I+MULT_BLOCK_I<n ? (long)block*MULT_BLOCK_I+MULT_BLOCK_I : n, m, p);
     return(1);
     }
-
-
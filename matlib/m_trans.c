@@ -21,21 +21,41 @@
  */
 #include "matlib.h"
 
+/* the matrix is copied in 8x8 tiles, so each row of a tile is one cache line of A or B; larger tiles
+   suffer cache set conflicts when the rows of B are a power of two apart */
+#define TRANS_BLOCK 8
+
 int mat_trans(MATRIX *B, MATRIX *A)
 {
-    register long i, j;
-    register double *a_i, a_m, a_n;
+    long i, j, ii, jj, iEnd, jEnd, a_m, a_n;
+    int block, blocks, threads;
+    double swap;
     
     if (A->m!=B->n || A->n!=B->m)
         return(0);
     a_m = A->m;
     a_n = A->n;
-    for (i=0; i<a_n; i++) {
-        a_i = A->a[i];
-        for (j=0; j<a_m; j++)
-            B->a[j][i] = a_i[j];
+    if (A==B) {
+        for (i=0; i<a_n; i++)
+            for (j=i+1; j<a_m; j++) {
+                swap = A->a[i][j];
+                A->a[i][j] = A->a[j][i];
+                A->a[j][i] = swap;
+                }
+        return(1);
+        }
+    blocks = (a_n+TRANS_BLOCK-1)/TRANS_BLOCK;
+    threads = (double)a_n*a_m<1e6 ? 1 : mat_get_threads();
+#pragma omp parallel for private(ii, jj, iEnd, jEnd, i, j) num_threads(threads)
+    for (block=0; block<blocks; block++) {
+        ii = (long)block*TRANS_BLOCK;
+        iEnd = ii+TRANS_BLOCK<a_n ? ii+TRANS_BLOCK : a_n;
+        for (jj=0; jj<a_m; jj+=TRANS_BLOCK) {
+            jEnd = jj+TRANS_BLOCK<a_m ? jj+TRANS_BLOCK : a_m;
+            for (i=ii; i<iEnd; i++)
+                for (j=jj; j<jEnd; j++)
+                    B->a[j][i] = A->a[i][j];
+            }
         }
     return(1);
     }
-
-
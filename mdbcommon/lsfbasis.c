@@ -0,0 +1,183 @@
+/**
+ * @file lsfbasis.c
+ * @brief Computes linear least squares fits to an arbitrary set of basis functions.
+ *
+ * This file contains `lsf_basis_fit`, the solver shared by `lsfn`, `lsfp` and `lsfg`.  The weighted
+ * design matrix is reduced to triangular form one data point at a time by Givens rotations, so memory
+ * use does not grow with the number of points.
+ *
+ * @copyright
+ *   - (c) 2002 The University of Chicago, as Operator of Argonne National Laboratory.
+ *   - (c) 2002 The Regents of the University of California, as Operator of Los Alamos National Laboratory.
+ *
+ * @license
+ * This file is distributed under the terms of the Software License Agreement
+ * found in the file LICENSE included with this distribution.
+ */
+
+#include "matlib.h"
+#include "mdb.h"
+
+/* Applies Givens rotations that fold the weighted row a (with right-hand side b) into the upper
+   triangular n x n matrix r (row-major) and the rotated right-hand side z.  Both a and b are
+   overwritten. */
+static void lsf_givens_update(double *r, double *z, long n, double *a, double b) {
+  long j, k;
+  double rjj, aj, h, c, s, t;
+
+  for (j = 0; j < n; j++) {
+    if ((aj = a[j]) == 0)
+      continue;
+    if ((rjj = r[j * n + j]) == 0) {
+      for (k = j; k < n; k++)
+        r[j * n + k] = a[k];
+      z[j] = b;
+      return;
+    }
+    h = hypot(rjj, aj);
+    c = rjj / h;
+    s = aj / h;
+    r[j * n + j] = h;
+    for (k = j + 1; k < n; k++) {
+      t = r[j * n + k];
+      r[j * n + k] = c * t + s * a[k];
+      a[k] = c * a[k] - s * t;
+    }
+    t = z[j];
+    z[j] = c * t + s * b;
+    b = c * b - s * t;
+  }
+}
+
+/* Solves r.x = b in place, with r upper triangular and nonsingular. */
+static void lsf_back_substitute(double *r, long n, double *b) {
+  long i, k;
+  double sum;
+
+  for (i = n - 1; i >= 0; i--) {
+    sum = b[i];
+    for (k = i + 1; k < n; k++)
+      sum -= r[i * n + k] * b[k];
+    b[i] = sum / r[i * n + i];
+  }
+}
+
+/**
+ * @brief Computes a least squares fit of data to a linear combination of basis functions.
+ *
+ * The fit minimizes sum_i w_i (yd[i] - sum_j coef[j] f_j(xd[i]))^2, with w_i = 1/sy[i]^2.  Each row of
+ * sqrt(W).X is folded into the triangular factor R of a QR decomposition by Givens rotations, in
+ * O(n_pts*n_terms^2) time, and R.a = Qt.sqrt(W).y is solved by back substitution.  Unlike solving the
+ * normal equations, this does not square the condition number, so high-order fits remain solvable.
+ * The covariance matrix of the coefficients is INV(Xt.W.X) = INV(R).INV(R)t.  If all sy are equal, the fit is done unweighted
+ * and the covariance is scaled by sy[0]^2, as in the original matrix formulation of lsfn().
+ *
+ * @param xd Array of x data points.
+ * @param yd Array of y data points.
+ * @param sy Array of standard deviations of y data points, or NULL for an unweighted fit.
+ * @param n_pts Number of data points.
+ * @param n_terms Number of basis functions.
+ * @param basis Function that fills row[0..n_terms-1] with the basis functions evaluated at x.
+ * @param context Pointer passed through to @p basis.
+ * @param coef Array to store the computed coefficients.
+ * @param s_coef Array to store the standard deviations of the coefficients, or NULL.
+ * @param chi Pointer to store the reduced chi-squared value, or NULL.
+ * @param diff Array to store the differences between fitted and actual y values, or NULL.
+ * @return Returns 1 on success, or 0 on error.
+ */
+long lsf_basis_fit(double *xd, double *yd, double *sy, long n_pts, long n_terms,
+                   void (*basis)(double *row, double x, long n_terms, void *context), void *context,
+                   double *coef, double *s_coef, double *chi, double *diff) {
+  long i, j, k, unweighted;
+  double *row, *R, *z, *column, *variance, sw, norm, yp, residual, chiSum;
+
+  if (n_terms <= 0 || n_pts < n_terms)
+    return (p_merror("insufficient data for least squares fit"));
+
+  unweighted = 1;
+  if (sy)
+    for (i = 1; i < n_pts; i++)
+      if (sy[i] != sy[0]) {
+        unweighted = 0;
+        break;
+      }
+
+  row = malloc(sizeof(*row) * n_terms);
+  R = calloc(n_terms * n_terms, sizeof(*R));
+  z = calloc(n_terms, sizeof(*z));
+  column = malloc(sizeof(*column) * n_terms);
+  variance = calloc(n_terms, sizeof(*variance));
+  if (!row || !R || !z || !column || !variance) {
+    free(row);
+    free(R);
+    free(z);
+    free(column);
+    free(variance);
+    return (p_merror("allocating memory for least squares fit"));
+  }
+
+  for (i = 0; i < n_pts; i++) {
+    (*basis)(row, xd[i], n_terms, context);
+    sw = unweighted ? 1 : 1 / fabs(sy[i]);
+    for (j = 0; j < n_terms; j++)
+      row[j] *= sw;
+    lsf_givens_update(R, z, n_terms, row, sw * yd[i]);
+  }
+  /* column j of R has the norm of column j of sqrt(W).X; a diagonal element that is negligible
+     beside it means that basis function j is a combination of the others at these points */
+  for (j = 0; j < n_terms; j++) {
+    for (k = 0, norm = 0; k <= j; k++)
+      norm += sqr(R[k * n_terms + j]);
+    if (!(fabs(R[j * n_terms + j]) > n_terms * DBL_EPSILON * sqrt(norm))) {
+      free(row);
+      free(R);
+      free(z);
+      free(column);
+      free(variance);
+      return (p_merror("least squares fit is singular"));
+    }
+  }
+  lsf_back_substitute(R, n_terms, z);
+  for (j = 0; j < n_terms; j++)
+    coef[j] = z[j];
+
+  /* the variance of coefficient j is the sum of squares of row j of INV(R), whose columns are
+     found one at a time */
+  if (s_coef) {
+    for (k = 0; k < n_terms; k++) {
+      for (j = 0; j < n_terms; j++)
+        column[j] = j == k ? 1 : 0;
+      lsf_back_substitute(R, n_terms, column);
+      for (j = 0; j <= k; j++)
+        variance[j] += column[j] * column[j];
+    }
+    for (j = 0; j < n_terms; j++)
+      s_coef[j] = sqrt(variance[j] * (unweighted && sy ? sqr(sy[0]) : 1));
+  }
+
+  if (chi || diff) {
+    chiSum = 0;
+    for (i = 0; i < n_pts; i++) {
+      (*basis)(row, xd[i], n_terms, context);
+      for (j = 0, yp = 0; j < n_terms; j++)
+        yp += row[j] * coef[j];
+      residual = yp - yd[i];
+      if (diff)
+        diff[i] = residual;
+      residual /= sy ? sy[i] : 1;
+      chiSum += residual * residual;
+    }
+    if (chi) {
+      *chi = chiSum;
+      if (n_pts != n_terms)
+        *chi /= (n_pts - n_terms);
+    }
+  }
+
+  free(row);
+  free(R);
+  free(z);
+  free(column);
+  free(variance);
+  return (1);
+}
@@ -8,32 +8,13 @@
 
 #include "matlib.h"
 #include "mdb.h"
-#include "fftpackC.h"
 
-/**
- * @brief Applies Savitzky-Golay smoothing or differentiation to a data array.
- *
- * This function smooths the provided data array using the Savitzky-Golay method.
- * It can also compute derivatives of the data up to a specified order.
- * The smoothing is performed in-place on the input data array.
- *
- * @param data Pointer to the data array to be smoothed or differentiated.
- * @param rows Number of data points in the data array.
- * @param order Polynomial order of the smoothing filter.
- * @param nLeft Number of data points to include to the left of the central point in the smoothing window.
- * @param nRight Number of data points to include to the right of the central point in the smoothing window.
- * @param derivativeOrder Order of the derivative to compute (0 for smoothing only).
- * @return Returns 1 on success, 0 on failure due to invalid parameters or memory allocation error.
- *
- * @note The function modifies the input data array in place.
- * @warning The input data array must have at least (nLeft + nRight + 1) elements.
- * @warning This function is not thread-safe due to the use of static internal buffers.
- */
-long SavitzkyGolaySmooth(double *data, long rows, long order, long nLeft, long nRight, long derivativeOrder) {
-  static double *FFTdata = NULL, *FFTfilter = NULL, *TMPdata = NULL;
-  static long arraySize = 0, TMParraySize = 0;
-  long i, nfreq, sizeNeeded;
+/* outputs computed together by SavitzkyGolayFilter(), so that each pass over the coefficients
+   runs over a vector of rows that stays in cache */
+#define SG_BLOCK 512
 
+/* Checks the arguments of SavitzkyGolaySmooth(), printing a message for the first bad one. */
+static long SavitzkyGolayCheck(long rows, long order, long nLeft, long nRight, long derivativeOrder) {
   if (order < 0) {
     fprintf(stderr, "order<0 (SavitzkyGolaySmooth)\n");
     return (0);
@@ -66,114 +47,173 @@ long SavitzkyGolaySmooth(double *data, long rows, long order, long nLeft, long n
     fprintf(stderr, "rows<(nLeft+nRight+1) (SavitzkyGolaySmooth)\n");
     return (0);
   }
+  return (1);
+}
 
-  if ((order == 1) && (nLeft == nRight) && (derivativeOrder == 0)) {
-    /* This is a special case of the filter. Sometimes called moving window averaging. */
-    /* It requires that nLeft=nRight and this is the only option for elegant now */
-    long np = nLeft + nRight + 1;
-    double scale = 1.0 / np;
+/* Moving window average, the special case order=1, nLeft=nRight, derivativeOrder=0, done with a
+   running sum.  TMPdata must hold rows values. */
+static void SavitzkyGolayAverage(double *data, long rows, long nLeft, long nRight, double *TMPdata) {
+  long i, np = nLeft + nRight + 1;
+  double scale = 1.0 / np;
 
-    sizeNeeded = rows;
-    if (TMParraySize < sizeNeeded && (!(TMPdata = realloc(TMPdata, sizeof(*TMPdata) * (TMParraySize = sizeNeeded))))) {
-      fprintf(stderr, "Error: memory allocation failure (SavitzkyGolaySmooth)\n");
-      exit(1);
-    }
+  for (i = 0; i < rows; i++) {
+    data[i] = scale * data[i];
+    TMPdata[i] = data[i];
+  }
 
-    for (i = 0; i < rows; i++) {
-      data[i] = scale * data[i];
-      TMPdata[i] = data[i];
-    }
+  /* Smooth the left side data with padding to eliminate end effects */
+  for (i = 1; i <= nRight; i++)
+    data[0] += data[i];
+  data[0] += nLeft * TMPdata[0];
 
-    /* Smooth the left side data with padding to eliminate end effects */
-    for (i = 1; i <= nRight; i++)
-      data[0] += data[i];
-    data[0] += nLeft * TMPdata[0];
+  for (i = 1; i <= nLeft; i++) {
+    data[i] = data[i - 1] + data[i + nRight] - TMPdata[0];
+  }
 
-    for (i = 1; i <= nLeft; i++) {
-      data[i] = data[i - 1] + data[i + nRight] - TMPdata[0];
-    }
+  /* Smooth the middle part of the array */
+  for (i = nLeft + 1; i < rows - nRight; i++) {
+    data[i] = data[i - 1] + data[i + nRight] - TMPdata[i - nLeft - 1];
+  }
 
-    /* Smooth the middle part of the array */
-    for (i = nLeft + 1; i < rows - nRight; i++) {
-      data[i] = data[i - 1] + data[i + nRight] - TMPdata[i - nLeft - 1];
-    }
+  /* Smooth the right side data with padding to eliminate end effects */
+  for (i = rows - nRight; i < rows; i++) {
+    data[i] = data[i - 1] + data[rows - 1] - TMPdata[i - nLeft - 1];
+  }
+}
 
-    /* Smooth the right side data with padding to eliminate end effects */
-    for (i = rows - nRight; i < rows; i++) {
-      data[i] = data[i - 1] + data[rows - 1] - TMPdata[i - nLeft - 1];
-    }
+/* Convolves data with the filter coefficients (in wrap-around order) in the time domain.
+   TMPdata must hold rows+nLeft+nRight values.  The terms of each output are summed in the same
+   order as a direct loop over the coefficients; only the loop nesting differs. */
+static void SavitzkyGolayFilter(double *data, long rows, long nLeft, long nRight, double *filterCoeff, double *TMPdata) {
+  long np = nLeft + nRight + 1, i, i0, i1, j;
+  double *in, c;
 
-    return (1);
-  } else { /* Smooth data in the time domain */
-    long np = nLeft + nRight + 1, j;
-    static long coeffArraySize = 0;
-    static double *filterCoeff = NULL;
+  /* copy the data to a temporary array, with padding to eliminate end effects */
+  for (i = 0; i < rows; i++)
+    TMPdata[i + nLeft] = data[i];
+  for (i = 0; i < nLeft; i++)
+    TMPdata[i] = data[0];
+  for (i = 0; i < nRight; i++)
+    TMPdata[rows + nLeft + i] = data[rows - 1];
 
-    sizeNeeded = rows + nLeft + nRight;
-    if (TMParraySize < sizeNeeded && (!(TMPdata = realloc(TMPdata, sizeof(*TMPdata) * (TMParraySize = sizeNeeded))))) {
-      fprintf(stderr, "Error: memory allocation failure (SavitzkyGolaySmooth)\n");
-      exit(1);
+  for (i0 = 0; i0 < rows; i0 = i1) {
+    i1 = i0 + SG_BLOCK < rows ? i0 + SG_BLOCK : rows;
+    for (i = i0; i < i1; i++)
+      data[i] = data[i] * filterCoeff[0];
+    for (j = 1; j <= nLeft; j++) {
+      c = filterCoeff[j];
+      in = TMPdata + nLeft - j;
+      for (i = i0; i < i1; i++)
+        data[i] += in[i] * c;
     }
-    if (coeffArraySize < np && (!(filterCoeff = realloc(filterCoeff, sizeof(*filterCoeff) * (coeffArraySize = np))))) {
-      fprintf(stderr, "Error: memory allocation failure (SavitzkyGolaySmooth)\n");
-      exit(1);
+    for (j = 1; j <= nRight; j++) {
+      c = filterCoeff[np - j];
+      in = TMPdata + nLeft + j;
+      for (i = i0; i < i1; i++)
+        data[i] += in[i] * c;
     }
+  }
+}
 
-    /* copy the data to a temporary array, with padding to eliminate end effects */
-    for (i = 0; i < rows; i++)
-      TMPdata[i + nLeft] = data[i];
-    for (i = 0; i < nLeft; i++)
-      TMPdata[i] = data[0];
-    for (i = 0; i < nRight; i++)
-      TMPdata[rows + nLeft + i] = data[rows - 1];
+/**
+ * @brief Applies Savitzky-Golay smoothing or differentiation to a data array.
+ *
+ * This function smooths the provided data array using the Savitzky-Golay method.
+ * It can also compute derivatives of the data up to a specified order.
+ * The smoothing is performed in-place on the input data array.
+ *
+ * @param data Pointer to the data array to be smoothed or differentiated.
+ * @param rows Number of data points in the data array.
+ * @param order Polynomial order of the smoothing filter.
+ * @param nLeft Number of data points to include to the left of the central point in the smoothing window.
+ * @param nRight Number of data points to include to the right of the central point in the smoothing window.
+ * @param derivativeOrder Order of the derivative to compute (0 for smoothing only).
+ * @return Returns 1 on success, 0 on failure due to invalid parameters or memory allocation error.
+ *
+ * @note The function modifies the input data array in place.
+ * @warning The input data array must have at least (nLeft + nRight + 1) elements.
+ */
+long SavitzkyGolaySmooth(double *data, long rows, long order, long nLeft, long nRight, long derivativeOrder) {
+  double *TMPdata, *filterCoeff;
+  long np = nLeft + nRight + 1;
 
-    /* store SG coefficients in wrap-around order  */
-    SavitzkyGolayCoefficients(filterCoeff, np, order, nLeft, nRight, derivativeOrder, 1);
+  if (!SavitzkyGolayCheck(rows, order, nLeft, nRight, derivativeOrder))
+    return (0);
 
-    for (i = 0; i < rows; i++) {
-      data[i] = data[i] * filterCoeff[0];
-      for (j = 1; j <= nLeft; j++)
-        data[i] += TMPdata[i + nLeft - j] * filterCoeff[j];
-      for (j = 1; j <= nRight; j++)
-        data[i] += TMPdata[i + nLeft + j] * filterCoeff[np - j];
+  if ((order == 1) && (nLeft == nRight) && (derivativeOrder == 0)) {
+    /* This is a special case of the filter. Sometimes called moving window averaging. */
+    /* It requires that nLeft=nRight and this is the only option for elegant now */
+    if (!(TMPdata = malloc(sizeof(*TMPdata) * rows))) {
+      fprintf(stderr, "Error: memory allocation failure (SavitzkyGolaySmooth)\n");
+      exit(1);
     }
+    SavitzkyGolayAverage(data, rows, nLeft, nRight, TMPdata);
+    free(TMPdata);
     return (1);
   }
 
-  /* Below are the old implementation in the frequency domain, which could be very time consuming */
-  sizeNeeded = 2 * (rows + 1 + nLeft + nRight);
-  if (arraySize < sizeNeeded && (!(FFTdata = realloc(FFTdata, sizeof(*FFTdata) * (arraySize = sizeNeeded))) || !(FFTfilter = realloc(FFTfilter, sizeof(*FFTfilter) * (arraySize = sizeNeeded))))) {
+  /* Smooth data in the time domain */
+  if (!(TMPdata = malloc(sizeof(*TMPdata) * (rows + nLeft + nRight))) ||
+      !(filterCoeff = malloc(sizeof(*filterCoeff) * np))) {
     fprintf(stderr, "Error: memory allocation failure (SavitzkyGolaySmooth)\n");
     exit(1);
   }
-  for (i = 0; i < arraySize; i++)
-    FFTdata[i] = FFTfilter[i] = 0;
-
   /* store SG coefficients in wrap-around order  */
-  SavitzkyGolayCoefficients(FFTfilter, 2 * (rows + nLeft + nRight), order, nLeft, nRight, derivativeOrder, 1);
-
-  /* copy the data to work array, with padding to eliminate end effects */
-  for (i = 0; i < rows; i++)
-    FFTdata[i + nLeft] = data[i];
-  for (i = 0; i < nLeft; i++)
-    FFTdata[i] = data[0];
-  for (i = 0; i < nRight; i++)
-    FFTdata[rows + nLeft + i] = data[rows - 1];
-
-  /* Take FFTs of signal and filter */
-  realFFT2(FFTdata, FFTdata, 2 * (rows + nLeft + nRight), 0);
-  realFFT2(FFTfilter, FFTfilter, 2 * (rows + nLeft + nRight), 0);
-
-  /* Multiply FFTs */
-  nfreq = rows + nLeft + nRight + 1;
-  for (i = 0; i < nfreq; i++)
-    complex_multiply(FFTdata + 2 * i, FFTdata + 2 * i + 1, FFTdata[2 * i], FFTdata[2 * i + 1], FFTfilter[2 * i], FFTfilter[2 * i + 1]);
+  SavitzkyGolayCoefficients(filterCoeff, np, order, nLeft, nRight, derivativeOrder, 1);
+  SavitzkyGolayFilter(data, rows, nLeft, nRight, filterCoeff, TMPdata);
+  free(TMPdata);
+  free(filterCoeff);
+  return (1);
+}
 
-  /* Do inverse FFT */
-  realFFT2(FFTdata, FFTdata, 2 * (rows + nLeft + nRight), INVERSE_FFT);
-  for (i = 0; i < rows; i++)
-    data[i] = FFTdata[i + nLeft] * 2 * (rows + nLeft + nRight);
+/**
+ * @brief Applies Savitzky-Golay smoothing or differentiation to several data arrays.
+ *
+ * Gives the same results as calling SavitzkyGolaySmooth() on each column, but the filter
+ * coefficients are computed once and the columns are processed in parallel.
+ *
+ * @param data Array of pointers to the columns to be smoothed or differentiated in place.
+ * @param columns Number of columns.
+ * @param rows Number of data points in each column.
+ * @param order Polynomial order of the smoothing filter.
+ * @param nLeft Number of data points to include to the left of the central point in the smoothing window.
+ * @param nRight Number of data points to include to the right of the central point in the smoothing window.
+ * @param derivativeOrder Order of the derivative to compute (0 for smoothing only).
+ * @param numThreads Number of threads to use.
+ * @return Returns 1 on success, 0 on failure due to invalid parameters.
+ */
+long SavitzkyGolaySmoothColumns(double **data, long columns, long rows, long order, long nLeft, long nRight,
+                                long derivativeOrder, long numThreads) {
+  double *filterCoeff = NULL;
+  long np = nLeft + nRight + 1, average;
+  int column;
 
+  if (!SavitzkyGolayCheck(rows, order, nLeft, nRight, derivativeOrder))
+    return (0);
+  average = (order == 1) && (nLeft == nRight) && (derivativeOrder == 0);
+  if (!average) {
+    if (!(filterCoeff = malloc(sizeof(*filterCoeff) * np))) {
+      fprintf(stderr, "Error: memory allocation failure (SavitzkyGolaySmoothColumns)\n");
+      exit(1);
+    }
+    SavitzkyGolayCoefficients(filterCoeff, np, order, nLeft, nRight, derivativeOrder, 1);
+  }
+  if (numThreads < 1)
+    numThreads = 1;
+#pragma omp parallel for schedule(dynamic) num_threads(numThreads)
+  for (column = 0; column < columns; column++) {
+    double *TMPdata;
+    if (!(TMPdata = malloc(sizeof(*TMPdata) * (rows + nLeft + nRight)))) {
+      fprintf(stderr, "Error: memory allocation failure (SavitzkyGolaySmoothColumns)\n");
+      exit(1);
+    }
+    if (average)
+      SavitzkyGolayAverage(data[column], rows, nLeft, nRight, TMPdata);
+    else
+      SavitzkyGolayFilter(data[column], rows, nLeft, nRight, filterCoeff, TMPdata);
+    free(TMPdata);
+  }
+  free(filterCoeff);
   return (1);
 }
 
@@ -186,36 +226,11 @@ typedef struct
 static SAVITZKYGOLAY_COEF *svCoef = NULL;
 static long nSVCoef = 0;
 
-void SavitzkyGolayCoefficients(double *coef, long maxCoefs, long order, long nLeft, long nRight, long derivativeOrder, long wrapAround) {
+/* Computes the coefficients for points -nLeft..nRight, in that order. */
+static void SavitzkyGolayCompute(double *coef, long order, long nLeft, long nRight, long derivativeOrder) {
   MATRIX *A, *At, *AtA;
-  long i, j, m, iStore;
+  long i, j, m;
   double factor;
-  long iSave;
-
-  if (!coef || order < 0 || derivativeOrder < 0 || derivativeOrder > order || (nLeft + nRight) < order || nLeft < 0 || nRight < 0 || maxCoefs < (nLeft + nRight + 1)) {
-    fprintf(stderr, "Error: invalid arguments (savitzkyGolayCoefficients)\n");
-    exit(1);
-  }
-
-  for (i = 0; i < maxCoefs; i++)
-    coef[i] = 0;
-
-  /* see if these coefs are already stored.  if so, just copy them and return. */
-  for (iSave = 0; iSave < nSVCoef; iSave++) {
-    if (order == svCoef[iSave].order && nLeft == svCoef[iSave].left && nRight == svCoef[iSave].right && derivativeOrder == svCoef[iSave].derivOrder) {
-      for (i = -nLeft; i <= nRight; i++) {
-        if (wrapAround) {
-          if (i <= 0)
-            iStore = -i;
-          else
-            iStore = maxCoefs - i;
-        } else
-          iStore = i + nLeft;
-        coef[iStore] = svCoef[iSave].coef[i + nLeft];
-      }
-      return;
-    }
-  }
 
   m_alloc(&A, nLeft + nRight + 1, order + 1);
   m_alloc(&At, order + 1, nLeft + nRight + 1);
@@ -234,14 +249,66 @@ void SavitzkyGolayCoefficients(double *coef, long maxCoefs, long order, long nLe
     exit(1);
   }
 
-  if (!(svCoef = realloc(svCoef, sizeof(*svCoef) * (nSVCoef + 1))) || !(svCoef[nSVCoef].coef = malloc(sizeof(*svCoef[nSVCoef].coef) * (nRight + nLeft + 1)))) {
-    fprintf(stderr, "Error: memory allocation failure (savitzkyGolayCoefficients)\n");
+  for (i = -nLeft; i <= nRight; i++) {
+    coef[i + nLeft] = 0;
+    factor = 1;
+    for (m = 0; m <= order; m++) {
+      coef[i + nLeft] += AtA->a[derivativeOrder][m] * factor;
+      factor *= i;
+    }
+  }
+  m_free(&A);
+  m_free(&At);
+  m_free(&AtA);
+}
+
+/**
+ * @brief Computes Savitzky-Golay filter coefficients.
+ *
+ * The coefficients for each (order, nLeft, nRight, derivativeOrder) are computed once and kept for
+ * later calls.  The cache is shared by all threads.
+ *
+ * @param coef Array to store the coefficients.
+ * @param maxCoefs Size of coef, at least nLeft+nRight+1.
+ * @param order Polynomial order of the filter.
+ * @param nLeft Number of points to the left of the central point.
+ * @param nRight Number of points to the right of the central point.
+ * @param derivativeOrder Order of the derivative.
+ * @param wrapAround If nonzero, store the coefficient for point i at i<=0 ? -i : maxCoefs-i, as
+ *                   needed for convolution; otherwise at i+nLeft.
+ */
+void SavitzkyGolayCoefficients(double *coef, long maxCoefs, long order, long nLeft, long nRight, long derivativeOrder, long wrapAround) {
+  long i, iStore, iSave;
+  double *saved;
+
+  if (!coef || order < 0 || derivativeOrder < 0 || derivativeOrder > order || (nLeft + nRight) < order || nLeft < 0 || nRight < 0 || maxCoefs < (nLeft + nRight + 1)) {
+    fprintf(stderr, "Error: invalid arguments (savitzkyGolayCoefficients)\n");
     exit(1);
   }
-  svCoef[nSVCoef].left = nLeft;
-  svCoef[nSVCoef].right = nRight;
-  svCoef[nSVCoef].derivOrder = derivativeOrder;
-  svCoef[nSVCoef].order = order;
+
+  for (i = 0; i < maxCoefs; i++)
+    coef[i] = 0;
+
+#pragma omp critical(SavitzkyGolayCoefficients)
+  {
+    /* see if these coefs are already stored; if not, compute and store them */
+    for (iSave = 0; iSave < nSVCoef; iSave++)
+      if (order == svCoef[iSave].order && nLeft == svCoef[iSave].left && nRight == svCoef[iSave].right && derivativeOrder == svCoef[iSave].derivOrder)
+        break;
+    if (iSave == nSVCoef) {
+      if (!(svCoef = realloc(svCoef, sizeof(*svCoef) * (nSVCoef + 1))) || !(svCoef[nSVCoef].coef = malloc(sizeof(*svCoef[nSVCoef].coef) * (nRight + nLeft + 1)))) {
+        fprintf(stderr, "Error: memory allocation failure (savitzkyGolayCoefficients)\n");
+        exit(1);
+      }
+      svCoef[nSVCoef].left = nLeft;
+      svCoef[nSVCoef].right = nRight;
+      svCoef[nSVCoef].derivOrder = derivativeOrder;
+      svCoef[nSVCoef].order = order;
+      SavitzkyGolayCompute(svCoef[nSVCoef].coef, order, nLeft, nRight, derivativeOrder);
+      nSVCoef++;
+    }
+    saved = svCoef[iSave].coef;
+  }
 
   for (i = -nLeft; i <= nRight; i++) {
     if (wrapAround) {
@@ -251,16 +318,6 @@ void SavitzkyGolayCoefficients(double *coef, long maxCoefs, long order, long nLe
         iStore = maxCoefs - i;
     } else
       iStore = i + nLeft;
-    coef[iStore] = 0;
-    factor = 1;
-    for (m = 0; m <= order; m++) {
-      coef[iStore] += AtA->a[derivativeOrder][m] * factor;
-      factor *= i;
-    }
-    svCoef[nSVCoef].coef[i + nLeft] = coef[iStore];
+    coef[iStore] = saved[i + nLeft];
   }
-  nSVCoef++;
-  m_free(&A);
-  m_free(&At);
-  m_free(&AtA);
 }
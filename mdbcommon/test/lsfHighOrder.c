@@ -0,0 +1,75 @@
+/**
+ * @file lsfHighOrder.c
+ * @brief Checks that lsfn() solves high-order polynomial fits.
+ *
+ * Two hundred points with x in [0, 100) are fitted, with and without weights, at orders up to 16,
+ * where Xt.W.X is too ill-conditioned to factor in double precision.  Every fit must succeed, and since
+ * the fits are nested, chi-squared must not grow with the order.  A low-order polynomial must be
+ * recovered exactly, and a singular fit must fail without changing the coefficients.
+ *
+ * @copyright
+ *   - (c) 2002 The University of Chicago, as Operator of Argonne National Laboratory.
+ *   - (c) 2002 The Regents of the University of California, as Operator of Los Alamos National Laboratory.
+ *
+ * @license
+ * This file is distributed under the terms of the Software License Agreement
+ * found in the file LICENSE included with this distribution.
+ */
+
+#include "mdb.h"
+
+#define POINTS 200
+#define MAX_ORDER 16
+
+int main(int argc, char **argv) {
+  double x[POINTS], y[POINTS], sy[POINTS], diff[POINTS];
+  double coef[MAX_ORDER + 1], s_coef[MAX_ORDER + 1], chi, chiSum, lastChiSum;
+  long i, order, weighted, failures = 0;
+
+  for (i = 0; i < POINTS; i++) {
+    x[i] = i * 0.5;
+    y[i] = sin(x[i] / 10) + 0.01 * ((i * 7919) % 13 - 6);
+    sy[i] = 0.01 * (1 + i % 5);
+  }
+  for (weighted = 0; weighted < 2; weighted++) {
+    lastChiSum = DBL_MAX;
+    for (order = 1; order <= MAX_ORDER; order++) {
+      if (!lsfn(x, y, weighted ? sy : NULL, POINTS, order, coef, s_coef, &chi, diff)) {
+        fprintf(stderr, "order %ld fit failed (weighted=%ld)\n", order, weighted);
+        failures++;
+        continue;
+      }
+      chiSum = chi * (POINTS - order - 1);
+      /* allow for rounding when a higher order barely improves the fit */
+      if (chiSum > lastChiSum * (1 + 1e-6)) {
+        fprintf(stderr, "order %ld chi-squared %g exceeds that of order %ld, %g (weighted=%ld)\n",
+                order, chiSum, order - 1, lastChiSum, weighted);
+        failures++;
+      }
+      lastChiSum = chiSum;
+    }
+  }
+
+  for (i = 0; i < POINTS; i++)
+    y[i] = 1 + x[i] * (2 + x[i] * (-0.01 + x[i] * 1e-4));
+  for (weighted = 0; weighted < 2; weighted++) {
+    if (!lsfn(x, y, weighted ? sy : NULL, POINTS, 3, coef, s_coef, &chi, diff) ||
+        fabs(coef[0] - 1) > 1e-9 || fabs(coef[1] - 2) > 1e-9 || fabs(coef[2] + 0.01) > 1e-12 ||
+        fabs(coef[3] - 1e-4) > 1e-14) {
+      fprintf(stderr, "cubic not recovered (weighted=%ld)\n", weighted);
+      failures++;
+    }
+  }
+
+  for (i = 0; i < POINTS; i++)
+    x[i] = 1;
+  for (i = 0; i <= 2; i++)
+    coef[i] = -1;
+  if (lsfn(x, y, NULL, POINTS, 2, coef, s_coef, &chi, diff) || coef[0] != -1 || coef[1] != -1 || coef[2] != -1) {
+    fprintf(stderr, "singular fit succeeded or changed the coefficients\n");
+    failures++;
+  }
+
+  fprintf(stderr, "lsfHighOrder: %s\n", failures ? "FAILED" : "passed");
+  return failures ? 1 : 0;
+}
@@ -579,3 +579,216 @@ double gauss_rn_lim_oag(
 
   return (sigma * value + mean);
 }
+
+/* Philox4x32-10 (Salmon et al., "Parallel random numbers: as easy as 1, 2, 3", SC11).  Each 128-bit
+   counter is encrypted under a 64-bit key by ten rounds of multiply/xor, giving four 32-bit words,
+   which are used as two uniform deviates with 52-bit resolution.  The generator has no hidden
+   state: deviate i of a stream comes from counter i/2, so any position can be reached directly. */
+#define PHILOX_M0 0xD2511F53U
+#define PHILOX_M1 0xCD9E8D57U
+#define PHILOX_W0 0x9E3779B9U
+#define PHILOX_W1 0xBB67AE85U
+/* deviates converted per pass of the bulk fill routines */
+#define PHILOX_CHUNK 256
+
+static void philox4x32_10(uint32_t out[4], uint64_t block, uint64_t stream, const uint32_t key[2]) {
+  uint32_t c0, c1, c2, c3, k0, k1;
+  uint64_t p0, p1;
+  int round;
+
+  c0 = (uint32_t)block;
+  c1 = (uint32_t)(block >> 32);
+  c2 = (uint32_t)stream;
+  c3 = (uint32_t)(stream >> 32);
+  k0 = key[0];
+  k1 = key[1];
+  for (round = 0; round < 10; round++) {
+    p0 = (uint64_t)PHILOX_M0 * c0;
+    p1 = (uint64_t)PHILOX_M1 * c2;
+    c0 = (uint32_t)(p1 >> 32) ^ c1 ^ k0;
+    c2 = (uint32_t)(p0 >> 32) ^ c3 ^ k1;
+    c1 = (uint32_t)p1;
+    c3 = (uint32_t)p0;
+    k0 += PHILOX_W0;
+    k1 += PHILOX_W1;
+  }
+  out[0] = c0;
+  out[1] = c1;
+  out[2] = c2;
+  out[3] = c3;
+}
+
+/* Maps 52 random bits to an odd multiple of 2^-53, i.e., to the centre of one of 2^52 equal cells of
+   the open interval (0, 1), so that log() of the result is finite.  The integer is below 2^53 and the
+   scale is a power of 2, so both steps are exact and the result is at most 1-2^-53.  (Centring 53
+   bits would need 54-bit results above 0.5, which round to 1.0.) */
+static double philox_to_double(uint32_t hi, uint32_t lo) {
+  return ((double)hi * 2097152.0 + (double)((lo >> 11) | 1)) * (1.0 / 9007199254740992.0);
+}
+
+/* Encrypts PHILOX_LANES consecutive counters and stores the 2*PHILOX_LANES deviates in u.  The
+   rounds are written out per lane, with the words kept in separate arrays, so that the compiler
+   can vectorize across lanes. */
+#define PHILOX_LANES 16
+static void philox_lanes(double *u, uint64_t block, uint64_t stream, const uint32_t key[2]) {
+  uint32_t w0[PHILOX_LANES], w1[PHILOX_LANES], w2[PHILOX_LANES], w3[PHILOX_LANES];
+  uint32_t c0, c1, c2, c3, k0, k1, t0, t2;
+  uint64_t p0, p1;
+  int round, l;
+
+  for (l = 0; l < PHILOX_LANES; l++) {
+    c0 = (uint32_t)(block + l);
+    c1 = (uint32_t)((block + l) >> 32);
+    c2 = (uint32_t)stream;
+    c3 = (uint32_t)(stream >> 32);
+    k0 = key[0];
+    k1 = key[1];
+    for (round = 0; round < 10; round++) {
+      p0 = (uint64_t)PHILOX_M0 * c0;
+      p1 = (uint64_t)PHILOX_M1 * c2;
+      t0 = (uint32_t)(p1 >> 32) ^ c1 ^ k0;
+      t2 = (uint32_t)(p0 >> 32) ^ c3 ^ k1;
+      c1 = (uint32_t)p1;
+      c3 = (uint32_t)p0;
+      c0 = t0;
+      c2 = t2;
+      k0 += PHILOX_W0;
+      k1 += PHILOX_W1;
+    }
+    w0[l] = c0;
+    w1[l] = c1;
+    w2[l] = c2;
+    w3[l] = c3;
+  }
+  for (l = 0; l < PHILOX_LANES; l++) {
+    u[2 * l] = philox_to_double(w0[l], w1[l]);
+    u[2 * l + 1] = philox_to_double(w2[l], w3[l]);
+  }
+}
+
+/* fills u[0..n-1] with deviates starting at an even position, i.e., at a block boundary */
+static void philox_fill_blocks(double *u, int64_t n, uint64_t block, uint64_t stream, const uint32_t key[2]) {
+  int64_t i;
+  uint32_t out[4];
+
+  for (i = 0; i + 2 * PHILOX_LANES <= n; i += 2 * PHILOX_LANES)
+    philox_lanes(u + i, block + (uint64_t)(i / 2), stream, key);
+  for (; i + 1 < n; i += 2) {
+    philox4x32_10(out, block + (uint64_t)(i / 2), stream, key);
+    u[i] = philox_to_double(out[0], out[1]);
+    u[i + 1] = philox_to_double(out[2], out[3]);
+  }
+  if (i < n) {
+    philox4x32_10(out, block + (uint64_t)(i / 2), stream, key);
+    u[i] = philox_to_double(out[0], out[1]);
+  }
+}
+
+/**
+ * @brief Initializes a counter-based (Philox4x32-10) random number generator.
+ *
+ * Unlike random_1() through random_6(), the generator keeps all of its state in @p rng, so each thread
+ * can use its own generator without locking.  Generators with the same seed and different stream
+ * numbers (e.g., the thread number or MPI rank) produce independent sequences of 2^65 deviates each.
+ *
+ * @param[out] rng    Generator to initialize.
+ * @param[in]  seed   Seed (key) shared by all streams of a calculation.
+ * @param[in]  stream Stream number.
+ */
+void philox_init(PHILOX_RNG *rng, uint64_t seed, uint64_t stream) {
+  rng->key[0] = (uint32_t)seed;
+  rng->key[1] = (uint32_t)(seed >> 32);
+  rng->stream = stream;
+  rng->position = 0;
+}
+
+/**
+ * @brief Advances a Philox generator by a number of uniform deviates in constant time.
+ *
+ * @param[in,out] rng Generator.
+ * @param[in]     n   Number of uniform deviates to skip.
+ */
+void philox_skip(PHILOX_RNG *rng, uint64_t n) {
+  rng->position += n;
+}
+
+/**
+ * @brief Returns the next uniform deviate, in (0,1), from a Philox generator.
+ *
+ * @param[in,out] rng Generator.
+ * @return A random double in (0,1).
+ */
+double philox_uniform(PHILOX_RNG *rng) {
+  uint32_t out[4];
+  uint64_t position;
+
+  position = rng->position++;
+  philox4x32_10(out, position >> 1, rng->stream, rng->key);
+  return (position & 1) ? philox_to_double(out[2], out[3]) : philox_to_double(out[0], out[1]);
+}
+
+/**
+ * @brief Returns a Gaussian deviate with mean 0 and sigma 1 from a Philox generator.
+ *
+ * Uses two uniform deviates (Box-Muller transform) per call.
+ *
+ * @param[in,out] rng Generator.
+ * @return A Gaussian random deviate.
+ */
+double philox_gauss(PHILOX_RNG *rng) {
+  double u1, u2;
+
+  u1 = philox_uniform(rng);
+  u2 = philox_uniform(rng);
+  return sqrt(-2 * log(u1)) * sin(PIx2 * u2);
+}
+
+/**
+ * @brief Fills an array with uniform deviates in (0,1) from a Philox generator.
+ *
+ * The values are the same as n successive calls to philox_uniform(), but the blocks are independent
+ * so the loop runs without a dependency chain.
+ *
+ * @param[in,out] rng Generator.
+ * @param[out]    x   Array to fill.
+ * @param[in]     n   Number of values.
+ */
+void philox_fill_uniform(PHILOX_RNG *rng, double *x, int64_t n) {
+  if (n <= 0)
+    return;
+  if (rng->position & 1) {
+    *x++ = philox_uniform(rng);
+    n--;
+  }
+  philox_fill_blocks(x, n, rng->position >> 1, rng->stream, rng->key);
+  rng->position += n;
+}
+
+/**
+ * @brief Fills an array with Gaussian deviates (mean 0, sigma 1) from a Philox generator.
+ *
+ * Each pair of uniform deviates gives two Gaussian values (the cosine and sine branches of the
+ * Box-Muller transform), so n values consume n uniform deviates, rounded up to an even number.  The
+ * sequence therefore differs from repeated calls to philox_gauss().
+ *
+ * @param[in,out] rng Generator.
+ * @param[out]    x   Array to fill.
+ * @param[in]     n   Number of values.
+ */
+void philox_fill_gauss(PHILOX_RNG *rng, double *x, int64_t n) {
+  double u[PHILOX_CHUNK], r, theta;
+  int64_t i, j, m;
+
+  for (i = 0; i < n; i += m) {
+    m = n - i < PHILOX_CHUNK ? n - i : PHILOX_CHUNK;
+    philox_fill_uniform(rng, u, (m + 1) & ~(int64_t)1);
+    for (j = 0; j + 1 < m; j += 2) {
+      r = sqrt(-2 * log(u[j]));
+      theta = PIx2 * u[j + 1];
+      x[i + j] = r * cos(theta);
+      x[i + j + 1] = r * sin(theta);
+    }
+    if (j < m)
+      x[i + j] = sqrt(-2 * log(u[j])) * cos(PIx2 * u[j + 1]);
+  }
+}
@@ -121,6 +121,234 @@ double nextHaltonSequencePoint(long ID) {
   return value;
 }
 
+/* Low digits of each dimension are looked up in a table of at least this many entries, so the
+   remaining digits need be converted only once per table length of consecutive points. */
+#define HALTON_TABLE_MIN 256
+/* scrambled values are kept below 1 */
+#define HALTON_BELOW_ONE 0.99999999999999988898
+
+/**
+ * @brief Create a multi-dimensional Halton sequence with its own state.
+ *
+ * Point n of the sequence has component d equal to the radical inverse of n in base radix[d].  Unlike
+ * startHaltonSequence(), each point is computed directly from its index, so the state is only the
+ * index of the next point: sequences may be used from several threads at once, and
+ * halton_sequence_points() gives the same values for any index range regardless of where it
+ * starts.  The sequence is positioned at index 1, the first point that nextHaltonSequencePoint()
+ * returns when started from 0.  The components are exact radical inverses, whereas the incremental
+ * update in nextHaltonSequencePoint() accumulates rounding error and can misplace a carry (e.g., it
+ * returns 1-2^-52 rather than 1/9 for the third point in base 3), so the two agree only in base 2.
+ *
+ * With scrambling, every digit position of every dimension has its own random permutation of the
+ * digits (random digit scrambling), drawn from a Philox generator with the given seed.  This
+ * removes the correlation between dimensions with large, neighboring radices while preserving the
+ * stratification of the sequence.
+ *
+ * @param dimensions Number of dimensions.
+ * @param radix Array of prime radices, one per dimension, or NULL to use the same radices that
+ *              startHaltonSequence() chooses (2, 3, 5, 7, 11, 19, ...).
+ * @param scramble If nonzero, scramble the digits.
+ * @param seed Seed for the scrambling permutations.
+ * @return Pointer to the new sequence, or NULL on error.  Free with halton_sequence_free().
+ */
+HALTON_SEQUENCE *halton_sequence_create(long dimensions, const int32_t *radix, long scramble, uint64_t seed) {
+  HALTON_SEQUENCE *seq;
+  PHILOX_RNG rng;
+  int64_t b, i, j, k, r, length, swap;
+  long digits;
+  uint64_t maximum;
+  double *weight;
+  int32_t *perm, *p;
+
+  if (dimensions <= 0 || !(seq = calloc(1, sizeof(*seq))))
+    return NULL;
+  seq->dimensions = dimensions;
+  seq->index = 1;
+  if (!(seq->radix = malloc(sizeof(*seq->radix) * dimensions)) ||
+      !(seq->digits = malloc(sizeof(*seq->digits) * dimensions)) ||
+      !(seq->tableDigits = malloc(sizeof(*seq->tableDigits) * dimensions)) ||
+      !(seq->table = calloc(dimensions, sizeof(*seq->table))) ||
+      !(seq->permutation = calloc(dimensions, sizeof(*seq->permutation)))) {
+    halton_sequence_free(seq);
+    return NULL;
+  }
+
+  for (i = 0; i < dimensions; i++) {
+    if (radix) {
+      if (radix[i] < 2 || is_prime(radix[i]) != 1) {
+        halton_sequence_free(seq);
+        return NULL;
+      }
+      seq->radix[i] = radix[i];
+    } else {
+      /* same choice as successive calls to startHaltonSequence() with radix 0 */
+      b = i < N_SEQ_PREDEFINED ? Rvalues[i] : 2;
+      for (j = 0; j < i; j++)
+        if (seq->radix[j] == b) {
+          do
+            b++;
+          while (is_prime(b) != 1);
+          j = -1;
+        }
+      seq->radix[i] = b;
+    }
+  }
+
+  for (i = 0; i < dimensions; i++) {
+    b = seq->radix[i];
+    /* number of base-b digits in the largest index */
+    for (digits = 1, maximum = UINT64_MAX; maximum >= (uint64_t)b; maximum /= b)
+      digits++;
+    seq->digits[i] = digits;
+    for (k = 1, length = b; length < HALTON_TABLE_MIN; k++)
+      length *= b;
+    seq->tableDigits[i] = k;
+
+    if (scramble) {
+      /* a random permutation of 0..b-1 for each digit position */
+      if (!(perm = seq->permutation[i] = malloc(sizeof(*perm) * digits * b))) {
+        halton_sequence_free(seq);
+        return NULL;
+      }
+      philox_init(&rng, seed, i);
+      for (j = 0; j < digits; j++) {
+        p = perm + j * b;
+        for (k = 0; k < b; k++)
+          p[k] = k;
+        for (k = b - 1; k > 0; k--) {
+          r = (int64_t)(philox_uniform(&rng) * (k + 1));
+          swap = p[k];
+          p[k] = p[r];
+          p[r] = swap;
+        }
+      }
+    }
+
+    /* radical inverse of the low tableDigits digits of each residue */
+    if (!(seq->table[i] = malloc(sizeof(**seq->table) * length)) ||
+        !(weight = malloc(sizeof(*weight) * seq->tableDigits[i]))) {
+      halton_sequence_free(seq);
+      return NULL;
+    }
+    weight[0] = 1.0 / b;
+    for (k = 1; k < seq->tableDigits[i]; k++)
+      weight[k] = weight[k - 1] / b;
+    for (j = 0; j < length; j++) {
+      double value = 0;
+      for (k = 0, r = j; k < seq->tableDigits[i]; k++, r /= b)
+        value += (scramble ? seq->permutation[i][k * b + r % b] : r % b) * weight[k];
+      seq->table[i][j] = value;
+    }
+    free(weight);
+  }
+  return seq;
+}
+
+/**
+ * @brief Free a sequence created by halton_sequence_create().
+ *
+ * @param seq Sequence to free (may be NULL).
+ */
+void halton_sequence_free(HALTON_SEQUENCE *seq) {
+  long i;
+
+  if (!seq)
+    return;
+  for (i = 0; i < seq->dimensions; i++) {
+    if (seq->table)
+      free(seq->table[i]);
+    if (seq->permutation)
+      free(seq->permutation[i]);
+  }
+  free(seq->radix);
+  free(seq->digits);
+  free(seq->tableDigits);
+  free(seq->table);
+  free(seq->permutation);
+  free(seq);
+}
+
+/**
+ * @brief Position a sequence so that the next point returned is the one with the given index.
+ *
+ * @param seq Sequence.
+ * @param index Index of the next point.
+ */
+void halton_sequence_jump(HALTON_SEQUENCE *seq, uint64_t index) {
+  seq->index = index;
+}
+
+/**
+ * @brief Compute a range of points of a sequence without changing its state.
+ *
+ * Fills x[i*dimensions + d], for i = 0..points-1, with component d of the point with index
+ * start + i.  The sequence is only read, so several threads may fill disjoint ranges of one
+ * sequence concurrently.
+ *
+ * @param seq Sequence.
+ * @param start Index of the first point.
+ * @param points Number of points.
+ * @param x Array of points*dimensions values to fill, row-major.
+ */
+void halton_sequence_points(const HALTON_SEQUENCE *seq, uint64_t start, int64_t points, double *x) {
+  long d, dimensions;
+  int64_t b, i, j, k, length, run;
+  uint64_t q, index;
+  double high, scale, tableScale, *table;
+  int32_t *perm;
+
+  dimensions = seq->dimensions;
+  for (d = 0; d < dimensions; d++) {
+    b = seq->radix[d];
+    table = seq->table[d];
+    perm = seq->permutation[d];
+    tableScale = 1;
+    for (k = 0, length = 1; k < seq->tableDigits[d]; k++) {
+      length *= b;
+      tableScale /= b;
+    }
+    for (i = 0, index = start; i < points; i += run, index += run) {
+      /* points index..index+run-1 share the digits above the table */
+      j = index % length;
+      run = length - j < points - i ? length - j : points - i;
+      scale = tableScale;
+      high = 0;
+      q = index / length;
+      if (perm) {
+        for (k = seq->tableDigits[d]; k < seq->digits[d]; k++, q /= b) {
+          scale /= b;
+          high += perm[k * b + q % b] * scale;
+        }
+      } else {
+        for (; q; q /= b) {
+          scale /= b;
+          high += (q % b) * scale;
+        }
+      }
+      for (k = 0; k < run; k++)
+        x[(i + k) * dimensions + d] = table[j + k] + high;
+      if (perm)
+        for (k = 0; k < run; k++)
+          if (x[(i + k) * dimensions + d] >= 1)
+            x[(i + k) * dimensions + d] = HALTON_BELOW_ONE;
+    }
+  }
+}
+
+/**
+ * @brief Fill an array with the next points of a sequence.
+ *
+ * @param seq Sequence.
+ * @param x Array of points*dimensions values to fill, row-major.
+ * @param points Number of points.
+ */
+void halton_sequence_fill(HALTON_SEQUENCE *seq, double *x, int64_t points) {
+  if (points <= 0)
+    return;
+  halton_sequence_points(seq, seq->index, points, x);
+  seq->index += points;
+}
+
 /*following code is from outside for improved halton sequence
    Alogrithm 659, Collected Algorithm from ACM
    This is the C version of halton sequences 
@@ -139,29 +139,13 @@ double LagrangeInterp(double *x, double *f, long order1, double x0, long *return
   return sum;
 }
 
-/**
- * @brief Performs interpolation with range control options.
- *
- * This function interpolates the value at a given point with additional control
- * over out-of-range conditions, such as skipping, aborting, warning, wrapping,
- * saturating, or using a specified value.
- *
- * @param f Pointer to the array of function values.
- * @param x Pointer to the array of independent variable values.
- * @param n Number of data points.
- * @param xo The point at which to interpolate.
- * @param belowRange Pointer to structure controlling behavior below the data range.
- * @param aboveRange Pointer to structure controlling behavior above the data range.
- * @param order The order of interpolation.
- * @param returnCode Pointer to a variable to store the return code status.
- * @param M Multiplier to adjust the interpolation condition based on the order.
- * @return The interpolated value at point xo.
- */
-double interpolate(double *f, double *x, int64_t n, double xo, OUTRANGE_CONTROL *belowRange,
-                   OUTRANGE_CONTROL *aboveRange, long order, unsigned long *returnCode, long M) {
-  long code;
-  int64_t hi, lo, mid, offset;
-  double result, below, above;
+/* Applies the out-of-range controls of interpolate() to xo.  Returns 1 with the result in *value
+   if no interpolation is needed, or 0 if xo (possibly wrapped into range) is to be interpolated. */
+static long interpolate_outrange(double *value, double *f, double *x, int64_t n, double *xo,
+                                 OUTRANGE_CONTROL *belowRange, OUTRANGE_CONTROL *aboveRange,
+                                 unsigned long *returnCode, long M) {
+  int64_t hi, lo;
+  double below, above;
 
   *returnCode = 0;
 
@@ -174,64 +158,123 @@ double interpolate(double *f, double *x, int64_t n, double xo, OUTRANGE_CONTROL
     above = f[0];
     below = f[n - 1];
   }
-  if ((xo * M > x[hi] * M && M > 0) || (xo * M < x[lo] * M && M < 0)) {
+  if ((*xo * M > x[hi] * M && M > 0) || (*xo * M < x[lo] * M && M < 0)) {
     if (aboveRange->flags & OUTRANGE_SKIP) {
       *returnCode = OUTRANGE_SKIP;
-      return above;
+      *value = above;
+      return 1;
     } else if (aboveRange->flags & OUTRANGE_ABORT) {
       *returnCode = OUTRANGE_ABORT;
-      return above;
+      *value = above;
+      return 1;
     } else if (aboveRange->flags & OUTRANGE_WARN)
       *returnCode = OUTRANGE_WARN;
     if (aboveRange->flags & OUTRANGE_VALUE) {
       *returnCode |= OUTRANGE_VALUE;
-      return aboveRange->value;
+      *value = aboveRange->value;
+      return 1;
     }
     if (aboveRange->flags & OUTRANGE_WRAP) {
       double delta;
       *returnCode |= OUTRANGE_WRAP;
-      if ((delta = x[hi] - x[lo]) == 0)
-        return f[0];
-      while (xo * M > x[hi] * M)
-        xo -= delta;
+      if ((delta = x[hi] - x[lo]) == 0) {
+        *value = f[0];
+        return 1;
+      }
+      while (*xo * M > x[hi] * M)
+        *xo -= delta;
     } else if (aboveRange->flags & OUTRANGE_SATURATE || !(aboveRange->flags & OUTRANGE_EXTRAPOLATE)) {
       *returnCode |= OUTRANGE_SATURATE;
-      return above;
+      *value = above;
+      return 1;
     }
   }
-  if ((xo * M < x[lo] * M && M > 0) || (xo * M > x[hi] * M && M < 0)) {
+  if ((*xo * M < x[lo] * M && M > 0) || (*xo * M > x[hi] * M && M < 0)) {
     if (belowRange->flags & OUTRANGE_SKIP) {
       *returnCode = OUTRANGE_SKIP;
-      return below;
+      *value = below;
+      return 1;
     } else if (belowRange->flags & OUTRANGE_ABORT) {
       *returnCode = OUTRANGE_ABORT;
-      return below;
+      *value = below;
+      return 1;
     } else if (belowRange->flags & OUTRANGE_WARN)
       *returnCode = OUTRANGE_WARN;
     if (belowRange->flags & OUTRANGE_VALUE) {
       *returnCode |= OUTRANGE_VALUE;
-      return belowRange->value;
+      *value = belowRange->value;
+      return 1;
     }
     if (belowRange->flags & OUTRANGE_WRAP) {
       double delta;
       *returnCode |= OUTRANGE_WRAP;
-      if ((delta = x[hi] - x[lo]) == 0)
-        return below;
-      while (xo * M < x[lo] * M)
-        xo += delta;
+      if ((delta = x[hi] - x[lo]) == 0) {
+        *value = below;
+        return 1;
+      }
+      while (*xo * M < x[lo] * M)
+        *xo += delta;
     } else if (belowRange->flags & OUTRANGE_SATURATE || !(belowRange->flags & OUTRANGE_EXTRAPOLATE)) {
       *returnCode |= OUTRANGE_SATURATE;
-      return below;
+      *value = below;
+      return 1;
     }
   }
 
   if (lo == hi) {
-    if (xo == x[lo]) {
+    if (*xo == x[lo]) {
       if (aboveRange->flags & OUTRANGE_WARN || belowRange->flags & OUTRANGE_WARN)
         *returnCode = OUTRANGE_WARN;
     }
-    return f[0];
+    *value = f[0];
+    return 1;
   }
+  return 0;
+}
+
+/* Evaluates the interpolating polynomial of the given order around the interval starting at lo. */
+static double interpolate_evaluate(double *f, double *x, int64_t n, double xo, int64_t lo, long order) {
+  long code;
+  int64_t offset;
+  double result;
+
+  /* L.Emery's contribution */
+  if (order > n - 1)
+    order = n - 1;
+  offset = lo - (order - 1) / 2; /* offset centers the argument in the set of points. */
+  offset = MAX(offset, 0);
+  offset = MIN(offset, n - order - 1);
+  result = LagrangeInterp(x + offset, f + offset, order + 1, xo, &code);
+  if (!code)
+    bomb("zero denominator in LagrangeInterp", NULL);
+  return result;
+}
+
+/**
+ * @brief Performs interpolation with range control options.
+ *
+ * This function interpolates the value at a given point with additional control
+ * over out-of-range conditions, such as skipping, aborting, warning, wrapping,
+ * saturating, or using a specified value.
+ *
+ * @param f Pointer to the array of function values.
+ * @param x Pointer to the array of independent variable values.
+ * @param n Number of data points.
+ * @param xo The point at which to interpolate.
+ * @param belowRange Pointer to structure controlling behavior below the data range.
+ * @param aboveRange Pointer to structure controlling behavior above the data range.
+ * @param order The order of interpolation.
+ * @param returnCode Pointer to a variable to store the return code status.
+ * @param M Multiplier to adjust the interpolation condition based on the order.
+ * @return The interpolated value at point xo.
+ */
+double interpolate(double *f, double *x, int64_t n, double xo, OUTRANGE_CONTROL *belowRange,
+                   OUTRANGE_CONTROL *aboveRange, long order, unsigned long *returnCode, long M) {
+  int64_t hi, lo, mid;
+  double result;
+
+  if (interpolate_outrange(&result, f, x, n, &xo, belowRange, aboveRange, returnCode, M))
+    return result;
 
   lo = 0;
   hi = n - 1;
@@ -249,17 +292,96 @@ double interpolate(double *f, double *x, int64_t n, double xo, OUTRANGE_CONTROL
         lo = mid;
     }
   }
+  return interpolate_evaluate(f, x, n, xo, lo, order);
+}
 
-  /* L.Emery's contribution */
-  if (order > n - 1)
-    order = n - 1;
-  offset = lo - (order - 1) / 2; /* offset centers the argument in the set of points. */
-  offset = MAX(offset, 0);
-  offset = MIN(offset, n - order - 1);
-  result = LagrangeInterp(x + offset, f + offset, order + 1, xo, &code);
-  if (!code)
-    bomb("zero denominator in LagrangeInterp", NULL);
-  return result;
+/**
+ * @brief Interpolates a table at many points.
+ *
+ * Gives the same values and return codes as calling interpolate() for each point, but starts the
+ * search for each point's bracketing interval from that of the previous point.  A point in the same
+ * or the next interval, as when resampling sorted data onto a finer grid, is found with one or two
+ * comparisons; other points are found by bisection.  Linear interpolation (order 1) is evaluated
+ * inline.
+ *
+ * @param result Array of nOut interpolated values.
+ * @param returnCode Array of nOut return codes, as from interpolate(), or NULL.
+ * @param xo Array of nOut points at which to interpolate.
+ * @param nOut Number of points.
+ * @param f Pointer to the array of function values.
+ * @param x Pointer to the array of independent variable values.
+ * @param n Number of data points.
+ * @param belowRange Pointer to structure controlling behavior below the data range.
+ * @param aboveRange Pointer to structure controlling behavior above the data range.
+ * @param order The order of interpolation.
+ * @param M Multiplier to adjust the interpolation condition based on the order.
+ * @param bracket If not NULL, holds the index of the bracketing interval to start from, and on
+ *                return that of the last point, so that successive calls on the same table
+ *                continue the scan.  Initialize to 0.
+ * @return The bitwise OR of the return codes of all points.
+ */
+unsigned long interpolate_array(double *result, unsigned long *returnCode, double *xo, int64_t nOut,
+                                double *f, double *x, int64_t n, OUTRANGE_CONTROL *belowRange,
+                                OUTRANGE_CONTROL *aboveRange, long order, long M, int64_t *bracket) {
+  int64_t i, hi, lo, mid;
+  long done;
+  unsigned long code, allCodes;
+  double xi, numer0, numer1, denom;
+
+  allCodes = 0;
+  lo = bracket ? *bracket : 0;
+  for (i = 0; i < nOut; i++) {
+    xi = xo[i];
+    done = interpolate_outrange(result + i, f, x, n, &xi, belowRange, aboveRange, &code, M);
+    allCodes |= code;
+    if (returnCode)
+      returnCode[i] = code;
+    if (done)
+      continue;
+
+    /* find the last lo in [0, n-2] with x[lo]*M <= xi*M, or 0 if there is none, which is the
+       interval that interpolate() uses */
+    if (lo < 0 || lo > n - 2)
+      lo = lo < 0 ? 0 : n - 2;
+    if (!(xi * M < x[lo] * M) && (lo == n - 2 || xi * M < x[lo + 1] * M))
+      hi = lo + 1;
+    else if (lo < n - 2 && !(xi * M < x[lo + 1] * M) && (lo + 1 == n - 2 || xi * M < x[lo + 2] * M))
+      hi = ++lo + 1;
+    else {
+      /* search the whole table rather than the part beyond the previous interval, so that the
+         searches for unordered points do not depend on each other and can overlap */
+      lo = 0;
+      hi = n - 1;
+      if (xi * M < x[0] * M)
+        hi = 1;
+    }
+    while ((hi - lo) > 1) {
+      mid = (lo + hi) / 2;
+      if (xi * M < x[mid] * M)
+        hi = mid;
+      else
+        lo = mid;
+    }
+
+    if (order == 1) {
+      /* same operations as LagrangeInterp() on points lo and lo+1 */
+      if ((numer0 = xi - x[lo + 1]) == 0)
+        result[i] = f[lo + 1];
+      else if ((denom = x[lo] - x[lo + 1]) == 0)
+        bomb("zero denominator in LagrangeInterp", NULL);
+      else if ((numer1 = xi - x[lo]) == 0)
+        result[i] = f[lo];
+      else {
+        result[i] = 0;
+        result[i] += f[lo] * numer0 / denom;
+        result[i] += f[lo + 1] * numer1 / (x[lo + 1] - x[lo]);
+      }
+    } else
+      result[i] = interpolate_evaluate(f, x, n, xi, lo, order);
+  }
+  if (bracket)
+    *bracket = lo;
+  return allCodes;
 }
 
 /**
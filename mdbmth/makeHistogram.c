@@ -18,6 +18,168 @@
 
 #include "mdb.h"
 
+/* Samples are binned in blocks of this size: bin indices for the block are computed in a branch-free
+   loop the compiler can vectorize, then added to the histogram. */
+#define HISTOGRAM_BLOCK 256
+/* Below this many points per thread the cost of private histograms outweighs threading. */
+#define HISTOGRAM_THREAD_MIN_POINTS 65536
+
+/* Sets index[i] to the bin of data[i], or to bins if the point is outside [lo, lo+bins*binSize) or NaN.
+   The offset is divided by the bin size, as make_histogram() always has, rather than multiplied by its
+   reciprocal, which would move points that lie on bin edges into different bins. */
+static void histogram_index_block(int32_t *index, double *data, long n, double lo, double binSize, long bins) {
+  long i;
+  double d, top;
+  int32_t outside;
+
+  top = bins;
+  outside = (int32_t)bins;
+  for (i = 0; i < n; i++) {
+    d = (data[i] - lo) / binSize;
+    index[i] = ((d >= 0) & (d < top)) ? (int32_t)d : outside;
+  }
+}
+
+/* Folds the y-bin index into the x-bin index of a 2-D histogram stored as hist[ix*yBins+iy]. */
+static void histogram_index_block_2d(int32_t *index, double *y, long n, double lo, double binSize, long xBins, long yBins) {
+  long i;
+  double d, top;
+  int32_t xOutside, outside, stride;
+
+  top = yBins;
+  xOutside = (int32_t)xBins;
+  stride = (int32_t)yBins;
+  outside = (int32_t)(xBins * yBins);
+  for (i = 0; i < n; i++) {
+    d = (y[i] - lo) / binSize;
+    index[i] = ((index[i] < xOutside) & (d >= 0) & (d < top)) ? index[i] * stride + (int32_t)d : outside;
+  }
+}
+
+/* Bins points [start, end) into hist, which has bins entries; y is NULL for a 1-D histogram. */
+static int64_t histogram_accumulate(double *hist, double *x, double *y, double *weight, int64_t start, int64_t end,
+                                    long xBins, double xLo, double xBinSize, long yBins, double yLo, double yBinSize) {
+  int32_t index[HISTOGRAM_BLOCK], bins;
+  int64_t i, count;
+  long j, n;
+
+  bins = (int32_t)(xBins * yBins);
+  count = 0;
+  for (i = start; i < end; i += n) {
+    n = end - i > HISTOGRAM_BLOCK ? HISTOGRAM_BLOCK : (long)(end - i);
+    histogram_index_block(index, x + i, n, xLo, xBinSize, xBins);
+    if (y)
+      histogram_index_block_2d(index, y + i, n, yLo, yBinSize, xBins, yBins);
+    if (weight) {
+      for (j = 0; j < n; j++)
+        if (index[j] < bins) {
+          hist[index[j]] += weight[i + j];
+          count++;
+        }
+    } else {
+      for (j = 0; j < n; j++)
+        if (index[j] < bins) {
+          hist[index[j]] += 1;
+          count++;
+        }
+    }
+  }
+  return count;
+}
+
+/* Shared by make_histogram_threaded() and make_histogram_2d(); y is NULL for a 1-D histogram. */
+static int64_t histogram_fill(double *hist, double *x, double *y, double *weight, int64_t n_pts, long new_start,
+                              long xBins, double xLo, double xHi, long yBins, double yLo, double yHi, long numThreads) {
+  double xBinSize, yBinSize, *privateHist;
+  int64_t total, bins, chunk, i;
+  int part;
+
+  if (xBins <= 0 || yBins <= 0 || (double)xBins * yBins >= INT32_MAX)
+    return -1;
+  bins = (int64_t)xBins * yBins;
+  if (new_start)
+    memset(hist, 0, sizeof(*hist) * bins);
+  if (xHi <= xLo || (y && yHi <= yLo))
+    return -1;
+  if (n_pts <= 0)
+    return 0;
+  xBinSize = (xHi - xLo) / xBins;
+  yBinSize = y ? (yHi - yLo) / yBins : 1;
+  if (numThreads > n_pts / HISTOGRAM_THREAD_MIN_POINTS)
+    numThreads = (long)(n_pts / HISTOGRAM_THREAD_MIN_POINTS);
+#ifndef _OPENMP
+  numThreads = 1;
+#endif
+  if (numThreads <= 1 || !(privateHist = calloc(numThreads * bins, sizeof(*privateHist))))
+    return histogram_accumulate(hist, x, y, weight, 0, n_pts, xBins, xLo, xBinSize, yBins, yLo, yBinSize);
+
+  /* each part of the data goes to its own histogram; these are summed in order so results are reproducible */
+  total = 0;
+  chunk = (n_pts + numThreads - 1) / numThreads;
+#pragma omp parallel for schedule(static) num_threads(numThreads) reduction(+ : total)
+  for (part = 0; part < numThreads; part++)
+    total += histogram_accumulate(privateHist + part * bins, x, y, weight, part * chunk,
+                                  (part + 1) * chunk < n_pts ? (part + 1) * chunk : n_pts,
+                                  xBins, xLo, xBinSize, yBins, yLo, yBinSize);
+  for (part = 0; part < numThreads; part++)
+    for (i = 0; i < bins; i++)
+      hist[i] += privateHist[part * bins + i];
+  free(privateHist);
+  return total;
+}
+
+/**
+ * @brief Compiles a histogram from data points, optionally weighted, using several threads.
+ *
+ * Bin i covers [lo + i*(hi-lo)/n_bins, lo + (i+1)*(hi-lo)/n_bins); points outside [lo, hi) and NaN
+ * values are not binned.  Unlike make_histogram_weighted(), this routine keeps no static state and may be called
+ * from several threads at once.  When more than one thread is used, each fills a private histogram and
+ * these are summed in thread order, so results do not vary from run to run.
+ *
+ * @param hist Pointer to the histogram array to be filled.
+ * @param n_bins Number of bins in the histogram.
+ * @param lo Lower bound of the histogram range.
+ * @param hi Upper bound of the histogram range.
+ * @param data Pointer to the data array.
+ * @param weight Pointer to the weights array corresponding to each data point, or NULL to count points.
+ * @param n_pts Number of data points.
+ * @param new_start Flag indicating whether to initialize the histogram (1 to initialize, 0 to accumulate).
+ * @param numThreads Number of threads to use.
+ * @return Returns the number of points binned by this call, or -1 if the binning parameters are invalid.
+ */
+int64_t make_histogram_threaded(double *hist, long n_bins, double lo, double hi, double *data, double *weight,
+                                int64_t n_pts, long new_start, long numThreads) {
+  return histogram_fill(hist, data, NULL, weight, n_pts, new_start, n_bins, lo, hi, 1, 0, 0, numThreads);
+}
+
+/**
+ * @brief Compiles a 2-D histogram from pairs of data points, optionally weighted, using several threads.
+ *
+ * The histogram is stored with the y bins varying fastest, i.e., bin (ix, iy) is hist[ix*y_bins+iy].
+ * Binning otherwise follows make_histogram_threaded().
+ *
+ * @param hist Pointer to the histogram array (x_bins*y_bins elements) to be filled.
+ * @param x_bins Number of bins in x.
+ * @param x_lo Lower bound of the x range.
+ * @param x_hi Upper bound of the x range.
+ * @param y_bins Number of bins in y.
+ * @param y_lo Lower bound of the y range.
+ * @param y_hi Upper bound of the y range.
+ * @param x Pointer to the x data array.
+ * @param y Pointer to the y data array.
+ * @param weight Pointer to the weights array corresponding to each data point, or NULL to count points.
+ * @param n_pts Number of data points.
+ * @param new_start Flag indicating whether to initialize the histogram (1 to initialize, 0 to accumulate).
+ * @param numThreads Number of threads to use.
+ * @return Returns the number of points binned by this call, or -1 if the binning parameters are invalid.
+ */
+int64_t make_histogram_2d(double *hist, long x_bins, double x_lo, double x_hi, long y_bins, double y_lo, double y_hi,
+                          double *x, double *y, double *weight, int64_t n_pts, long new_start, long numThreads) {
+  if (!y)
+    return -1;
+  return histogram_fill(hist, x, y, weight, n_pts, new_start, x_bins, x_lo, x_hi, y_bins, y_lo, y_hi, numThreads);
+}
+
 /**
  * @brief Compiles a histogram from data points.
  *
@@ -33,29 +195,13 @@
 long make_histogram(
   double *hist, long n_bins, double lo, double hi, double *data,
   int64_t n_pts, long new_start) {
-  static long bin;
-  static int64_t i;
-  static double bin_size, dbin;
-
-  if (new_start) {
-    bin_size = (hi - lo) / n_bins;
-    for (i = 0; i < n_bins; i++)
-      hist[i] = 0;
-  }
-
-  for (i = 0; i < n_pts; i++) {
-    bin = (dbin = (data[i] - lo) / bin_size);
-    if (dbin < 0)
-      continue;
-    if (bin < 0 || bin >= n_bins)
-      continue;
-    hist[bin] += 1;
-  }
+  long i;
+  double total;
 
-  for (i = bin = 0; i < n_bins; i++)
-    bin += hist[i];
-
-  return (bin);
+  make_histogram_threaded(hist, n_bins, lo, hi, data, NULL, n_pts, new_start, 1);
+  for (i = 0, total = 0; i < n_bins; i++)
+    total += hist[i];
+  return ((long)total);
 }
 
 /**
@@ -69,31 +215,19 @@ long make_histogram(
  * @param n_pts Number of data points.
  * @param new_start Flag indicating whether to initialize the histogram (1 to initialize, 0 to accumulate).
  * @param weight Pointer to the weights array corresponding to each data point.
- * @return Returns the total number of points binned.
+ * @return Returns the total number of points binned since the histogram was started.
  */
 long make_histogram_weighted(
   double *hist, long n_bins, double lo, double hi, double *data,
   long n_pts, long new_start, double *weight) {
-  static long bin, i, count;
-  static double bin_size, dbin;
+  static long count;
+  int64_t binned;
 
-  if (new_start) {
+  if (new_start)
     count = 0;
-    bin_size = (hi - lo) / n_bins;
-    for (i = 0; i < n_bins; i++)
-      hist[i] = 0;
-  }
-
-  for (i = 0; i < n_pts; i++) {
-    bin = (dbin = (data[i] - lo) / bin_size);
-    if (dbin < 0)
-      continue;
-    if (bin < 0 || bin >= n_bins)
-      continue;
-    hist[bin] += weight[i];
-    count++;
-  }
-
+  binned = make_histogram_threaded(hist, n_bins, lo, hi, data, weight, n_pts, new_start, 1);
+  if (binned > 0)
+    count += binned;
   return (count);
 }
 
@@ -18,6 +18,177 @@
 
 #include "mdb.h"
 
+/* segments this short are finished by insertion sort */
+#define SELECT_SORT_LENGTH 16
+
+static int rank_cmpasc(const void *a, const void *b) {
+  long ra, rb;
+
+  ra = *((long *)a);
+  rb = *((long *)b);
+  return (ra < rb ? -1 : (ra > rb ? 1 : 0));
+}
+
+static void select_insertion_sort(double *x, long n) {
+  long i, j;
+  double t;
+
+  for (i = 1; i < n; i++) {
+    t = x[i];
+    for (j = i; j > 0 && x[j - 1] > t; j--)
+      x[j] = x[j - 1];
+    x[j] = t;
+  }
+}
+
+static double select_median3(double a, double b, double c) {
+  if (a < b)
+    return b < c ? b : (a < c ? c : a);
+  return a < c ? a : (b < c ? c : b);
+}
+
+/**
+ * @brief Partially orders x[0..n-1] so that x[rank[i]] is the rank[i]-th smallest value for each i.
+ *
+ * Each pass partitions the segment three ways around a median-of-three (ninther for long segments) pivot
+ * and keeps only the sides that still contain requested ranks, so a few ranks cost O(n) expected time.
+ * Segments that are still long after 2*log2(n) passes are sorted, which bounds the worst case at
+ * O(n log n).  The ranks must be sorted in increasing order.
+ */
+static void select_ranks(double *x, long n, long *rank, long ranks, long depth) {
+  long lt, gt, i, a, b, step;
+  double pivot, t;
+
+  while (ranks > 0 && n > 1) {
+    if (n <= SELECT_SORT_LENGTH) {
+      select_insertion_sort(x, n);
+      return;
+    }
+    if (depth-- <= 0) {
+      qsort((void *)x, n, sizeof(*x), double_cmpasc);
+      return;
+    }
+    if (n < 1024)
+      pivot = select_median3(x[0], x[n / 2], x[n - 1]);
+    else {
+      step = n / 8;
+      pivot = select_median3(select_median3(x[0], x[step], x[2 * step]),
+                             select_median3(x[3 * step], x[n / 2], x[5 * step]),
+                             select_median3(x[6 * step], x[7 * step], x[n - 1]));
+    }
+    /* x[0..lt-1] < pivot, x[lt..gt-1] == pivot, x[gt..n-1] > pivot */
+    lt = i = 0;
+    gt = n;
+    while (i < gt) {
+      if (x[i] < pivot) {
+        t = x[i];
+        x[i++] = x[lt];
+        x[lt++] = t;
+      } else if (x[i] > pivot) {
+        t = x[i];
+        x[i] = x[--gt];
+        x[gt] = t;
+      } else
+        i++;
+    }
+    /* ranks[0..a-1] fall below the pivot, ranks[b..] above it */
+    for (a = 0; a < ranks && rank[a] < lt; a++)
+      ;
+    for (b = a; b < ranks && rank[b] < gt; b++)
+      ;
+    for (i = b; i < ranks; i++)
+      rank[i] -= gt;
+    /* recurse on the shorter side and loop on the longer one */
+    if (lt < n - gt) {
+      select_ranks(x, lt, rank, a, depth);
+      x += gt;
+      n -= gt;
+      rank += b;
+      ranks -= b;
+    } else {
+      select_ranks(x + gt, n - gt, rank + b, ranks - b, depth);
+      n = lt;
+      ranks = a;
+    }
+  }
+}
+
+/**
+ * @brief Finds several order statistics of an array of doubles without sorting it.
+ *
+ * On return value[i] is the rank[i]-th smallest element of x (rank 0 being the minimum), and
+ * x is reordered so that x[rank[i]] holds that element.  The expected time is O(n) for a few ranks,
+ * against O(n log n) for sorting.  No static storage is used, so the routine may be called from
+ * several threads at once.
+ *
+ * @param value Pointer to the array to store the order statistics.
+ * @param rank Pointer to the array of ranks, in any order, each between 0 and n-1.
+ * @param ranks Number of ranks.
+ * @param x Pointer to the array of doubles, which is reordered.
+ * @param n Number of elements in the array.
+ * @return Returns 1 on success, 0 on failure.
+ */
+long select_order_statistics(double *value, long *rank, long ranks, double *x, long n) {
+  long *sorted, i, depth;
+
+  if (n <= 0 || ranks <= 0)
+    return 0;
+  for (i = 0; i < ranks; i++)
+    if (rank[i] < 0 || rank[i] >= n)
+      return 0;
+  if (!(sorted = malloc(sizeof(*sorted) * ranks)))
+    return 0;
+  memcpy(sorted, rank, sizeof(*sorted) * ranks);
+  qsort((void *)sorted, ranks, sizeof(*sorted), rank_cmpasc);
+  for (i = depth = 0; (1L << i) < n && i < 62; i++)
+    depth += 2;
+  select_ranks(x, n, sorted, ranks, depth);
+  free(sorted);
+  for (i = 0; i < ranks; i++)
+    value[i] = x[rank[i]];
+  return 1;
+}
+
+/**
+ * @brief Computes multiple percentiles of an array of doubles using caller-provided work space.
+ *
+ * Gives the same results as compute_percentiles(), using select_order_statistics() instead of a sort.
+ *
+ * @param position Pointer to the array to store the computed percentile values.
+ * @param percent Pointer to the array of percentiles to compute (each value between 0-100).
+ * @param positions Number of percentiles to compute.
+ * @param x Pointer to the array of doubles.
+ * @param n Number of elements in the array.
+ * @param buffer Work space for n doubles.  If NULL, work space is allocated for the call.  If equal to @p x,
+ *               the data is reordered in place and not copied.
+ * @return Returns 1 on success, 0 on failure.
+ */
+long compute_percentiles_buffered(double *position, double *percent, long positions, double *x, long n, double *buffer) {
+  long ip, *rank, result;
+  double *data;
+
+  if (n <= 0 || positions <= 0)
+    return 0;
+  for (ip = 0; ip < positions; ip++)
+    if (percent[ip] < 0 || percent[ip] > 100)
+      return 0;
+  if (!(rank = malloc(sizeof(*rank) * positions)))
+    return 0;
+  if (!(data = buffer) && !(data = malloc(sizeof(*data) * n))) {
+    free(rank);
+    return 0;
+  }
+  if (data != x)
+    memcpy((char *)data, (char *)x, sizeof(*x) * n);
+  for (ip = 0; ip < positions; ip++)
+    rank[ip] = (long)((n - 1) * (percent[ip] / 100.0));
+  result = select_order_statistics(position, rank, positions, data, n);
+  if (!buffer)
+    free(data);
+  free(rank);
+  return result;
+}
+
 /**
  * @brief Computes the median of an array of doubles.
  *
@@ -27,21 +198,18 @@
  * @return Returns 1 on success, 0 on failure.
  */
 long compute_median(double *value, double *x, long n) {
-  static double *data = NULL;
-  static long last_n = 0;
-  long i;
+  double *data;
+  long rank, result;
 
   if (n <= 0)
     return 0;
-  if (n > last_n) {
-    data = trealloc(data, sizeof(*data) * n);
-    last_n = n;
-  }
-  for (i = 0; i < n; i++)
-    data[i] = x[i];
-  qsort((void *)data, n, sizeof(*data), double_cmpasc);
-  *value = data[n / 2];
-  return 1;
+  if (!(data = malloc(sizeof(*data) * n)))
+    return 0;
+  memcpy((char *)data, (char *)x, sizeof(*x) * n);
+  rank = n / 2;
+  result = select_order_statistics(value, &rank, 1, data, n);
+  free(data);
+  return result;
 }
 
 /**
@@ -54,21 +222,9 @@ long compute_median(double *value, double *x, long n) {
  * @return Returns 1 on success, 0 on failure.
  */
 long compute_percentile(double *value, double *x, long n, double percentile) {
-  static double *data = NULL;
-  static long last_n = 0;
-  long i;
-
   if (n <= 0 || percentile < 0 || percentile > 100)
     return 0;
-  if (n > last_n) {
-    data = trealloc(data, sizeof(*data) * n);
-    last_n = n;
-  }
-  for (i = 0; i < n; i++)
-    data[i] = x[i];
-  qsort((void *)data, n, sizeof(*data), double_cmpasc);
-  *value = data[(long)((n - 1) * (percentile / 100.0))];
-  return 1;
+  return compute_percentiles_buffered(value, &percentile, 1, x, n, NULL);
 }
 
 /**
@@ -82,21 +238,7 @@ long compute_percentile(double *value, double *x, long n, double percentile) {
  * @return Returns 1 on success, 0 on failure.
  */
 long compute_percentiles(double *position, double *percent, long positions, double *x, long n) {
-  static double *data = NULL;
-  static long last_n = 0;
-  long ip;
-
-  if (n <= 0 || positions <= 0)
-    return 0;
-  if (n > last_n) {
-    data = trealloc(data, sizeof(*data) * n);
-    last_n = n;
-  }
-  memcpy((char *)data, (char *)x, sizeof(*x) * n);
-  qsort((void *)data, n, sizeof(*data), double_cmpasc);
-  for (ip = 0; ip < positions; ip++)
-    position[ip] = data[(long)((n - 1) * (percent[ip] / 100.0))];
-  return 1;
+  return compute_percentiles_buffered(position, percent, positions, x, n, NULL);
 }
 
 /**
@@ -111,26 +253,23 @@ long compute_percentiles(double *position, double *percent, long positions, doub
  * @return Returns 1 on success, 0 on failure.
  */
 long compute_percentiles_flagged(double *position, double *percent, long positions, double *x, int32_t *keep, int64_t n) {
-  static double *data = NULL;
-  static int64_t last_n = 0;
+  double *data;
   int64_t ip, jp, count;
+  long result;
 
   if (n <= 0 || positions <= 0)
     return 0;
   for (ip=count=0; ip<n; ip++) 
     if (keep[ip])
       count++;
-  if (count > last_n) {
-    data = trealloc(data, sizeof(*data) * count);
-    last_n = count;
-  }
+  if (count == 0 || !(data = malloc(sizeof(*data) * count)))
+    return 0;
   for (ip=jp=0; ip<n; ip++)
     if (keep[ip])
       data[jp++] = x[ip];
-  qsort((void *)data, count, sizeof(*data), double_cmpasc);
-  for (ip = 0; ip < positions; ip++)
-    position[ip] = data[(long)((count - 1) * (percent[ip] / 100.0))];
-  return 1;
+  result = compute_percentiles_buffered(position, percent, positions, data, count, data);
+  free(data);
+  return result;
 }
 
 /**
@@ -217,3 +356,407 @@ long approximate_percentiles(double *position, double *percent, long positions,
   free(hist);
   return 1;
 }
+
+/* Smallest capacity given to any level of a quantile sketch, and the ratio between the capacities of
+   successive levels (the top level has capacity k). */
+#define QSKETCH_MIN_CAPACITY 8
+#define QSKETCH_CAPACITY_RATIO (2.0 / 3.0)
+#define QSKETCH_MAGIC "QSK1"
+
+typedef struct {
+  double value;
+  int64_t weight;
+} QSKETCH_ITEM;
+
+static int qsketch_item_cmpasc(const void *a, const void *b) {
+  double va, vb;
+
+  va = ((QSKETCH_ITEM *)a)->value;
+  vb = ((QSKETCH_ITEM *)b)->value;
+  return (va < vb ? -1 : (va > vb ? 1 : 0));
+}
+
+/* The capacities depend on the number of levels, so they are set whenever a level is added. */
+static void qsketch_set_capacities(QUANTILE_SKETCH *sketch) {
+  long level, capacity;
+
+  sketch->totalCapacity = 0;
+  for (level = 0; level < sketch->levels; level++) {
+    capacity = (long)ceil(sketch->k * pow(QSKETCH_CAPACITY_RATIO, sketch->levels - 1 - level));
+    sketch->capacity[level] = capacity < QSKETCH_MIN_CAPACITY ? QSKETCH_MIN_CAPACITY : capacity;
+    sketch->totalCapacity += sketch->capacity[level];
+  }
+}
+
+static int qsketch_reserve(QUANTILE_SKETCH *sketch, long level, long size) {
+  double *item;
+
+  if (size <= sketch->space[level])
+    return 1;
+  if (size < 2 * sketch->space[level])
+    size = 2 * sketch->space[level];
+  if (!(item = realloc(sketch->item[level], sizeof(*item) * size)))
+    return 0;
+  sketch->item[level] = item;
+  sketch->space[level] = size;
+  return 1;
+}
+
+static int qsketch_add_level(QUANTILE_SKETCH *sketch) {
+  long levels;
+  long *size, *space, *capacity;
+  double **item;
+
+  levels = sketch->levels + 1;
+  if (levels > 62)
+    return 0;
+  if (!(size = realloc(sketch->size, sizeof(*size) * levels)))
+    return 0;
+  sketch->size = size;
+  if (!(space = realloc(sketch->space, sizeof(*space) * levels)))
+    return 0;
+  sketch->space = space;
+  if (!(capacity = realloc(sketch->capacity, sizeof(*capacity) * levels)))
+    return 0;
+  sketch->capacity = capacity;
+  if (!(item = realloc(sketch->item, sizeof(*item) * levels)))
+    return 0;
+  sketch->item = item;
+  sketch->size[levels - 1] = sketch->space[levels - 1] = 0;
+  sketch->item[levels - 1] = NULL;
+  sketch->levels = levels;
+  qsketch_set_capacities(sketch);
+  return 1;
+}
+
+/* xorshift64*; each sketch has its own generator so that sketches can be filled concurrently */
+static int qsketch_random_bit(QUANTILE_SKETCH *sketch) {
+  sketch->random ^= sketch->random >> 12;
+  sketch->random ^= sketch->random << 25;
+  sketch->random ^= sketch->random >> 27;
+  return (int)(((sketch->random * UINT64_C(2685821657736338717)) >> 63) & 1);
+}
+
+/* Halves the lowest over-full level, promoting every other item (starting at a random one) to the next
+   level, until the sketch is within its total capacity. */
+static int qsketch_compress(QUANTILE_SKETCH *sketch) {
+  long level, total, i, pairs, offset;
+  double *item;
+
+  while (1) {
+    for (level = total = 0; level < sketch->levels; level++)
+      total += sketch->size[level];
+    if (total < sketch->totalCapacity)
+      return 1;
+    for (level = 0; level < sketch->levels; level++)
+      if (sketch->size[level] >= sketch->capacity[level])
+        break;
+    if (level == sketch->levels)
+      return 1;
+    if (level == sketch->levels - 1 && !qsketch_add_level(sketch))
+      return 0;
+    item = sketch->item[level];
+    pairs = sketch->size[level] / 2;
+    qsort((void *)item, sketch->size[level], sizeof(*item), double_cmpasc);
+    if (!qsketch_reserve(sketch, level + 1, sketch->size[level + 1] + pairs))
+      return 0;
+    offset = qsketch_random_bit(sketch);
+    for (i = 0; i < pairs; i++)
+      sketch->item[level + 1][sketch->size[level + 1]++] = item[2 * i + offset];
+    /* an odd item out stays behind */
+    if (sketch->size[level] % 2) {
+      item[0] = item[sketch->size[level] - 1];
+      sketch->size[level] = 1;
+    } else
+      sketch->size[level] = 0;
+  }
+}
+
+/**
+ * @brief Creates an empty streaming quantile sketch.
+ *
+ * The sketch is a KLL sketch (Karnin, Lang and Liberty, 2016): a stack of buffers in which an item at
+ * level h stands for 2^h input values, and full buffers are halved by keeping every other sorted item.
+ * It holds about 3k values however many are added.  A percentile returned by
+ * quantile_sketch_percentiles() has, with 99% confidence, a rank within about 2.4/k^0.94 of the
+ * requested one as a fraction of the count: 1.3% for k=200 and 0.3% for k=1000.  The minimum and
+ * maximum (percentiles 0 and 100) are exact.
+ *
+ * Which half of a buffer is kept is chosen at random.  The bound holds for each sketch whatever its
+ * seed, but sketches that are to be merged should be given different seeds so that their errors are
+ * independent; the same seed and input give the same sketch.
+ *
+ * @param k Accuracy parameter; values below 8 are raised to 8.
+ * @param seed Seed for the sketch's random choices.
+ * @return Pointer to the sketch, or NULL if memory could not be allocated.
+ */
+QUANTILE_SKETCH *quantile_sketch_create(long k, uint64_t seed) {
+  QUANTILE_SKETCH *sketch;
+
+  if (!(sketch = calloc(1, sizeof(*sketch))))
+    return NULL;
+  sketch->k = k < QSKETCH_MIN_CAPACITY ? QSKETCH_MIN_CAPACITY : k;
+  sketch->min = DBL_MAX;
+  sketch->max = -DBL_MAX;
+  /* splitmix64, so that nearby seeds give unrelated, nonzero xorshift states */
+  seed += UINT64_C(0x9E3779B97F4A7C15);
+  seed = (seed ^ (seed >> 30)) * UINT64_C(0xBF58476D1CE4E5B9);
+  seed = (seed ^ (seed >> 27)) * UINT64_C(0x94D049BB133111EB);
+  seed ^= seed >> 31;
+  sketch->random = seed ? seed : UINT64_C(0x9E3779B97F4A7C15);
+  if (!qsketch_add_level(sketch)) {
+    quantile_sketch_free(sketch);
+    return NULL;
+  }
+  return sketch;
+}
+
+/**
+ * @brief Frees a quantile sketch.
+ *
+ * @param sketch Pointer to the sketch, which may be NULL.
+ */
+void quantile_sketch_free(QUANTILE_SKETCH *sketch) {
+  long level;
+
+  if (!sketch)
+    return;
+  for (level = 0; level < sketch->levels; level++)
+    free(sketch->item[level]);
+  free(sketch->item);
+  free(sketch->size);
+  free(sketch->space);
+  free(sketch->capacity);
+  free(sketch);
+}
+
+/**
+ * @brief Adds values to a quantile sketch.  NaN values are ignored.
+ *
+ * @param sketch Pointer to the sketch.
+ * @param x Pointer to the array of doubles.
+ * @param n Number of elements in the array.
+ * @return Returns 1 on success, 0 on failure.
+ */
+long quantile_sketch_add(QUANTILE_SKETCH *sketch, double *x, long n) {
+  long i;
+
+  if (!sketch || n < 0)
+    return 0;
+  for (i = 0; i < n; i++) {
+    if (isnan(x[i]))
+      continue;
+    if (!qsketch_reserve(sketch, 0, sketch->size[0] + 1))
+      return 0;
+    sketch->item[0][sketch->size[0]++] = x[i];
+    sketch->count++;
+    if (x[i] < sketch->min)
+      sketch->min = x[i];
+    if (x[i] > sketch->max)
+      sketch->max = x[i];
+    if (sketch->size[0] >= sketch->capacity[0] && !qsketch_compress(sketch))
+      return 0;
+  }
+  return 1;
+}
+
+/**
+ * @brief Merges one quantile sketch into another.
+ *
+ * The result summarizes the values added to either sketch, with the error bound of the smaller k.
+ * Sketches built separately (e.g., one per file or per thread) can thus be combined.
+ *
+ * @param target Pointer to the sketch that receives the values.
+ * @param source Pointer to the sketch to merge, which is left unchanged.
+ * @return Returns 1 on success, 0 on failure.
+ */
+long quantile_sketch_merge(QUANTILE_SKETCH *target, QUANTILE_SKETCH *source) {
+  long level;
+
+  if (!target || !source || target == source)
+    return 0;
+  while (target->levels < source->levels)
+    if (!qsketch_add_level(target))
+      return 0;
+  for (level = 0; level < source->levels; level++) {
+    if (!qsketch_reserve(target, level, target->size[level] + source->size[level]))
+      return 0;
+    memcpy(target->item[level] + target->size[level], source->item[level], sizeof(double) * source->size[level]);
+    target->size[level] += source->size[level];
+  }
+  if (source->k < target->k)
+    target->k = source->k;
+  target->count += source->count;
+  if (source->min < target->min)
+    target->min = source->min;
+  if (source->max > target->max)
+    target->max = source->max;
+  return qsketch_compress(target);
+}
+
+/**
+ * @brief Estimates percentiles of the values added to a quantile sketch.
+ *
+ * Uses the same rank convention as compute_percentiles(), so that for a sketch that has not yet
+ * compressed anything the results are exact.
+ *
+ * @param position Pointer to the array to store the percentile values.
+ * @param percent Pointer to the array of percentiles to compute (each value between 0-100).
+ * @param positions Number of percentiles to compute.
+ * @param sketch Pointer to the sketch.
+ * @return Returns 1 on success, 0 on failure (including an empty sketch).
+ */
+long quantile_sketch_percentiles(double *position, double *percent, long positions, QUANTILE_SKETCH *sketch) {
+  QSKETCH_ITEM *item;
+  long level, i, items, ip;
+  int64_t rank, cumulative;
+
+  if (!sketch || sketch->count <= 0 || positions <= 0)
+    return 0;
+  for (ip = 0; ip < positions; ip++)
+    if (percent[ip] < 0 || percent[ip] > 100)
+      return 0;
+  for (level = items = 0; level < sketch->levels; level++)
+    items += sketch->size[level];
+  if (!(item = malloc(sizeof(*item) * items)))
+    return 0;
+  for (level = items = 0; level < sketch->levels; level++)
+    for (i = 0; i < sketch->size[level]; i++) {
+      item[items].value = sketch->item[level][i];
+      item[items++].weight = ((int64_t)1) << level;
+    }
+  qsort((void *)item, items, sizeof(*item), qsketch_item_cmpasc);
+  for (ip = 0; ip < positions; ip++) {
+    if (percent[ip] == 0) {
+      position[ip] = sketch->min;
+      continue;
+    }
+    if (percent[ip] == 100) {
+      position[ip] = sketch->max;
+      continue;
+    }
+    rank = (int64_t)((sketch->count - 1) * (percent[ip] / 100.0));
+    for (i = 0, cumulative = 0; i < items - 1; i++)
+      if ((cumulative += item[i].weight) > rank)
+        break;
+    position[ip] = item[i].value;
+  }
+  free(item);
+  return 1;
+}
+
+static void qsketch_put(unsigned char **buffer, uint64_t value) {
+  int i;
+
+  for (i = 0; i < 8; i++)
+    *(*buffer)++ = (unsigned char)(value >> (8 * i));
+}
+
+static uint64_t qsketch_get(unsigned char **buffer) {
+  uint64_t value;
+  int i;
+
+  for (i = value = 0; i < 8; i++)
+    value |= ((uint64_t) * (*buffer)++) << (8 * i);
+  return value;
+}
+
+static void qsketch_put_double(unsigned char **buffer, double value) {
+  uint64_t bits;
+
+  memcpy(&bits, &value, sizeof(bits));
+  qsketch_put(buffer, bits);
+}
+
+static double qsketch_get_double(unsigned char **buffer) {
+  uint64_t bits;
+  double value;
+
+  bits = qsketch_get(buffer);
+  memcpy(&value, &bits, sizeof(value));
+  return value;
+}
+
+/**
+ * @brief Writes a quantile sketch to a byte buffer.
+ *
+ * The format is independent of the host byte order, so sketches may be stored (e.g., as an SDDS
+ * string or in a file) and merged later on another machine.
+ *
+ * @param sketch Pointer to the sketch.
+ * @param bytes Pointer to store the length of the buffer.
+ * @return Pointer to a buffer allocated with malloc(), or NULL on failure.
+ */
+void *quantile_sketch_serialize(QUANTILE_SKETCH *sketch, long *bytes) {
+  unsigned char *buffer, *ptr;
+  long level, i, length;
+
+  if (!sketch || !bytes)
+    return NULL;
+  length = 4 + 8 * (6 + sketch->levels);
+  for (level = 0; level < sketch->levels; level++)
+    length += 8 * sketch->size[level];
+  if (!(ptr = buffer = malloc(length)))
+    return NULL;
+  memcpy(ptr, QSKETCH_MAGIC, 4);
+  ptr += 4;
+  qsketch_put(&ptr, (uint64_t)sketch->k);
+  qsketch_put(&ptr, (uint64_t)sketch->levels);
+  qsketch_put(&ptr, (uint64_t)sketch->count);
+  qsketch_put_double(&ptr, sketch->min);
+  qsketch_put_double(&ptr, sketch->max);
+  qsketch_put(&ptr, sketch->random);
+  for (level = 0; level < sketch->levels; level++) {
+    qsketch_put(&ptr, (uint64_t)sketch->size[level]);
+    for (i = 0; i < sketch->size[level]; i++)
+      qsketch_put_double(&ptr, sketch->item[level][i]);
+  }
+  *bytes = length;
+  return buffer;
+}
+
+/**
+ * @brief Recreates a quantile sketch from a buffer written by quantile_sketch_serialize().
+ *
+ * @param buffer Pointer to the buffer.
+ * @param bytes Length of the buffer.
+ * @return Pointer to the sketch, or NULL if the buffer is not a valid sketch or memory could not be allocated.
+ */
+QUANTILE_SKETCH *quantile_sketch_deserialize(void *buffer, long bytes) {
+  QUANTILE_SKETCH *sketch;
+  unsigned char *ptr, *end;
+  uint64_t levels, size;
+  long level, i;
+
+  ptr = buffer;
+  end = ptr + bytes;
+  if (!buffer || bytes < 4 + 8 * 6 || memcmp(ptr, QSKETCH_MAGIC, 4) != 0)
+    return NULL;
+  ptr += 4;
+  if (!(sketch = quantile_sketch_create((long)qsketch_get(&ptr), 0)))
+    return NULL;
+  levels = qsketch_get(&ptr);
+  sketch->count = (int64_t)qsketch_get(&ptr);
+  sketch->min = qsketch_get_double(&ptr);
+  sketch->max = qsketch_get_double(&ptr);
+  sketch->random = qsketch_get(&ptr);
+  if (levels < 1 || levels > 62)
+    goto invalid;
+  while ((uint64_t)sketch->levels < levels)
+    if (!qsketch_add_level(sketch))
+      goto invalid;
+  for (level = 0; level < sketch->levels; level++) {
+    if (end - ptr < 8)
+      goto invalid;
+    size = qsketch_get(&ptr);
+    if (size > (uint64_t)(end - ptr) / 8 || !qsketch_reserve(sketch, level, (long)size))
+      goto invalid;
+    for (i = 0; i < (long)size; i++)
+      sketch->item[level][i] = qsketch_get_double(&ptr);
+    sketch->size[level] = (long)size;
+  }
+  return sketch;
+invalid:
+  quantile_sketch_free(sketch);
+  return NULL;
+}
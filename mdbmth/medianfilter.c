@@ -143,11 +143,133 @@ double quickSelect(double *arr, int n) {
   }
 }
 
+/* Running median of a window of odd size, kept as two heaps joined at the median (after the
+   "mediator" of A. Shelly).  heap[0] is the median, heap[1..] a min-heap of the larger values and
+   heap[-1..] a max-heap of the smaller ones; pos[] gives the heap slot of each window entry so the
+   oldest entry can be replaced in place, costing O(log W) per sample rather than O(W). */
+typedef struct {
+  double *data; /* window values, in ring order */
+  long *pos;    /* heap slot of each window entry */
+  long *heap;   /* window entry held in each heap slot, indexed from -W/2 to W/2 */
+  long N, idx, ct;
+} RUNNING_MEDIAN;
+
+#define RM_LESS(rm, i, j) ((rm)->data[(rm)->heap[i]] < (rm)->data[(rm)->heap[j]])
+#define RM_MIN_COUNT(rm) (((rm)->ct - 1) / 2)
+#define RM_MAX_COUNT(rm) ((rm)->ct / 2)
+
+static int runningMedianExchange(RUNNING_MEDIAN *rm, long i, long j) {
+  long t;
+
+  t = rm->heap[i];
+  rm->heap[i] = rm->heap[j];
+  rm->heap[j] = t;
+  rm->pos[rm->heap[i]] = i;
+  rm->pos[rm->heap[j]] = j;
+  return 1;
+}
+
+/* swaps slots i and j if the value in i is less than that in j */
+static int runningMedianCompareExchange(RUNNING_MEDIAN *rm, long i, long j) {
+  return RM_LESS(rm, i, j) && runningMedianExchange(rm, i, j);
+}
+
+static void runningMedianMinSortDown(RUNNING_MEDIAN *rm, long i) {
+  for (; i <= RM_MIN_COUNT(rm); i *= 2) {
+    if (i > 1 && i < RM_MIN_COUNT(rm) && RM_LESS(rm, i + 1, i))
+      ++i;
+    if (!runningMedianCompareExchange(rm, i, i / 2))
+      break;
+  }
+}
+
+static void runningMedianMaxSortDown(RUNNING_MEDIAN *rm, long i) {
+  for (; i >= -RM_MAX_COUNT(rm); i *= 2) {
+    if (i < -1 && i > -RM_MAX_COUNT(rm) && RM_LESS(rm, i, i - 1))
+      --i;
+    if (!runningMedianCompareExchange(rm, i / 2, i))
+      break;
+  }
+}
+
+/* both return 1 if the entry reached the median slot */
+static int runningMedianMinSortUp(RUNNING_MEDIAN *rm, long i) {
+  while (i > 0 && runningMedianCompareExchange(rm, i, i / 2))
+    i /= 2;
+  return i == 0;
+}
+
+static int runningMedianMaxSortUp(RUNNING_MEDIAN *rm, long i) {
+  while (i < 0 && runningMedianCompareExchange(rm, i / 2, i))
+    i /= 2;
+  return i == 0;
+}
+
+static int runningMedianInitialize(RUNNING_MEDIAN *rm, long N) {
+  long i;
+
+  rm->data = malloc(sizeof(*rm->data) * N);
+  rm->pos = malloc(sizeof(*rm->pos) * N);
+  rm->heap = malloc(sizeof(*rm->heap) * N);
+  if (!rm->data || !rm->pos || !rm->heap) {
+    free(rm->data);
+    free(rm->pos);
+    free(rm->heap);
+    return 0;
+  }
+  rm->heap += N / 2;
+  rm->N = N;
+  rm->idx = rm->ct = 0;
+  /* entries are handed out alternately to the max- and min-heaps as the window fills */
+  for (i = N - 1; i >= 0; i--) {
+    rm->pos[i] = ((i + 1) / 2) * ((i & 1) ? -1 : 1);
+    rm->heap[rm->pos[i]] = i;
+  }
+  return 1;
+}
+
+static void runningMedianFree(RUNNING_MEDIAN *rm) {
+  free(rm->data);
+  free(rm->pos);
+  free(rm->heap - rm->N / 2);
+}
+
+/* adds v to the window, replacing the oldest value once the window is full */
+static void runningMedianInsert(RUNNING_MEDIAN *rm, double v) {
+  int isNew;
+  long p;
+  double old;
+
+  isNew = rm->ct < rm->N;
+  p = rm->pos[rm->idx];
+  old = rm->data[rm->idx];
+  rm->data[rm->idx] = v;
+  rm->idx = (rm->idx + 1) % rm->N;
+  rm->ct += isNew;
+  if (p > 0) {
+    if (!isNew && old < v)
+      runningMedianMinSortDown(rm, p * 2);
+    else if (runningMedianMinSortUp(rm, p))
+      runningMedianMaxSortDown(rm, -1);
+  } else if (p < 0) {
+    if (!isNew && v < old)
+      runningMedianMaxSortDown(rm, p * 2);
+    else if (runningMedianMaxSortUp(rm, p))
+      runningMedianMinSortDown(rm, 1);
+  } else {
+    if (RM_MAX_COUNT(rm))
+      runningMedianMaxSortDown(rm, -1);
+    if (RM_MIN_COUNT(rm))
+      runningMedianMinSortDown(rm, 1);
+  }
+}
+
 /**
  * @brief Applies a median filter to an input signal.
  *
  * This function processes the input signal using a sliding window approach to compute the median value for each position.
- * It handles boundary conditions by replicating the edge values to maintain the window size.
+ * It handles boundary conditions by replicating the edge values to maintain the window size.  The window is kept
+ * as a pair of heaps that are updated as it slides, so the cost is O(n log W) rather than O(n W).
  *
  * @param x Input signal array.
  * @param m Output signal buffer array where the median filtered signal will be stored.
@@ -159,25 +281,44 @@ void median_filter(double *x, double *m, long n, long W) {
      m  -- output signal buffer 
      n  -- size of input signal
      W  -- size of slding window (must be odd number) W = 2*W2 + 1) */
-  long i, k, idx, W2;
-  double *w;
+  long i, k, W2;
+  RUNNING_MEDIAN rm;
+
+  if (n <= 0)
+    return;
   if (W % 2 == 0)
     W = W + 1;
   W2 = (W - 1) / 2;
-
-  w = calloc(sizeof(*w), W);
+  if (!runningMedianInitialize(&rm, W))
+    return;
+  for (k = -W2; k < W2; k++)
+    runningMedianInsert(&rm, x[k < 0 ? 0 : (k >= n ? n - 1 : k)]);
   for (i = 0; i < n; i++) {
-    for (k = 0; k < W; k++) {
-      idx = i - W2 + k;
-      if (idx < 0) {
-        w[k] = x[0];
-      } else if (idx >= n) {
-        w[k] = x[n - 1];
-      } else {
-        w[k] = x[idx];
-      }
-    }
-    m[i] = quickSelect(w, W);
+    k = i + W2;
+    runningMedianInsert(&rm, x[k >= n ? n - 1 : k]);
+    m[i] = rm.data[rm.heap[0]];
   }
-  free(w);
+  runningMedianFree(&rm);
+}
+
+/**
+ * @brief Applies a median filter to each of several signals of equal length.
+ *
+ * Each row is filtered as by median_filter(), with the rows shared among threads.
+ *
+ * @param x Array of input signals.
+ * @param m Array of output signal buffers.
+ * @param rows Number of signals.
+ * @param n Size of each signal.
+ * @param W Size of the sliding window (must be an odd number, W = 2*W2 + 1).
+ * @param numThreads Number of threads to use.
+ */
+void median_filter_rows(double **x, double **m, long rows, long n, long W, long numThreads) {
+  int row;
+
+  if (numThreads < 1)
+    numThreads = 1;
+#pragma omp parallel for schedule(dynamic) num_threads(numThreads)
+  for (row = 0; row < rows; row++)
+    median_filter(x[row], m[row], n, W);
 }
@@ -4,9 +4,9 @@
  *
  * This file contains functions to compute the median, specific percentiles, the average, and the middle value of
  * datasets. It also includes functions to compute these statistics for specific rows in a 2D array. These
- * functions return the index of the closest point to the computed statistic. Requires libsort.a routines.
+ * functions return the index of the closest point to the computed statistic.
  *
- * See also: median.c (doesn't require libsort.a, but doesn't return index).
+ * See also: median.c, whose select_order_statistics() does the selection.
  *
  * @copyright 
  *   - (c) 2002 The University of Chicago, as Operator of Argonne National Laboratory.
@@ -21,6 +21,37 @@
 
 #include "mdb.h"
 
+/**
+ * @brief Selects the rank-th smallest of n values and returns the index of the first value equal to it.
+ *
+ * The values are copied into work space so that the input is left unchanged.  Values are read from
+ * x[i] when row is NULL, and from row[i][index] otherwise.
+ */
+static long find_order_statistic(double *value, double *x, double **row, long index, long n, long rank) {
+  double *data;
+  long i;
+
+  if (!(data = malloc(sizeof(*data) * n)))
+    return (-1);
+  for (i = 0; i < n; i++)
+    data[i] = row ? row[i][index] : x[i];
+  if (!select_order_statistics(value, &rank, 1, data, n)) {
+    free(data);
+    return (-1);
+  }
+  free(data);
+  for (i = 0; i < n; i++) {
+    if (row ? row[i][index] == *value : x[i] == *value)
+      return (i);
+  }
+  /* only a NaN can fail to compare equal to itself */
+  for (i = 0; i < n; i++) {
+    if (isnan(row ? row[i][index] : x[i]))
+      return (i);
+  }
+  return (-1);
+}
+
 /**
  * @brief Finds the median value of an array of doubles and returns the index of the median.
  *
@@ -30,30 +61,9 @@
  * @return Returns the index of the median element on success, -1 on failure.
  */
 long find_median(double *value, double *x, long n) {
-  static double **data = NULL;
-  static long last_n = 0;
-  long i;
-
   if (n <= 0)
     return (-1);
-  if (n > last_n) {
-    if (data)
-      free_zarray_2d((void **)data, last_n, 2);
-    data = (double **)zarray_2d(sizeof(**data), n, 2);
-    last_n = n;
-  }
-
-  for (i = 0; i < n; i++) {
-    data[i][0] = x[i];
-    data[i][1] = i;
-  }
-  set_up_row_sort(0, 2, sizeof(**data), double_cmpasc);
-  qsort((void *)data, n, sizeof(*data), row_compare);
-
-  *value = data[n / 2][0];
-  i = data[n / 2][1];
-
-  return (i);
+  return find_order_statistic(value, x, NULL, 0, n, n / 2);
 }
 
 /**
@@ -66,32 +76,11 @@ long find_median(double *value, double *x, long n) {
  * @return Returns the index of the percentile element on success, -1 on failure.
  */
 long find_percentile(double *value, double *x, long n, double percentile) {
-  static double **data = NULL;
-  static long last_n = 0;
-  long i;
-
   if (n <= 0)
     return (-1);
   if (percentile < 0 || percentile > 100)
     return -1;
-  if (n > last_n) {
-    if (data)
-      free_zarray_2d((void **)data, last_n, 2);
-    data = (double **)zarray_2d(sizeof(**data), n, 2);
-    last_n = n;
-  }
-
-  for (i = 0; i < n; i++) {
-    data[i][0] = x[i];
-    data[i][1] = i;
-  }
-  set_up_row_sort(0, 2, sizeof(**data), double_cmpasc);
-  qsort((void *)data, n, sizeof(*data), row_compare);
-
-  *value = data[(long)((n - 1) * (percentile / 100.0))][0];
-  i = data[(long)((n - 1) * (percentile / 100.0))][1];
-
-  return (i);
+  return find_order_statistic(value, x, NULL, 0, n, (long)((n - 1) * (percentile / 100.0)));
 }
 
 /**
@@ -104,31 +93,9 @@ long find_percentile(double *value, double *x, long n, double percentile) {
  * @return Returns the index of the median element in the specified row on success, -1 on failure.
  */
 long find_median_of_row(double *value, double **x, long index, long n) {
-  static double **data = NULL;
-  static long last_n = 0;
-  long i;
-
-  if (index < 0 && n <= 0)
+  if (index < 0 || n <= 0)
     return (-1);
-
-  if (n > last_n) {
-    if (data)
-      free_zarray_2d((void **)data, last_n, 2);
-    data = (double **)zarray_2d(sizeof(**data), n, 2);
-    last_n = n;
-  }
-
-  for (i = 0; i < n; i++) {
-    data[i][0] = x[i][index];
-    data[i][1] = i;
-  }
-  set_up_row_sort(0, 2, sizeof(**data), double_cmpasc);
-  qsort((void *)data, n, sizeof(*data), row_compare);
-
-  *value = data[n / 2][0];
-  i = data[n / 2][1];
-
-  return (i);
+  return find_order_statistic(value, NULL, x, index, n, n / 2);
 }
 
 /**
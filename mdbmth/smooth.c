@@ -3,7 +3,8 @@
  * @brief Functions for smoothing data and removing spikes from data arrays.
  *
  * This file provides two main functions:
- * - smoothData(): Smooths a data set using a simple moving average over a defined number of points and passes.
+ * - smoothData(): Smooths a data set using a simple moving average over a defined number of points and passes,
+ *   and smoothDataColumns(), which smooths several data sets in parallel.
  * - despikeData(): Attempts to remove spike values from a data set by comparing each point to its neighbors and replacing it if it exceeds a defined threshold.
  *
  * @copyright 
@@ -34,15 +35,16 @@
  */
 void smoothData(double *data, long rows, long smoothPoints, long smoothPasses) {
   long lower, upper, row, pass, smoothPoints2, terms;
-  double sum;
-  static double *smoothedData = NULL;
+  double sum, *smoothedData;
 
-  smoothedData = trealloc(smoothedData, rows * sizeof(*smoothedData));
+  if (rows <= 0)
+    return;
+  smoothedData = tmalloc(rows * sizeof(*smoothedData));
 
   smoothPoints2 = smoothPoints / 2;
 
   for (pass = 0; pass < smoothPasses; pass++) {
-    for (row = sum = 0; row < smoothPoints2; row++)
+    for (row = sum = 0; row < smoothPoints2 && row < rows; row++)
       sum += data[row];
 
     terms = row;
@@ -63,6 +65,29 @@ void smoothData(double *data, long rows, long smoothPoints, long smoothPasses) {
     for (row = 0; row < rows; row++)
       data[row] = smoothedData[row];
   }
+  free(smoothedData);
+}
+
+/**
+ * @brief Smooth several data arrays using a moving average.
+ *
+ * Applies smoothData() to each column, processing the columns in parallel.
+ *
+ * @param data Array of pointers to the columns to be smoothed in place.
+ * @param columns The number of columns.
+ * @param rows The number of data points in each column.
+ * @param smoothPoints The number of points to include in the smoothing window.
+ * @param smoothPasses The number of smoothing passes to perform.
+ * @param numThreads The number of threads to use.
+ */
+void smoothDataColumns(double **data, long columns, long rows, long smoothPoints, long smoothPasses, long numThreads) {
+  int column;
+
+  if (numThreads < 1)
+    numThreads = 1;
+#pragma omp parallel for schedule(dynamic) num_threads(numThreads)
+  for (column = 0; column < columns; column++)
+    smoothData(data[column], rows, smoothPoints, smoothPasses);
 }
 
 /**
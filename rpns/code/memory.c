@@ -84,7 +84,8 @@ long rpn_create_mem(char *name, short is_string)
   }
   
   if (Memory==NULL || n_memories>=max_n_memories) {
-    Memory = trealloc(Memory, sizeof(*Memory)*(max_n_memories+=10));
+    max_n_memories = max_n_memories ? 2*max_n_memories : 10;
+    Memory = trealloc(Memory, sizeof(*Memory)*max_n_memories);
     memoryData = trealloc(memoryData, sizeof(*memoryData)*max_n_memories);
     str_memoryData = trealloc(str_memoryData, sizeof(*str_memoryData)*max_n_memories);
   }